@@ -29,6 +29,7 @@
 #include <bitcoin/system/chain/header.hpp>
 #include <bitcoin/system/chain/input.hpp>
 #include <bitcoin/system/chain/input_point.hpp>
+#include <bitcoin/system/chain/median_time_window.hpp>
 #include <bitcoin/system/chain/output.hpp>
 #include <bitcoin/system/chain/output_point.hpp>
 #include <bitcoin/system/chain/payment_record.hpp>
@@ -36,6 +37,7 @@
 #include <bitcoin/system/chain/point_value.hpp>
 #include <bitcoin/system/chain/points_value.hpp>
 #include <bitcoin/system/chain/script.hpp>
+#include <bitcoin/system/chain/script_cache.hpp>
 #include <bitcoin/system/chain/stealth_record.hpp>
 #include <bitcoin/system/chain/transaction.hpp>
 #include <bitcoin/system/chain/witness.hpp>
@@ -85,26 +87,36 @@
 #include <bitcoin/system/log/features/metric.hpp>
 #include <bitcoin/system/log/features/rate.hpp>
 #include <bitcoin/system/log/features/timer.hpp>
+#include <bitcoin/system/machine/basic_interpreter.hpp>
+#include <bitcoin/system/machine/compiled_script.hpp>
 #include <bitcoin/system/machine/interpreter.hpp>
 #include <bitcoin/system/machine/number.hpp>
 #include <bitcoin/system/machine/opcode.hpp>
 #include <bitcoin/system/machine/operation.hpp>
+#include <bitcoin/system/machine/operation_iterator.hpp>
 #include <bitcoin/system/machine/program.hpp>
 #include <bitcoin/system/machine/rule_fork.hpp>
 #include <bitcoin/system/machine/script_pattern.hpp>
 #include <bitcoin/system/machine/script_version.hpp>
 #include <bitcoin/system/machine/sighash_algorithm.hpp>
+#include <bitcoin/system/machine/signature_batch.hpp>
+#include <bitcoin/system/machine/stack_item.hpp>
+#include <bitcoin/system/machine/view_interpreter.hpp>
+#include <bitcoin/system/machine/view_program.hpp>
 #include <bitcoin/system/math/checksum.hpp>
 #include <bitcoin/system/math/crypto.hpp>
 #include <bitcoin/system/math/ec_point.hpp>
 #include <bitcoin/system/math/ec_scalar.hpp>
 #include <bitcoin/system/math/elliptic_curve.hpp>
+#include <bitcoin/system/math/flat_hash.hpp>
 #include <bitcoin/system/math/golomb_coded_sets.hpp>
 #include <bitcoin/system/math/hash.hpp>
 #include <bitcoin/system/math/limits.hpp>
 #include <bitcoin/system/math/ring_signature.hpp>
+#include <bitcoin/system/math/signature_cache.hpp>
 #include <bitcoin/system/math/siphash.hpp>
 #include <bitcoin/system/math/stealth.hpp>
+#include <bitcoin/system/math/uint256.hpp>
 #include <bitcoin/system/message/address.hpp>
 #include <bitcoin/system/message/alert.hpp>
 #include <bitcoin/system/message/alert_payload.hpp>
@@ -136,6 +148,7 @@
 #include <bitcoin/system/message/messages.hpp>
 #include <bitcoin/system/message/network_address.hpp>
 #include <bitcoin/system/message/not_found.hpp>
+#include <bitcoin/system/message/payload_verifier.hpp>
 #include <bitcoin/system/message/ping.hpp>
 #include <bitcoin/system/message/pong.hpp>
 #include <bitcoin/system/message/prefilled_transaction.hpp>
@@ -160,6 +173,7 @@
 #include <bitcoin/system/utility/binary.hpp>
 #include <bitcoin/system/utility/bit_reader.hpp>
 #include <bitcoin/system/utility/bit_writer.hpp>
+#include <bitcoin/system/utility/cached_hash.hpp>
 #include <bitcoin/system/utility/collection.hpp>
 #include <bitcoin/system/utility/color.hpp>
 #include <bitcoin/system/utility/conditional_lock.hpp>
@@ -183,6 +197,7 @@
 #include <bitcoin/system/utility/noncopyable.hpp>
 #include <bitcoin/system/utility/ostream_bit_writer.hpp>
 #include <bitcoin/system/utility/ostream_writer.hpp>
+#include <bitcoin/system/utility/parallel.hpp>
 #include <bitcoin/system/utility/pending.hpp>
 #include <bitcoin/system/utility/prioritized_mutex.hpp>
 #include <bitcoin/system/utility/property_tree.hpp>
@@ -193,6 +208,8 @@
 #include <bitcoin/system/utility/sequencer.hpp>
 #include <bitcoin/system/utility/sequential_lock.hpp>
 #include <bitcoin/system/utility/serializer.hpp>
+#include <bitcoin/system/utility/sha256_buffer_writer.hpp>
+#include <bitcoin/system/utility/sha256_writer.hpp>
 #include <bitcoin/system/utility/socket.hpp>
 #include <bitcoin/system/utility/string.hpp>
 #include <bitcoin/system/utility/subscriber.hpp>
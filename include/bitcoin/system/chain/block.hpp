@@ -28,11 +28,14 @@
 #include <bitcoin/system/chain/transaction.hpp>
 #include <bitcoin/system/define.hpp>
 #include <bitcoin/system/error.hpp>
+#include <bitcoin/system/machine/signature_batch.hpp>
 #include <bitcoin/system/math/hash.hpp>
 #include <bitcoin/system/utility/asio.hpp>
 #include <bitcoin/system/utility/data.hpp>
+#include <bitcoin/system/utility/deserializer.hpp>
 #include <bitcoin/system/utility/reader.hpp>
 #include <bitcoin/system/utility/thread.hpp>
+#include <bitcoin/system/utility/threadpool.hpp>
 #include <bitcoin/system/utility/writer.hpp>
 
 namespace libbitcoin {
@@ -100,6 +103,7 @@ public:
     bool from_data(const data_chunk& data, bool witness=false);
     bool from_data(std::istream& stream, bool witness=false);
     bool from_data(reader& source, bool witness=false);
+    bool from_data(byte_reader& source, bool witness=false);
 
     bool is_valid() const;
 
@@ -161,6 +165,11 @@ public:
     bool is_valid_witness_commitment() const;
     bool is_forward_reference() const;
     bool is_internal_double_spend() const;
+
+    /// Combines is_forward_reference and is_internal_double_spend in one
+    /// pass, returning the error of the former in the event of both.
+    code check_internal_spends() const;
+
     bool is_valid_merkle_root() const;
     bool is_segregated() const;
 
@@ -172,11 +181,42 @@ public:
         bool header=true) const;
     code accept(const chain_state& state, const system::settings& settings,
         bool transactions=true, bool header=true) const;
+
+    /// Run the independent stages of check (header, structure, internal
+    /// spends, merkle root and each transaction check) concurrently on the
+    /// pool (and calling thread). The result is that of the sequential check,
+    /// the first failing stage in its order. The duration is metadata.check.
+    code check(uint64_t max_money, uint32_t timestamp_limit_seconds,
+        uint32_t proof_of_work_limit, threadpool& pool, bool scrypt=false,
+        bool header=true) const;
+
+    /// Run the independent stages of accept (including signature operation
+    /// counting, the witness commitment and each transaction accept)
+    /// concurrently. The result is that of the sequential accept, the first
+    /// failing stage in its order. The duration is metadata.accept.
+    code accept(const chain_state& state, const system::settings& settings,
+        threadpool& pool, bool transactions=true, bool header=true) const;
+
     code accept_transactions(const chain_state& state) const;
     code connect() const;
     code connect(const chain_state& state) const;
     code connect_transactions(const chain_state& state) const;
 
+    /// Verify all input scripts concurrently on the pool (and calling thread).
+    /// The result is that of connect(state), the first failing input.
+    /// The duration of this and the batched connect is metadata.connect.
+    code connect(const chain_state& state, threadpool& pool) const;
+    code connect_transactions(const chain_state& state,
+        threadpool& pool) const;
+
+    /// Verify all input scripts concurrently, deferring signature checks to
+    /// the batch, which is then verified concurrently. The block is accepted
+    /// or rejected as by connect(state), though the failure code may differ.
+    code connect(const chain_state& state, threadpool& pool,
+        machine::signature_batch& batch) const;
+    code connect_transactions(const chain_state& state, threadpool& pool,
+        machine::signature_batch& batch) const;
+
     // THIS IS FOR LIBRARY USE ONLY, DO NOT CREATE A DEPENDENCY ON IT.
     mutable validation metadata;
 
@@ -184,8 +224,14 @@ protected:
     void reset();
 
 private:
+    template <typename Source>
+    bool deserialize(Source& source, bool witness);
+
     typedef boost::optional<size_t> optional_size;
 
+    code connect_inputs(const chain_state& state, threadpool& pool,
+        machine::signature_batch* batch) const;
+
     optional_size total_inputs_cache() const;
     optional_size non_coinbase_inputs_cache() const;
 
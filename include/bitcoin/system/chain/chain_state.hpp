@@ -23,6 +23,8 @@
 #include <cstdint>
 #include <memory>
 #include <deque>
+#include <boost/optional.hpp>
+#include <bitcoin/system/chain/median_time_window.hpp>
 #include <bitcoin/system/config/checkpoint.hpp>
 #include <bitcoin/system/constants.hpp>
 #include <bitcoin/system/define.hpp>
@@ -159,6 +161,11 @@ public:
     chain_state(data&& values, const checkpoints& checkpoints, uint32_t forks,
         uint32_t stale_seconds, const system::settings& settings);
 
+    /// Create an incremental state from raw data (see is_incremental).
+    chain_state(data&& values, const checkpoints& checkpoints, uint32_t forks,
+        uint32_t stale_seconds, const system::settings& settings,
+        bool incremental);
+
     /// Properties.
     const hash_digest& hash() const;
     size_t height() const;
@@ -168,9 +175,20 @@ public:
     uint32_t median_time_past() const;
     uint32_t work_required() const;
 
+    /// The timestamps of this block and those preceding it, as sampled for
+    /// the median time past of a child (e.g. the first of a headers message).
+    median_time_window child_median_window() const;
+
     /// Construction with zero height or any empty array causes invalid state.
     bool is_valid() const;
 
+    /// States derived from an incremental state are incremental. These share
+    /// a bounded history of header values with their ancestors and do not
+    /// copy the bits and version samples, so derivation is constant time and
+    /// space. Derivation from a state too far below the top of its branch
+    /// (more than twice the longest sample) produces an invalid state.
+    bool is_incremental() const;
+
     /// Determine if the represented block is stale (top block for pool state).
     bool is_stale() const;
 
@@ -196,13 +214,42 @@ protected:
         uint32_t maximum_transaction_version;
     };
 
+    struct version_counts
+    {
+        // The number of sampled versions at or above the bip34 version.
+        size_t bip34;
+
+        // The number of sampled versions at or above the bip66 version.
+        size_t bip66;
+
+        // The number of sampled versions at or above the bip65 version.
+        size_t bip65;
+    };
+
     static activations activation(const data& values, uint32_t forks,
         const system::settings& settings);
+    static activations activation(const data& values,
+        const version_counts& counts, uint32_t forks,
+        const system::settings& settings);
     static uint32_t median_time_past(const data& values, uint32_t forks);
+    static median_time_window to_median_window(const data& values);
     static uint32_t work_required(const data& values, uint32_t forks,
         const system::settings& settings);
 
 private:
+    struct history;
+    typedef std::shared_ptr<history> history_ptr;
+
+    static activations activation(const data& values,
+        const boost::optional<version_counts>& counts, uint32_t forks,
+        const system::settings& settings);
+
+    static version_counts to_counts(const data& values,
+        const system::settings& settings);
+    static boost::optional<version_counts> to_counts(const data& values,
+        const history_ptr& history, uint32_t forks,
+        const system::settings& settings);
+
     static size_t bits_count(size_t height, uint32_t forks,
         size_t retargeting_interval);
     static size_t version_count(size_t height, uint32_t forks,
@@ -215,7 +262,7 @@ private:
     static size_t bip9_bit1_height(size_t height,
         const config::checkpoint& bip9_bit1_active_checkpoint);
 
-    static data to_pool(const chain_state& top,
+    static data to_pool(const chain_state& top, const history_ptr& history,
         const system::settings& settings);
     static data to_block(const chain_state& pool, const block& block,
         const config::checkpoint& bip9_bit0_active_checkpoint,
@@ -240,6 +287,9 @@ private:
     static bool is_retarget_height(size_t height, size_t retargeting_interval);
     static size_t retarget_distance(size_t height, size_t retargeting_interval);
 
+    // Shared by incremental states of a branch, otherwise null.
+    const history_ptr history_;
+
     // This is retained as an optimization for other constructions.
     // A similar height clone can be partially computed, reducing query cost.
     const data data_;
@@ -253,9 +303,15 @@ private:
     // Checkpoints do not affect the data that is collected or promoted.
     const config::checkpoint::list& checkpoints_;
 
+    // Summary of the version sample, retained for the block state at the
+    // same height, as the history may no longer retain the sample.
+    // This is empty if the sample was not retained at construction.
+    const boost::optional<version_counts> counts_;
+
     // These are computed on construct from sample and checkpoints.
     const activations active_;
     const uint32_t work_required_;
+    const median_time_window median_window_;
     const uint32_t median_time_past_;
 };
 
@@ -22,6 +22,7 @@
 #include <cstdint>
 #include <bitcoin/system/define.hpp>
 #include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/math/uint256.hpp>
 
 namespace libbitcoin {
 namespace system {
@@ -31,10 +32,15 @@ namespace chain {
 class BC_API compact
 {
 public:
+    /// Set the little-endian bytes of the number that a 32 bit compact number
+    /// represents, without a big number. False if overflowed (as construction).
+    static bool to_target(hash_digest& out, uint32_t compact);
+
     /// Construct a normal form compact number from a 32 bit compact number.
     explicit compact(uint32_t compact);
 
     /// Construct a normal form compact number from a 256 bit number
+    explicit compact(const uint256& big);
     explicit compact(const uint256_t& big);
 
     /// True if construction overflowed.
@@ -46,13 +52,16 @@ public:
 
     /// Big number that the compact number represents.
     /// This is either saved or generated from the construction parameter.
-    operator const uint256_t&() const;
+    operator const uint256&() const;
+
+    /// The same number as uint256_t, for callers of the big number type.
+    operator uint256_t() const;
 
 private:
-    static bool from_compact(uint256_t& out, uint32_t compact);
-    static uint32_t from_big(const uint256_t& big);
+    static bool from_compact(uint256& out, uint32_t compact);
+    static uint32_t from_big(const uint256& big);
 
-    uint256_t big_;
+    uint256 big_;
     uint32_t normal_;
     bool overflowed_;
 };
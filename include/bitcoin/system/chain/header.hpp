@@ -23,16 +23,17 @@
 #include <cstdint>
 #include <istream>
 #include <string>
-#include <memory>
 #include <vector>
 #include <bitcoin/system/chain/block_filter.hpp>
 #include <bitcoin/system/chain/chain_state.hpp>
 #include <bitcoin/system/define.hpp>
 #include <bitcoin/system/error.hpp>
 #include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/math/uint256.hpp>
+#include <bitcoin/system/utility/cached_hash.hpp>
 #include <bitcoin/system/utility/data.hpp>
+#include <bitcoin/system/utility/deserializer.hpp>
 #include <bitcoin/system/utility/reader.hpp>
-#include <bitcoin/system/utility/thread.hpp>
 #include <bitcoin/system/utility/writer.hpp>
 
 namespace libbitcoin {
@@ -121,6 +122,7 @@ public:
     bool from_data(const data_chunk& data, bool wire=true);
     bool from_data(std::istream& stream, bool wire=true);
     bool from_data(reader& source, bool wire=true);
+    bool from_data(byte_reader& source, bool wire=true);
     bool from_data(reader& source, hash_digest&& hash, bool wire=true);
     bool from_data(reader& source, const hash_digest& hash, bool wire=true);
 
@@ -165,13 +167,19 @@ public:
     // Validation.
     //-------------------------------------------------------------------------
 
-    uint256_t proof() const;
-    static uint256_t proof(uint32_t bits);
+    /// The proof converts to uint256_t for callers of the big number type.
+    uint256 proof() const;
+    static uint256 proof(uint32_t bits);
 
     bool is_valid_timestamp(uint32_t timestamp_limit_seconds) const;
     bool is_valid_proof_of_work(uint32_t proof_of_work_limit,
         bool scrypt=false) const;
 
+    /// True if the hash meets the target of bits, within the limit.
+    /// The comparison is fixed width, without big number conversion.
+    static bool is_valid_proof_of_work(const hash_digest& hash, uint32_t bits,
+        uint32_t proof_of_work_limit);
+
     code check(uint32_t timestamp_limit_seconds, uint32_t proof_of_work_limit,
         bool scrypt=false) const;
     code accept() const;
@@ -188,12 +196,12 @@ protected:
     void invalidate_cache() const;
 
 private:
-    typedef std::shared_ptr<hash_digest> hash_ptr;
+    template <typename Source>
+    bool deserialize(Source& source);
 
-    hash_ptr hash_cache() const;
+    byte_array<80> to_array() const;
 
-    mutable hash_ptr hash_;
-    mutable upgrade_mutex mutex_;
+    mutable cached_hash hash_;
 
     uint32_t version_;
     hash_digest previous_block_hash_;
@@ -29,6 +29,7 @@
 #include <bitcoin/system/chain/witness.hpp>
 #include <bitcoin/system/define.hpp>
 #include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/utility/deserializer.hpp>
 #include <bitcoin/system/utility/reader.hpp>
 #include <bitcoin/system/utility/thread.hpp>
 #include <bitcoin/system/utility/writer.hpp>
@@ -80,6 +81,7 @@ public:
     bool from_data(const data_chunk& data, bool wire=true, bool witness=false);
     bool from_data(std::istream& stream, bool wire=true, bool witness=false);
     bool from_data(reader& source, bool wire=true, bool witness=false);
+    bool from_data(byte_reader& source, bool wire=true, bool witness=false);
 
     bool is_valid() const;
 
@@ -141,6 +143,9 @@ protected:
     void invalidate_cache() const;
 
 private:
+    template <typename Source>
+    bool deserialize(Source& source, bool wire, bool witness);
+
     typedef std::shared_ptr<wallet::payment_address::list> addresses_ptr;
 
     addresses_ptr addresses_cache() const;
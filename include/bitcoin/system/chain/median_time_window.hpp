@@ -0,0 +1,64 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_CHAIN_MEDIAN_TIME_WINDOW_HPP
+#define LIBBITCOIN_SYSTEM_CHAIN_MEDIAN_TIME_WINDOW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/system/constants.hpp>
+#include <bitcoin/system/define.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace chain {
+
+/// The timestamps of the blocks preceding a block, limited to the median
+/// time past interval, with values held both in order of height and sorted.
+/// Sliding the window by one block is a constant time update (no sort).
+class BC_API median_time_window
+{
+public:
+    /// Construct an empty window.
+    median_time_window();
+
+    /// Append the timestamp of the next block, removing the oldest if full.
+    void push(uint32_t timestamp);
+
+    /// The number of timestamps in the window (up to the interval).
+    size_t size() const;
+
+    /// The median time past of the block following the window, zero if empty.
+    uint32_t median() const;
+
+private:
+    // Ring of timestamps in order of height, the oldest at next_ when full.
+    uint32_t ordered_[median_time_past_interval];
+
+    // The same timestamps ordered by value.
+    uint32_t sorted_[median_time_past_interval];
+
+    size_t size_;
+    size_t next_;
+};
+
+} // namespace chain
+} // namespace system
+} // namespace libbitcoin
+
+#endif
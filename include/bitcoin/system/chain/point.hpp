@@ -25,8 +25,11 @@
 #include <vector>
 #include <boost/functional/hash.hpp>
 #include <bitcoin/system/define.hpp>
+#include <bitcoin/system/math/flat_hash.hpp>
 #include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/math/siphash.hpp>
 #include <bitcoin/system/utility/data.hpp>
+#include <bitcoin/system/utility/deserializer.hpp>
 #include <bitcoin/system/utility/reader.hpp>
 #include <bitcoin/system/utility/writer.hpp>
 
@@ -76,6 +79,7 @@ public:
     bool from_data(const data_chunk& data, bool wire=true);
     bool from_data(std::istream& stream, bool wire=true);
     bool from_data(reader& source, bool wire=true);
+    bool from_data(byte_reader& source, bool wire=true);
 
     bool is_valid() const;
 
@@ -116,12 +120,33 @@ protected:
     void reset();
 
 private:
+    template <typename Source>
+    bool deserialize(Source& source, bool wire);
+
     hash_digest hash_;
     uint32_t index_;
     bool valid_;
 };
 
 } // namespace chain
+
+/// Previous output hashes are chosen by the spender, and an unvalidated
+/// transaction may share any part of them across its inputs. So the full
+/// hash and index are keyed by siphash, with a random key by default.
+template <>
+struct BC_API digest_hasher<chain::point>
+{
+    digest_hasher();
+    explicit digest_hasher(uint64_t salt);
+
+    size_t operator()(const chain::point& key) const;
+
+private:
+    siphash_key key_;
+};
+
+typedef flat_set<chain::point> point_set;
+
 } // namespace system
 } // namespace libbitcoin
 
@@ -32,7 +32,9 @@
 #include <bitcoin/system/machine/rule_fork.hpp>
 #include <bitcoin/system/machine/script_pattern.hpp>
 #include <bitcoin/system/machine/script_version.hpp>
+#include <bitcoin/system/machine/signature_batch.hpp>
 #include <bitcoin/system/utility/data.hpp>
+#include <bitcoin/system/utility/deserializer.hpp>
 #include <bitcoin/system/utility/reader.hpp>
 #include <bitcoin/system/utility/thread.hpp>
 #include <bitcoin/system/utility/writer.hpp>
@@ -88,6 +90,7 @@ public:
     bool from_data(const data_chunk& encoded, bool prefix);
     bool from_data(std::istream& stream, bool prefix);
     bool from_data(reader& source, bool prefix);
+    bool from_data(byte_reader& source, bool prefix);
 
     /// Deserialization invalidates the iterator.
     bool from_string(const std::string& mnemonic);
@@ -128,6 +131,14 @@ public:
     size_t serialized_size(bool prefix) const;
     const operation::list& operations() const;
 
+    /// The serialized script (without prefix), valid for the script lifetime.
+    const data_chunk& bytes() const;
+
+    /// True if the script bytes are also its script code as signed by an
+    /// unversioned signature hash, which is the case unless the script has a
+    /// code separator or an invalid operation (cached).
+    bool is_stripped() const;
+
     // Signing.
     //-------------------------------------------------------------------------
 
@@ -211,6 +222,7 @@ public:
     /// Consensus computations.
     size_t sigops(bool accurate) const;
     void find_and_delete(const data_stack& endorsements);
+    bool is_found(const data_slice& endorsement) const;
     bool is_oversized() const;
     bool is_unspendable() const;
 
@@ -218,11 +230,16 @@ public:
     //-------------------------------------------------------------------------
 
     // This obtains the previous output from metadata.
+    // Signature checks are deferred to the batch if one is provided.
+    // Standard spends are evaluated by view_interpreter if views is set,
+    // otherwise all scripts are evaluated by interpreter::run.
     static code verify(const transaction& tx, uint32_t input_index,
-        uint32_t forks);
+        uint32_t forks, machine::signature_batch* batch=nullptr,
+        bool views=false);
 
     static code verify(const transaction& tx, uint32_t input_index,
-        uint32_t forks, const script& prevout_script, uint64_t value);
+        uint32_t forks, const script& prevout_script, uint64_t value,
+        machine::signature_batch* batch=nullptr, bool views=false);
 
 protected:
     // So that input and output may call reset from their own.
@@ -234,6 +251,9 @@ protected:
     bool is_pay_to_script_hash(uint32_t forks) const;
 
 private:
+    template <typename Source>
+    bool deserialize(Source& source, bool prefix);
+
     static size_t serialized_size(const operation::list& ops);
     static data_chunk operations_to_data(const operation::list& ops);
     static hash_digest generate_unversioned_signature_hash(
@@ -243,7 +263,17 @@ private:
         uint32_t input_index, const script& script_code, uint64_t value,
         uint8_t sighash_type);
 
+    static bool is_view_supported(const transaction& tx,
+        uint32_t input_index, uint32_t forks, const script& prevout_script);
+    static code verify_views(const transaction& tx, uint32_t input_index,
+        uint32_t forks, const script& prevout_script, uint64_t value,
+        machine::signature_batch* batch);
+
+    static script_pattern output_pattern(const data_slice& bytes);
+    static script_pattern input_pattern(const data_slice& bytes);
+
     void find_and_delete_(const data_chunk& endorsement);
+    bool is_decoded() const;
 
     operation::list& operations_move();
     const operation::list& operations_copy() const;
@@ -251,6 +281,8 @@ private:
     // These are protected by mutex.
     mutable operation::list operations_;
     mutable bool cached_;
+    mutable bool stripped_;
+    mutable bool stripped_cached_;
     mutable upgrade_mutex mutex_;
 
     data_chunk bytes_;
@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_CHAIN_SCRIPT_CACHE_HPP
+#define LIBBITCOIN_SYSTEM_CHAIN_SCRIPT_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <bitcoin/system/define.hpp>
+#include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/math/siphash.hpp>
+#include <bitcoin/system/utility/thread.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace chain {
+
+/// A bounded set of transactions with all input scripts verified, keyed by
+/// witness hash and the set of enabled forks of the verification, thread
+/// safe. An entry applies only to a transaction with populated previous
+/// outputs, as it does not record their presence. The oldest entry is evicted
+/// when full. Zero capacity disables the cache.
+class BC_API script_cache
+{
+public:
+    script_cache(size_t capacity);
+
+    /// Determine if the verification is cached, counting the hit or miss.
+    bool contains(const hash_digest& witness_hash, uint32_t forks) const;
+
+    /// Cache a successful verification of all input scripts.
+    void store(const hash_digest& witness_hash, uint32_t forks);
+
+    /// Change the capacity, clearing the cache.
+    void set_capacity(size_t capacity);
+
+    /// Remove all entries (counters are not reset).
+    void clear();
+
+    size_t size() const;
+    size_t capacity() const;
+    uint64_t hits() const;
+    uint64_t misses() const;
+
+private:
+    typedef std::pair<hash_digest, uint32_t> entry;
+
+    // Salted so that bucket collisions cannot be precomputed.
+    struct key_hasher
+    {
+        key_hasher(const siphash_key& key);
+        size_t operator()(const entry& value) const;
+        siphash_key key;
+    };
+
+    typedef std::unordered_set<entry, key_hasher> key_set;
+
+    void reset();
+
+    // These are protected by mutex.
+    size_t capacity_;
+    size_t next_;
+    key_set keys_;
+    std::vector<entry> order_;
+    mutable shared_mutex mutex_;
+
+    mutable std::atomic<uint64_t> hits_;
+    mutable std::atomic<uint64_t> misses_;
+};
+
+} // namespace chain
+} // namespace system
+} // namespace libbitcoin
+
+#endif
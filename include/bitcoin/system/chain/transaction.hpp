@@ -19,6 +19,7 @@
 #ifndef LIBBITCOIN_SYSTEM_CHAIN_TRANSACTION_HPP
 #define LIBBITCOIN_SYSTEM_CHAIN_TRANSACTION_HPP
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <istream>
@@ -30,14 +31,19 @@
 #include <bitcoin/system/chain/input.hpp>
 #include <bitcoin/system/chain/output.hpp>
 #include <bitcoin/system/chain/point.hpp>
+#include <bitcoin/system/chain/script_cache.hpp>
 #include <bitcoin/system/define.hpp>
 #include <bitcoin/system/error.hpp>
 #include <bitcoin/system/math/elliptic_curve.hpp>
 #include <bitcoin/system/math/hash.hpp>
 #include <bitcoin/system/machine/opcode.hpp>
 #include <bitcoin/system/machine/rule_fork.hpp>
+#include <bitcoin/system/machine/signature_batch.hpp>
+#include <bitcoin/system/utility/cached_hash.hpp>
+#include <bitcoin/system/utility/deserializer.hpp>
 #include <bitcoin/system/utility/reader.hpp>
 #include <bitcoin/system/utility/thread.hpp>
+#include <bitcoin/system/utility/threadpool.hpp>
 #include <bitcoin/system/utility/writer.hpp>
 
 namespace libbitcoin {
@@ -128,6 +134,7 @@ public:
     bool from_data(const data_chunk& data, bool wire=true, bool witness=false);
     bool from_data(std::istream& stream, bool wire=true, bool witness=false);
     bool from_data(reader& source, bool wire=true, bool witness=false);
+    bool from_data(byte_reader& source, bool wire=true, bool witness=false);
 
     // Non-wire store deserializations to preserve hash.
     bool from_data(reader& source, hash_digest&& hash, bool wire=true, bool witness=false);
@@ -173,6 +180,14 @@ public:
     hash_digest sequences_hash() const;
     hash_digest hash(bool witness=false) const;
 
+    /// The signature hash (bip143) midstate of the version, inpoints hash and
+    /// sequences hash, with either hash nulled as specified, cached.
+    sha256_context version_0_prefix(bool inpoints, bool sequences) const;
+
+    /// Get the hashes of the transactions, caching those not yet cached.
+    /// The final hashing round of any uncached hashes is batched in lanes.
+    static hash_list hashes(const list& transactions, bool witness=false);
+
     // Utilities.
     //-------------------------------------------------------------------------
 
@@ -211,7 +226,14 @@ public:
     code accept(const chain_state& state, bool transaction_pool=true) const;
     code connect() const;
     code connect(const chain_state& state) const;
-    code connect_input(const chain_state& state, size_t input_index) const;
+
+    /// Verify input scripts concurrently on the pool (and calling thread).
+    /// The result is that of connect(state), the first failing input.
+    code connect(const chain_state& state, threadpool& pool) const;
+
+    /// Signature checks are deferred to the batch if one is provided.
+    code connect_input(const chain_state& state, size_t input_index,
+        machine::signature_batch* batch=nullptr) const;
 
     // THIS IS FOR LIBRARY USE ONLY, DO NOT CREATE A DEPENDENCY ON IT.
     mutable validation metadata;
@@ -222,10 +244,12 @@ protected:
     bool all_inputs_final() const;
 
 private:
-    typedef std::shared_ptr<hash_digest> hash_ptr;
+    template <typename Source>
+    bool deserialize(Source& source, bool wire, bool witness);
+
     typedef boost::optional<uint64_t> optional_value;
+    typedef std::shared_ptr<sha256_context> context_ptr;
 
-    hash_ptr hash_cache() const;
     optional_value total_input_value_cache() const;
     optional_value total_output_value_cache() const;
 
@@ -234,13 +258,14 @@ private:
     input::list inputs_;
     output::list outputs_;
 
-    // These share a mutex as they are not expected to contend.
-    mutable hash_ptr hash_;
-    mutable hash_ptr witness_hash_;
-    mutable hash_ptr outputs_hash_;
-    mutable hash_ptr inpoints_hash_;
-    mutable hash_ptr sequences_hash_;
-    mutable upgrade_mutex hash_mutex_;
+    mutable cached_hash hash_;
+    mutable cached_hash witness_hash_;
+    mutable cached_hash outputs_hash_;
+    mutable cached_hash inpoints_hash_;
+    mutable cached_hash sequences_hash_;
+
+    mutable std::array<context_ptr, 4> prefixes_;
+    mutable upgrade_mutex prefix_mutex_;
 
     // These share a mutex as they are not expected to contend.
     mutable optional_value total_input_value_;
@@ -249,6 +274,12 @@ private:
     mutable upgrade_mutex mutex_;
 };
 
+/// The cache of transactions with all input scripts verified, consulted and
+/// populated by transaction::connect and block::connect_transactions. A hit
+/// skips script evaluation, but previous outputs must still be populated.
+/// This is disabled (zero capacity) until its capacity is set.
+BC_API script_cache& script_verification_cache();
+
 } // namespace chain
 } // namespace system
 } // namespace libbitcoin
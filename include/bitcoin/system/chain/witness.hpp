@@ -25,7 +25,9 @@
 #include <bitcoin/system/chain/script.hpp>
 #include <bitcoin/system/define.hpp>
 #include <bitcoin/system/machine/operation.hpp>
+#include <bitcoin/system/machine/signature_batch.hpp>
 #include <bitcoin/system/utility/data.hpp>
+#include <bitcoin/system/utility/deserializer.hpp>
 #include <bitcoin/system/utility/reader.hpp>
 #include <bitcoin/system/utility/thread.hpp>
 #include <bitcoin/system/utility/writer.hpp>
@@ -76,6 +78,7 @@ public:
     bool from_data(const data_chunk& encoded, bool prefix);
     bool from_data(std::istream& stream, bool prefix);
     bool from_data(reader& source, bool prefix);
+    bool from_data(byte_reader& source, bool prefix);
 
     /// The witness deserialized according to count and size prefixing.
     bool is_valid() const;
@@ -122,7 +125,8 @@ public:
     //-------------------------------------------------------------------------
 
     code verify(const transaction& tx, uint32_t input_index, uint32_t forks,
-        const script& program_script, uint64_t value) const;
+        const script& program_script, uint64_t value,
+        machine::signature_batch* batch=nullptr) const;
 
 protected:
     // So that input may call reset from its own.
@@ -131,6 +135,9 @@ protected:
     void reset();
 
 private:
+    template <typename Source>
+    bool deserialize(Source& source, bool prefix);
+
     static size_t serialized_size(const data_stack& stack);
     static operation::list to_pay_key_hash(data_chunk&& program);
 
@@ -0,0 +1,720 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_MACHINE_BASIC_INTERPRETER_IPP
+#define LIBBITCOIN_SYSTEM_MACHINE_BASIC_INTERPRETER_IPP
+
+#include <cstdint>
+#include <utility>
+#include <bitcoin/system/chain/script.hpp>
+#include <bitcoin/system/constants.hpp>
+#include <bitcoin/system/error.hpp>
+#include <bitcoin/system/machine/number.hpp>
+#include <bitcoin/system/machine/opcode.hpp>
+#include <bitcoin/system/machine/rule_fork.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace machine {
+
+// Operations (shared).
+//-----------------------------------------------------------------------------
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_nop(opcode)
+{
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_disabled(opcode)
+{
+    return error::op_disabled;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_reserved(opcode)
+{
+    return error::op_reserved;
+}
+
+// Operations (not shared).
+//-----------------------------------------------------------------------------
+// All index parameters are zero-based and relative to stack top.
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_if(Program& program)
+{
+    auto value = false;
+
+    if (program.succeeded())
+    {
+        if (program.empty())
+            return error::op_if;
+
+        value = program.stack_true(false);
+        program.pop();
+    }
+
+    program.open(value);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_notif(Program& program)
+{
+    auto value = false;
+
+    if (program.succeeded())
+    {
+        if (program.empty())
+            return error::op_notif;
+
+        value = !program.stack_true(false);
+        program.pop();
+    }
+
+    program.open(value);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_else(Program& program)
+{
+    if (program.closed())
+        return error::op_else;
+
+    program.negate();
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_endif(Program& program)
+{
+    if (program.closed())
+        return error::op_endif;
+
+    program.close();
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_verify(Program& program)
+{
+    if (program.empty())
+        return error::op_verify1;
+
+    if (!program.stack_true(false))
+        return error::op_verify2;
+
+    program.pop();
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_return(Program&)
+{
+    return error::op_return;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_to_alt_stack(
+    Program& program)
+{
+    if (program.empty())
+        return error::op_to_alt_stack;
+
+    program.push_alternate(program.pop());
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_from_alt_stack(
+    Program& program)
+{
+    if (program.empty_alternate())
+        return error::op_from_alt_stack;
+
+    program.push_move(program.pop_alternate());
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_drop2(Program& program)
+{
+    if (program.size() < 2)
+        return error::op_drop2;
+
+    program.pop();
+    program.pop();
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_dup2(Program& program)
+{
+    if (program.size() < 2)
+        return error::op_dup2;
+
+    auto item1 = program.item(1);
+    auto item0 = program.item(0);
+
+    program.push_move(std::move(item1));
+    program.push_move(std::move(item0));
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_dup3(Program& program)
+{
+    if (program.size() < 3)
+        return error::op_dup3;
+
+    auto item2 = program.item(2);
+    auto item1 = program.item(1);
+    auto item0 = program.item(0);
+
+    program.push_move(std::move(item2));
+    program.push_move(std::move(item1));
+    program.push_move(std::move(item0));
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_over2(Program& program)
+{
+    if (program.size() < 4)
+        return error::op_over2;
+
+    auto item3 = program.item(3);
+    auto item2 = program.item(2);
+
+    program.push_move(std::move(item3));
+    program.push_move(std::move(item2));
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_rot2(Program& program)
+{
+    if (program.size() < 6)
+        return error::op_rot2;
+
+    const auto position_5 = program.position(5);
+    const auto position_4 = program.position(4);
+
+    auto copy_5 = *position_5;
+    auto copy_4 = *position_4;
+
+    program.erase(position_5, position_4 + 1);
+    program.push_move(std::move(copy_5));
+    program.push_move(std::move(copy_4));
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_swap2(Program& program)
+{
+    if (program.size() < 4)
+        return error::op_swap2;
+
+    program.swap(3, 1);
+    program.swap(2, 0);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_if_dup(Program& program)
+{
+    if (program.empty())
+        return error::op_if_dup;
+
+    if (program.stack_true(false))
+        program.duplicate(0);
+
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_depth(Program& program)
+{
+    program.push(number(program.size()));
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_drop(Program& program)
+{
+    if (program.empty())
+        return error::op_drop;
+
+    program.pop();
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_dup(Program& program)
+{
+    if (program.empty())
+        return error::op_dup;
+
+    program.duplicate(0);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_nip(Program& program)
+{
+    if (program.size() < 2)
+        return error::op_nip;
+
+    program.erase(program.position(1));
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_over(Program& program)
+{
+    if (program.size() < 2)
+        return error::op_over;
+
+    program.duplicate(1);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_pick(Program& program)
+{
+    typename Program::stack_iterator position;
+    if (!program.pop_position(position))
+        return error::op_pick;
+
+    program.push_copy(*position);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_roll(Program& program)
+{
+    typename Program::stack_iterator position;
+    if (!program.pop_position(position))
+        return error::op_roll;
+
+    auto copy = *position;
+    program.erase(position);
+    program.push_move(std::move(copy));
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_rot(Program& program)
+{
+    if (program.size() < 3)
+        return error::op_rot;
+
+    program.swap(2, 1);
+    program.swap(1, 0);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_swap(Program& program)
+{
+    if (program.size() < 2)
+        return error::op_swap;
+
+    program.swap(1, 0);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_tuck(Program& program)
+{
+    if (program.size() < 2)
+        return error::op_tuck;
+
+    auto first = program.pop();
+    auto second = program.pop();
+    program.push_copy(first);
+    program.push_move(std::move(second));
+    program.push_move(std::move(first));
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_size(Program& program)
+{
+    if (program.empty())
+        return error::op_size;
+
+    program.push(number(program.item(0).size()));
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_equal(Program& program)
+{
+    if (program.size() < 2)
+        return error::op_equal;
+
+    program.push(program.pop() == program.pop());
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_equal_verify(
+    Program& program)
+{
+    if (program.size() < 2)
+        return error::op_equal_verify1;
+
+    return (program.pop() == program.pop()) ? error::success :
+        error::op_equal_verify2;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_add1(Program& program)
+{
+    number number;
+    if (!program.pop(number))
+        return error::op_add1;
+
+    number += 1;
+    program.push(number);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_sub1(Program& program)
+{
+    number number;
+    if (!program.pop(number))
+        return error::op_sub1;
+
+    number -= 1;
+    program.push(number);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_negate(Program& program)
+{
+    number number;
+    if (!program.pop(number))
+        return error::op_negate;
+
+    number = -number;
+    program.push(number);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_abs(Program& program)
+{
+    number number;
+    if (!program.pop(number))
+        return error::op_abs;
+
+    if (number < 0)
+        number = -number;
+
+    program.push(number);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_not(Program& program)
+{
+    number number;
+    if (!program.pop(number))
+        return error::op_not;
+
+    program.push(number.is_false());
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_nonzero(Program& program)
+{
+    number number;
+    if (!program.pop(number))
+        return error::op_nonzero;
+
+    program.push(number.is_true());
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_add(Program& program)
+{
+    number first, second;
+    if (!program.pop_binary(first, second))
+        return error::op_add;
+
+    const auto result = first + second;
+    program.push(result);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_sub(Program& program)
+{
+    number first, second;
+    if (!program.pop_binary(first, second))
+        return error::op_sub;
+
+    const auto result = second - first;
+    program.push(result);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_bool_and(Program& program)
+{
+    number first, second;
+    if (!program.pop_binary(first, second))
+        return error::op_bool_and;
+
+    program.push(first.is_true() && second.is_true());
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_bool_or(Program& program)
+{
+    number first, second;
+    if (!program.pop_binary(first, second))
+        return error::op_bool_or;
+
+    program.push(first.is_true() || second.is_true());
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_num_equal(Program& program)
+{
+    number first, second;
+    if (!program.pop_binary(first, second))
+        return error::op_num_equal;
+
+    program.push(first == second);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_num_equal_verify(
+    Program& program)
+{
+    number first, second;
+    if (!program.pop_binary(first, second))
+        return error::op_num_equal_verify1;
+
+    return (first == second) ? error::success :
+        error::op_num_equal_verify2;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_num_not_equal(
+    Program& program)
+{
+    number first, second;
+    if (!program.pop_binary(first, second))
+        return error::op_num_not_equal;
+
+    program.push(first != second);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_less_than(Program& program)
+{
+    number first, second;
+    if (!program.pop_binary(first, second))
+        return error::op_less_than;
+
+    program.push(second < first);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_greater_than(
+    Program& program)
+{
+    number first, second;
+    if (!program.pop_binary(first, second))
+        return error::op_greater_than;
+
+    program.push(second > first);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_less_than_or_equal(
+    Program& program)
+{
+    number first, second;
+    if (!program.pop_binary(first, second))
+        return error::op_less_than_or_equal;
+
+    program.push(second <= first);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_greater_than_or_equal(
+     Program& program)
+{
+    number first, second;
+    if (!program.pop_binary(first, second))
+        return error::op_greater_than_or_equal;
+
+    program.push(second >= first);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_min(Program& program)
+{
+    number first, second;
+    if (!program.pop_binary(first, second))
+        return error::op_min;
+
+    program.push(second < first ? second : first);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_max(Program& program)
+{
+    number first, second;
+    if (!program.pop_binary(first, second))
+        return error::op_max;
+
+    program.push(second > first ? second : first);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_within(Program& program)
+{
+    number first, second, third;
+    if (!program.pop_ternary(first, second, third))
+        return error::op_within;
+
+    program.push(second <= third && third < first);
+    return error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_check_locktime_verify(
+     Program& program)
+{
+    // BIP65: nop2 subsumed by checklocktimeverify when bip65 fork is active.
+    if (!chain::script::is_enabled(program.forks(), rule_fork::bip65_rule))
+        return op_nop(opcode::nop2);
+
+    const auto& tx = program.transaction();
+    const auto input_index = program.input_index();
+
+    if (input_index >= tx.inputs().size())
+        return error::op_check_locktime_verify1;
+
+    // BIP65: the tx sequence is 0xffffffff.
+    if (tx.inputs()[input_index].is_final())
+        return error::op_check_locktime_verify2;
+
+    // BIP65: the stack is empty.
+    // BIP65: extend the (signed) script number range to 5 bytes.
+    number stack;
+    if (!program.top(stack, max_check_locktime_verify_number_size))
+        return error::op_check_locktime_verify3;
+
+    // BIP65: the top stack item is negative.
+    if (stack < 0)
+        return error::op_check_locktime_verify4;
+
+    // The top stack item is positive, so cast is safe.
+    const auto locktime = static_cast<uint64_t>(stack.int64());
+
+    // BIP65: the stack locktime type differs from that of tx.
+    if ((locktime < locktime_threshold) !=
+        (tx.locktime() < locktime_threshold))
+        return error::op_check_locktime_verify5;
+
+    // BIP65: the stack locktime is greater than the tx locktime.
+    return (locktime > tx.locktime()) ? error::op_check_locktime_verify6 :
+        error::success;
+}
+
+template <typename Program>
+error::error_code_t basic_interpreter<Program>::op_check_sequence_verify(
+     Program& program)
+{
+    // BIP112: nop3 subsumed by checksequenceverify when bip112 fork is active.
+    if (!chain::script::is_enabled(program.forks(), rule_fork::bip112_rule))
+        return op_nop(opcode::nop3);
+
+    const auto& tx = program.transaction();
+    const auto input_index = program.input_index();
+
+    if (input_index >= tx.inputs().size())
+        return error::op_check_sequence_verify1;
+
+    // BIP112: the stack is empty.
+    // BIP112: extend the (signed) script number range to 5 bytes.
+    number stack;
+    if (!program.top(stack, max_check_sequence_verify_number_size))
+        return error::op_check_sequence_verify2;
+
+    // BIP112: the top stack item is negative.
+    if (stack < 0)
+        return error::op_check_sequence_verify3;
+
+    // The top stack item is positive, so cast is safe.
+    const auto sequence = static_cast<uint64_t>(stack.int64());
+
+    // BIP112: the stack sequence is disabled, treat as nop3.
+    if ((sequence & relative_locktime_disabled) != 0)
+        return op_nop(opcode::nop3);
+
+    // BIP112: the stack sequence is enabled and tx version less than 2.
+    if (tx.version() < relative_locktime_min_version)
+        return error::op_check_sequence_verify4;
+
+    const auto tx_sequence = tx.inputs()[input_index].sequence();
+
+    // BIP112: the transaction sequence is disabled.
+    if ((tx_sequence & relative_locktime_disabled) != 0)
+        return error::op_check_sequence_verify5;
+
+    // BIP112: the stack sequence type differs from that of tx input.
+    if ((sequence & relative_locktime_time_locked) !=
+        (tx_sequence & relative_locktime_time_locked))
+        return error::op_check_sequence_verify6;
+
+    // BIP112: the masked stack sequence is greater than the tx sequence.
+    return (sequence & relative_locktime_mask) >
+        (tx_sequence & relative_locktime_mask) ?
+        error::op_check_sequence_verify7 : error::success;
+}
+
+} // namespace machine
+} // namespace system
+} // namespace libbitcoin
+
+#endif
@@ -19,6 +19,7 @@
 #ifndef LIBBITCOIN_SYSTEM_MACHINE_INTERPRETER_IPP
 #define LIBBITCOIN_SYSTEM_MACHINE_INTERPRETER_IPP
 
+#include <algorithm>
 #include <cstdint>
 #include <utility>
 #include <bitcoin/system/chain/transaction.hpp>
@@ -42,21 +43,6 @@ static BC_CONSTEXPR auto op_75 = static_cast<uint8_t>(opcode::push_size_75);
 // Operations (shared).
 //-----------------------------------------------------------------------------
 
-inline interpreter::result interpreter::op_nop(opcode)
-{
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_disabled(opcode)
-{
-    return error::op_disabled;
-}
-
-inline interpreter::result interpreter::op_reserved(opcode)
-{
-    return error::op_reserved;
-}
-
 inline interpreter::result interpreter::op_push_number(program& program,
     uint8_t value)
 {
@@ -86,518 +72,6 @@ inline interpreter::result interpreter::op_push_data(program& program,
 
 // Operations (not shared).
 //-----------------------------------------------------------------------------
-// All index parameters are zero-based and relative to stack top.
-
-inline interpreter::result interpreter::op_if(program& program)
-{
-    auto value = false;
-
-    if (program.succeeded())
-    {
-        if (program.empty())
-            return error::op_if;
-
-        value = program.stack_true(false);
-        program.pop();
-    }
-
-    program.open(value);
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_notif(program& program)
-{
-    auto value = false;
-
-    if (program.succeeded())
-    {
-        if (program.empty())
-            return error::op_notif;
-
-        value = !program.stack_true(false);
-        program.pop();
-    }
-
-    program.open(value);
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_else(program& program)
-{
-    if (program.closed())
-        return error::op_else;
-
-    program.negate();
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_endif(program& program)
-{
-    if (program.closed())
-        return error::op_endif;
-
-    program.close();
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_verify(program& program)
-{
-    if (program.empty())
-        return error::op_verify1;
-
-    if (!program.stack_true(false))
-        return error::op_verify2;
-
-    program.pop();
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_return(program&)
-{
-    return error::op_return;
-}
-
-inline interpreter::result interpreter::op_to_alt_stack(program& program)
-{
-    if (program.empty())
-        return error::op_to_alt_stack;
-
-    program.push_alternate(program.pop());
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_from_alt_stack(program& program)
-{
-    if (program.empty_alternate())
-        return error::op_from_alt_stack;
-
-    program.push_move(program.pop_alternate());
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_drop2(program& program)
-{
-    if (program.size() < 2)
-        return error::op_drop2;
-
-    program.pop();
-    program.pop();
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_dup2(program& program)
-{
-    if (program.size() < 2)
-        return error::op_dup2;
-
-    auto item1 = program.item(1);
-    auto item0 = program.item(0);
-
-    program.push_move(std::move(item1));
-    program.push_move(std::move(item0));
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_dup3(program& program)
-{
-    if (program.size() < 3)
-        return error::op_dup3;
-
-    auto item2 = program.item(2);
-    auto item1 = program.item(1);
-    auto item0 = program.item(0);
-
-    program.push_move(std::move(item2));
-    program.push_move(std::move(item1));
-    program.push_move(std::move(item0));
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_over2(program& program)
-{
-    if (program.size() < 4)
-        return error::op_over2;
-
-    auto item3 = program.item(3);
-    auto item2 = program.item(2);
-
-    program.push_move(std::move(item3));
-    program.push_move(std::move(item2));
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_rot2(program& program)
-{
-    if (program.size() < 6)
-        return error::op_rot2;
-
-    const auto position_5 = program.position(5);
-    const auto position_4 = program.position(4);
-
-    auto copy_5 = *position_5;
-    auto copy_4 = *position_4;
-
-    program.erase(position_5, position_4 + 1);
-    program.push_move(std::move(copy_5));
-    program.push_move(std::move(copy_4));
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_swap2(program& program)
-{
-    if (program.size() < 4)
-        return error::op_swap2;
-
-    program.swap(3, 1);
-    program.swap(2, 0);
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_if_dup(program& program)
-{
-    if (program.empty())
-        return error::op_if_dup;
-
-    if (program.stack_true(false))
-        program.duplicate(0);
-
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_depth(program& program)
-{
-    program.push_move(number(program.size()).data());
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_drop(program& program)
-{
-    if (program.empty())
-        return error::op_drop;
-
-    program.pop();
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_dup(program& program)
-{
-    if (program.empty())
-        return error::op_dup;
-
-    program.duplicate(0);
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_nip(program& program)
-{
-    if (program.size() < 2)
-        return error::op_nip;
-
-    program.erase(program.position(1));
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_over(program& program)
-{
-    if (program.size() < 2)
-        return error::op_over;
-
-    program.duplicate(1);
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_pick(program& program)
-{
-    program::stack_iterator position;
-    if (!program.pop_position(position))
-        return error::op_pick;
-
-    program.push_copy(*position);
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_roll(program& program)
-{
-    program::stack_iterator position;
-    if (!program.pop_position(position))
-        return error::op_roll;
-
-    auto copy = *position;
-    program.erase(position);
-    program.push_move(std::move(copy));
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_rot(program& program)
-{
-    if (program.size() < 3)
-        return error::op_rot;
-
-    program.swap(2, 1);
-    program.swap(1, 0);
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_swap(program& program)
-{
-    if (program.size() < 2)
-        return error::op_swap;
-
-    program.swap(1, 0);
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_tuck(program& program)
-{
-    if (program.size() < 2)
-        return error::op_tuck;
-
-    auto first = program.pop();
-    auto second = program.pop();
-    program.push_copy(first);
-    program.push_move(std::move(second));
-    program.push_move(std::move(first));
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_size(program& program)
-{
-    if (program.empty())
-        return error::op_size;
-
-    auto top = program.pop();
-    const auto size = top.size();
-    program.push_move(std::move(top));
-    program.push_move(number(size).data());
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_equal(program& program)
-{
-    if (program.size() < 2)
-        return error::op_equal;
-
-    program.push(program.pop() == program.pop());
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_equal_verify(program& program)
-{
-    if (program.size() < 2)
-        return error::op_equal_verify1;
-
-    return (program.pop() == program.pop()) ? error::success :
-        error::op_equal_verify2;
-}
-
-inline interpreter::result interpreter::op_add1(program& program)
-{
-    number number;
-    if (!program.pop(number))
-        return error::op_add1;
-
-    number += 1;
-    program.push_move(number.data());
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_sub1(program& program)
-{
-    number number;
-    if (!program.pop(number))
-        return error::op_sub1;
-
-    number -= 1;
-    program.push_move(number.data());
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_negate(program& program)
-{
-    number number;
-    if (!program.pop(number))
-        return error::op_negate;
-
-    number = -number;
-    program.push_move(number.data());
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_abs(program& program)
-{
-    number number;
-    if (!program.pop(number))
-        return error::op_abs;
-
-    if (number < 0)
-        number = -number;
-
-    program.push_move(number.data());
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_not(program& program)
-{
-    number number;
-    if (!program.pop(number))
-        return error::op_not;
-
-    program.push(number.is_false());
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_nonzero(program& program)
-{
-    number number;
-    if (!program.pop(number))
-        return error::op_nonzero;
-
-    program.push(number.is_true());
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_add(program& program)
-{
-    number first, second;
-    if (!program.pop_binary(first, second))
-        return error::op_add;
-
-    const auto result = first + second;
-    program.push_move(result.data());
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_sub(program& program)
-{
-    number first, second;
-    if (!program.pop_binary(first, second))
-        return error::op_sub;
-
-    const auto result = second - first;
-    program.push_move(result.data());
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_bool_and(program& program)
-{
-    number first, second;
-    if (!program.pop_binary(first, second))
-        return error::op_bool_and;
-
-    program.push(first.is_true() && second.is_true());
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_bool_or(program& program)
-{
-    number first, second;
-    if (!program.pop_binary(first, second))
-        return error::op_bool_or;
-
-    program.push(first.is_true() || second.is_true());
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_num_equal(program& program)
-{
-    number first, second;
-    if (!program.pop_binary(first, second))
-        return error::op_num_equal;
-
-    program.push(first == second);
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_num_equal_verify(program& program)
-{
-    number first, second;
-    if (!program.pop_binary(first, second))
-        return error::op_num_equal_verify1;
-
-    return (first == second) ? error::success :
-        error::op_num_equal_verify2;
-}
-
-inline interpreter::result interpreter::op_num_not_equal(program& program)
-{
-    number first, second;
-    if (!program.pop_binary(first, second))
-        return error::op_num_not_equal;
-
-    program.push(first != second);
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_less_than(program& program)
-{
-    number first, second;
-    if (!program.pop_binary(first, second))
-        return error::op_less_than;
-
-    program.push(second < first);
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_greater_than(program& program)
-{
-    number first, second;
-    if (!program.pop_binary(first, second))
-        return error::op_greater_than;
-
-    program.push(second > first);
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_less_than_or_equal(program& program)
-{
-    number first, second;
-    if (!program.pop_binary(first, second))
-        return error::op_less_than_or_equal;
-
-    program.push(second <= first);
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_greater_than_or_equal(
-    program& program)
-{
-    number first, second;
-    if (!program.pop_binary(first, second))
-        return error::op_greater_than_or_equal;
-
-    program.push(second >= first);
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_min(program& program)
-{
-    number first, second;
-    if (!program.pop_binary(first, second))
-        return error::op_min;
-
-    program.push_move(second < first ? second.data() : first.data());
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_max(program& program)
-{
-    number first, second;
-    if (!program.pop_binary(first, second))
-        return error::op_max;
-
-    program.push_move(second > first ? second.data() : first.data());
-    return error::success;
-}
-
-inline interpreter::result interpreter::op_within(program& program)
-{
-    number first, second, third;
-    if (!program.pop_ternary(first, second, third))
-        return error::op_within;
-
-    program.push(second <= third && third < first);
-    return error::success;
-}
 
 inline interpreter::result interpreter::op_ripemd160(program& program)
 {
@@ -651,7 +125,9 @@ inline interpreter::result interpreter::op_codeseparator(program& program,
         error::op_code_seperator;
 }
 
-inline interpreter::result interpreter::op_check_sig_verify(program& program)
+// A failed check fails the script, so it is deferrable when so configured.
+inline interpreter::result interpreter::op_check_sig_verify(program& program,
+    bool deferrable)
 {
     if (program.size() < 2)
         return error::op_check_sig_verify1;
@@ -666,11 +142,22 @@ inline interpreter::result interpreter::op_check_sig_verify(program& program)
     const auto public_key = program.pop();
     auto endorsement = program.pop();
 
+    // BIP143: find and delete of the signature is not applied for v0.
+    const auto found = program.version() != script_version::zero &&
+        program.script().is_found(endorsement);
+
+    // Without a code separator the subscript is the script (no copy), and
+    // find and delete of the signature only copies the script if found.
+    const auto copy = found || program.jump() != program.begin() ||
+        !program.script().is_stripped();
+
     // Create a subscript with endorsements stripped (sort of).
-    chain::script script_code(program.subscript());
+    chain::script script_code;
 
-    // BIP143: find and delete of the signature is not applied for v0.
-    if (program.version() != script_version::zero)
+    if (copy)
+        script_code = chain::script(program.subscript());
+
+    if (found)
         script_code.find_and_delete({ endorsement });
 
     // BIP66: Continue to allow empty signature to push false vs. fail.
@@ -683,15 +170,17 @@ inline interpreter::result interpreter::op_check_sig_verify(program& program)
         return error::invalid_signature_encoding;
 
     // Version condition preserves independence of bip141 and bip143.
-    return chain::script::check_signature(signature, sighash, public_key,
-        script_code, program.transaction(), program.input_index(),
-            version, program.value()) ? error::success :
-                error::incorrect_signature;
+    return program.check_signature(signature, sighash, public_key,
+        copy ? script_code : program.script(), version, deferrable) ?
+            error::success : error::incorrect_signature;
 }
 
-inline interpreter::result interpreter::op_check_sig(program& program)
+// The result is deferrable only if it is the final result of the program.
+inline interpreter::result interpreter::op_check_sig(program& program,
+    const operation& op)
 {
-    const auto verified = op_check_sig_verify(program);
+    const auto verified = op_check_sig_verify(program,
+        program.is_deferred(op));
     const auto bip66 = chain::script::is_enabled(program.forks(), bip66_rule);
 
     // BIP66: invalid signature encoding fails the operation.
@@ -702,8 +191,9 @@ inline interpreter::result interpreter::op_check_sig(program& program)
     return error::success;
 }
 
+// A failed check fails the script, so it is deferrable when so configured.
 inline interpreter::result interpreter::op_check_multisig_verify(
-    program& program)
+    program& program, bool deferrable)
 {
     int32_t key_count = 0;
     if (!program.pop(key_count))
@@ -746,13 +236,34 @@ inline interpreter::result interpreter::op_check_multisig_verify(
     auto bip143 = chain::script::is_enabled(program.forks(), bip143_rule);
     auto version = bip143 ? program.version() : script_version::unversioned;
 
+    // BIP143: find and delete of the signatures is not applied for v0.
+    const auto found = version != script_version::zero &&
+        std::any_of(endorsements.begin(), endorsements.end(),
+            [&](const data_chunk& endorsement)
+            {
+                return program.script().is_found(endorsement);
+            });
+
+    // Without a code separator the subscript is the script (no copy), and
+    // find and delete of the signatures only copies the script if found.
+    const auto copy = found || program.jump() != program.begin() ||
+        !program.script().is_stripped();
+
     // Before looping create subscript with endorsements stripped (sort of).
-    chain::script script_code(program.subscript());
+    chain::script script_code;
 
-    // BIP143: find and delete of the signature is not applied for v0.
-    if (version != script_version::zero)
+    if (copy)
+        script_code = chain::script(program.subscript());
+
+    if (found)
         script_code.find_and_delete(endorsements);
 
+    const auto& subscript = copy ? script_code : program.script();
+
+    // Each key is paired with its signature only if the counts are equal.
+    // Otherwise a failed check advances the key, so checks are not deferred.
+    deferrable = deferrable && signature_count == key_count;
+
     for (const auto& public_key: public_keys)
     {
         // The exact number of signatures are required and must be in order.
@@ -769,9 +280,8 @@ inline interpreter::result interpreter::op_check_multisig_verify(
             return error::invalid_signature_encoding;
 
         // Version condition preserves independence of bip141 and bip143.
-        if (chain::script::check_signature(signature, sighash, public_key,
-            script_code, program.transaction(), program.input_index(),
-            version, program.value()))
+        if (program.check_signature(signature, sighash, public_key,
+            subscript, version, deferrable))
             ++endorsement;
     }
 
@@ -779,9 +289,12 @@ inline interpreter::result interpreter::op_check_multisig_verify(
         error::incorrect_signature;
 }
 
-inline interpreter::result interpreter::op_check_multisig(program& program)
+// The result is deferrable only if it is the final result of the program.
+inline interpreter::result interpreter::op_check_multisig(program& program,
+    const operation& op)
 {
-    const auto verified = op_check_multisig_verify(program);
+    const auto verified = op_check_multisig_verify(program,
+        program.is_deferred(op));
     const auto bip66 = chain::script::is_enabled(program.forks(), bip66_rule);
 
     // BIP66: invalid signature encoding fails the operation.
@@ -792,97 +305,6 @@ inline interpreter::result interpreter::op_check_multisig(program& program)
     return error::success;
 }
 
-inline interpreter::result interpreter::op_check_locktime_verify(
-    program& program)
-{
-    // BIP65: nop2 subsumed by checklocktimeverify when bip65 fork is active.
-    if (!chain::script::is_enabled(program.forks(), rule_fork::bip65_rule))
-        return op_nop(opcode::nop2);
-
-    const auto& tx = program.transaction();
-    const auto input_index = program.input_index();
-
-    if (input_index >= tx.inputs().size())
-        return error::op_check_locktime_verify1;
-
-    // BIP65: the tx sequence is 0xffffffff.
-    if (tx.inputs()[input_index].is_final())
-        return error::op_check_locktime_verify2;
-
-    // BIP65: the stack is empty.
-    // BIP65: extend the (signed) script number range to 5 bytes.
-    number stack;
-    if (!program.top(stack, max_check_locktime_verify_number_size))
-        return error::op_check_locktime_verify3;
-
-    // BIP65: the top stack item is negative.
-    if (stack < 0)
-        return error::op_check_locktime_verify4;
-
-    // The top stack item is positive, so cast is safe.
-    const auto locktime = static_cast<uint64_t>(stack.int64());
-
-    // BIP65: the stack locktime type differs from that of tx.
-    if ((locktime < locktime_threshold) !=
-        (tx.locktime() < locktime_threshold))
-        return error::op_check_locktime_verify5;
-
-    // BIP65: the stack locktime is greater than the tx locktime.
-    return (locktime > tx.locktime()) ? error::op_check_locktime_verify6 :
-        error::success;
-}
-
-inline interpreter::result interpreter::op_check_sequence_verify(
-    program& program)
-{
-    // BIP112: nop3 subsumed by checksequenceverify when bip112 fork is active.
-    if (!chain::script::is_enabled(program.forks(), rule_fork::bip112_rule))
-        return op_nop(opcode::nop3);
-
-    const auto& tx = program.transaction();
-    const auto input_index = program.input_index();
-
-    if (input_index >= tx.inputs().size())
-        return error::op_check_sequence_verify1;
-
-    // BIP112: the stack is empty.
-    // BIP112: extend the (signed) script number range to 5 bytes.
-    number stack;
-    if (!program.top(stack, max_check_sequence_verify_number_size))
-        return error::op_check_sequence_verify2;
-
-    // BIP112: the top stack item is negative.
-    if (stack < 0)
-        return error::op_check_sequence_verify3;
-
-    // The top stack item is positive, so cast is safe.
-    const auto sequence = static_cast<uint64_t>(stack.int64());
-
-    // BIP112: the stack sequence is disabled, treat as nop3.
-    if ((sequence & relative_locktime_disabled) != 0)
-        return op_nop(opcode::nop3);
-
-    // BIP112: the stack sequence is enabled and tx version less than 2.
-    if (tx.version() < relative_locktime_min_version)
-        return error::op_check_sequence_verify4;
-
-    const auto tx_sequence = tx.inputs()[input_index].sequence();
-
-    // BIP112: the transaction sequence is disabled.
-    if ((tx_sequence & relative_locktime_disabled) != 0)
-        return error::op_check_sequence_verify5;
-
-    // BIP112: the stack sequence type differs from that of tx input.
-    if ((sequence & relative_locktime_time_locked) !=
-        (tx_sequence & relative_locktime_time_locked))
-        return error::op_check_sequence_verify6;
-
-    // BIP112: the masked stack sequence is greater than the tx sequence.
-    return (sequence & relative_locktime_mask) >
-        (tx_sequence & relative_locktime_mask) ?
-        error::op_check_sequence_verify7 : error::success;
-}
-
 // It is expected that the compiler will produce a very efficient jump table.
 inline interpreter::result interpreter::run_op(const operation& op,
     program& program)
@@ -1162,11 +584,11 @@ inline interpreter::result interpreter::run_op(const operation& op,
         case opcode::codeseparator:
             return op_codeseparator(program, op);
         case opcode::checksig:
-            return op_check_sig(program);
+            return op_check_sig(program, op);
         case opcode::checksigverify:
             return op_check_sig_verify(program);
         case opcode::checkmultisig:
-            return op_check_multisig(program);
+            return op_check_multisig(program, op);
         case opcode::checkmultisigverify:
             return op_check_multisig_verify(program);
         case opcode::nop1:
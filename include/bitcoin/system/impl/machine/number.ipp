@@ -35,9 +35,9 @@ static const uint64_t unsigned_max_int64 = max_int64;
 static const uint64_t absolute_min_int64 = min_int64;
 static const uint64_t negative_bit = number::negative_sign;
 
-inline bool is_negative(const data_chunk& data)
+inline bool is_negative(const data_slice& data)
 {
-    return (data.back() & number::negative_sign) != 0;
+    return (*(data.end() - 1) & number::negative_sign) != 0;
 }
 
 inline number::number()
@@ -54,7 +54,7 @@ inline number::number(int64_t value)
 //-----------------------------------------------------------------------------
 
 // The data is interpreted as little-endian.
-inline bool number::set_data(const data_chunk& data, size_t max_size)
+inline bool number::set_data(const data_slice& data, size_t max_size)
 {
     if (data.size() > max_size)
         return false;
@@ -66,7 +66,7 @@ inline bool number::set_data(const data_chunk& data, size_t max_size)
 
     // This is "from little endian" with a variable buffer.
     for (size_t i = 0; i != data.size(); ++i)
-        value_ |= static_cast<int64_t>(data[i]) << (8 * i);
+        value_ |= static_cast<int64_t>(data.data()[i]) << (8 * i);
 
     if (is_negative(data))
     {
@@ -80,41 +80,69 @@ inline bool number::set_data(const data_chunk& data, size_t max_size)
 
 // The result is little-endian.
 inline data_chunk number::data() const
+{
+    uint8_t buffer[max_data_size];
+    return { buffer, buffer + to_data(buffer) };
+}
+
+// The size is that written by to_data.
+inline size_t number::data_size() const
+{
+    if (value_ == 0)
+        return 0;
+
+    size_t size = 0;
+    uint8_t most_significant = 0;
+    uint64_t absolute = value_ < 0 ? -value_ : value_;
+
+    while (absolute != 0)
+    {
+        most_significant = static_cast<uint8_t>(absolute);
+        absolute >>= 8;
+        ++size;
+    }
+
+    // A sign byte is added if the most significant byte has the sign bit.
+    return size + ((most_significant & negative_sign) != 0 ? 1 : 0);
+}
+
+// The result is little-endian.
+inline size_t number::to_data(uint8_t* buffer) const
 {
     if (value_ == 0)
-        return {};
+        return 0;
 
-    data_chunk data;
+    size_t size = 0;
     const auto set_negative = value_ < 0;
     uint64_t absolute = set_negative ? -value_ : value_;
 
     // This is "to little endian" with a minimal buffer.
     while (absolute != 0)
     {
-        data.push_back(static_cast<uint8_t>(absolute));
+        buffer[size++] = static_cast<uint8_t>(absolute);
         absolute >>= 8;
     }
 
-    const auto negative_bit_set = is_negative(data);
+    const auto negative_bit_set = (buffer[size - 1] & negative_sign) != 0;
 
     // If the most significant byte is >= 0x80 and the value is negative,
     // push a new 0x80 byte that will be popped off when converting to
     // an integral.
     if (negative_bit_set && set_negative)
-        data.push_back(number::negative_sign);
+        buffer[size++] = number::negative_sign;
 
     // If the most significant byte is >= 0x80 and the value is positive,
     // push a new zero-byte to make the significant byte < 0x80 again.
     else if (negative_bit_set)
-        data.push_back(0);
+        buffer[size++] = 0;
 
     // If the most significant byte is < 0x80 and the value is negative,
     // add 0x80 to it, since it will be subtracted and interpreted as
     // a negative when converting to an integral.
     else if (set_negative)
-        data.back() |= number::negative_sign;
+        buffer[size - 1] |= number::negative_sign;
 
-    return data;
+    return size;
 }
 
 inline int32_t number::int32() const
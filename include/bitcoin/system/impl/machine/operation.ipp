@@ -170,7 +170,8 @@ inline const data_chunk& operation::data() const
 // than two bytes to encode. However the four byte encoding can represent
 // a value of any size, so remains valid despite the data size limit.
 //*****************************************************************************
-inline uint32_t operation::read_data_size(opcode code, reader& source)
+template <typename Source>
+uint32_t operation::read_data_size(opcode code, Source& source)
 {
     BC_CONSTEXPR auto op_75 = static_cast<uint8_t>(opcode::push_size_75);
 
@@ -207,13 +208,13 @@ inline opcode operation::opcode_from_size(size_t size)
         return opcode::push_four_size;
 }
 
-inline opcode operation::minimal_opcode_from_data(const data_chunk& data)
+inline opcode operation::minimal_opcode_from_data(const data_slice& data)
 {
     const auto size = data.size();
 
     if (size == 1)
     {
-        const auto value = data.front();
+        const auto value = *data.begin();
 
         if (value == number::negative_1)
             return opcode::push_negative_1;
@@ -229,7 +230,7 @@ inline opcode operation::minimal_opcode_from_data(const data_chunk& data)
     return opcode_from_size(size);
 }
 
-inline opcode operation::nominal_opcode_from_data(const data_chunk& data)
+inline opcode operation::nominal_opcode_from_data(const data_slice& data)
 {
     return opcode_from_size(data.size());
 }
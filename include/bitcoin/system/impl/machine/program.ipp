@@ -71,6 +71,11 @@ inline script_version program::version() const
     return version_;
 }
 
+inline const chain::script& program::script() const
+{
+    return script_;
+}
+
 inline const chain::transaction& program::transaction() const
 {
     return transaction_;
@@ -129,6 +134,14 @@ inline bool program::increment_operation_count(int32_t public_keys)
     return !operation_overflow(operation_count_);
 }
 
+// Counted operations of a conditional branch that is jumped, not evaluated.
+inline bool program::skip_operation_count(size_t counted_operations)
+{
+    // Addition is safe due to script size metadata.
+    operation_count_ += counted_operations;
+    return !operation_overflow(operation_count_);
+}
+
 inline bool program::set_jump_register(const operation& op, int32_t offset)
 {
     if (script_.empty())
@@ -163,6 +176,11 @@ inline void program::push(bool value)
     push_move(value ? value_type{ number::positive_1 } : value_type{});
 }
 
+inline void program::push(const number& value)
+{
+    push_move(value.data());
+}
+
 // Be explicit about the intent to move or copy, to get compiler help.
 inline void program::push_move(value_type&& item)
 {
@@ -0,0 +1,179 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_MACHINE_STACK_ITEM_IPP
+#define LIBBITCOIN_SYSTEM_MACHINE_STACK_ITEM_IPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/system/machine/number.hpp>
+#include <bitcoin/system/utility/data.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace machine {
+
+// The held value is not initialized beyond its size.
+inline stack_item::stack_item()
+  : view_(nullptr),
+    number_(0),
+    numeric_(false),
+    encoded_(true),
+    size_(0)
+{
+}
+
+inline stack_item::stack_item(const data_slice& view)
+  : view_(view.data()),
+    number_(0),
+    numeric_(false),
+    encoded_(true),
+    size_(static_cast<uint32_t>(view.size()))
+{
+}
+
+template <size_t Size>
+stack_item::stack_item(const byte_array<Size>& value)
+  : view_(nullptr),
+    number_(0),
+    numeric_(false),
+    encoded_(true),
+    size_(Size)
+{
+    static_assert(Size <= capacity, "stack item value too large");
+    std::copy(value.begin(), value.end(), value_);
+}
+
+inline stack_item::stack_item(const number& value)
+  : view_(nullptr),
+    number_(value.int64()),
+    numeric_(true),
+    encoded_(false),
+    size_(0)
+{
+    static_assert(number::max_data_size <= capacity, "number too large");
+}
+
+// static
+inline stack_item stack_item::from_bool(bool value)
+{
+    return stack_item(number(value ? 1 : 0));
+}
+
+// private
+inline void stack_item::encode() const
+{
+    if (encoded_)
+        return;
+
+    size_ = static_cast<uint32_t>(number(number_).to_data(value_));
+    encoded_ = true;
+}
+
+// A copied item holds its own copy of a held value.
+inline const uint8_t* stack_item::data() const
+{
+    encode();
+    return view_ == nullptr ? value_ : view_;
+}
+
+inline const uint8_t* stack_item::begin() const
+{
+    return data();
+}
+
+// Encoding sets size_, so it must precede the read of size_.
+inline const uint8_t* stack_item::end() const
+{
+    const auto begin = data();
+    return begin + size_;
+}
+
+inline size_t stack_item::size() const
+{
+    encode();
+    return size_;
+}
+
+// Zero is the only number encoded as empty.
+inline bool stack_item::empty() const
+{
+    return numeric_ ? number_ == 0 : size_ == 0;
+}
+
+// Nonzero is the only number encoded as true.
+inline bool stack_item::is_true() const
+{
+    if (numeric_)
+        return number_ != 0;
+
+    if (empty())
+        return false;
+
+    const auto last = end() - 1;
+    const auto not_zero = [](uint8_t value)
+    {
+        return value != number::positive_0;
+    };
+
+    // Negative zero is false.
+    return (*last & ~number::negative_sign) != number::positive_0 ||
+        std::any_of(begin(), last, not_zero);
+}
+
+// The size limit of a number is applied to its encoding, without encoding.
+inline bool stack_item::to_number(number& out_number,
+    size_t maximum_size) const
+{
+    if (!numeric_)
+        return out_number.set_data({ begin(), end() }, maximum_size);
+
+    const number value(number_);
+    if (value.data_size() > maximum_size)
+        return false;
+
+    out_number = value;
+    return true;
+}
+
+inline data_chunk stack_item::to_chunk() const
+{
+    return { begin(), end() };
+}
+
+// Numbers are minimally encoded, so are equal only if their values are.
+inline bool stack_item::operator==(const stack_item& other) const
+{
+    if (numeric_ && other.numeric_)
+        return number_ == other.number_;
+
+    return size() == other.size() && std::equal(begin(), end(),
+        other.begin());
+}
+
+inline bool stack_item::operator!=(const stack_item& other) const
+{
+    return !(*this == other);
+}
+
+} // namespace machine
+} // namespace system
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,573 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_MACHINE_VIEW_INTERPRETER_IPP
+#define LIBBITCOIN_SYSTEM_MACHINE_VIEW_INTERPRETER_IPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <bitcoin/system/chain/transaction.hpp>
+#include <bitcoin/system/chain/script.hpp>
+#include <bitcoin/system/define.hpp>
+#include <bitcoin/system/error.hpp>
+#include <bitcoin/system/math/elliptic_curve.hpp>
+#include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/machine/number.hpp>
+#include <bitcoin/system/machine/opcode.hpp>
+#include <bitcoin/system/machine/operation.hpp>
+#include <bitcoin/system/machine/operation_iterator.hpp>
+#include <bitcoin/system/machine/stack_item.hpp>
+#include <bitcoin/system/machine/view_program.hpp>
+#include <bitcoin/system/utility/assert.hpp>
+#include <bitcoin/system/utility/data.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace machine {
+
+// Operations (shared).
+//-----------------------------------------------------------------------------
+
+inline view_interpreter::result view_interpreter::op_push_number(
+    view_program& program, uint8_t value)
+{
+    const auto negative = (value == number::negative_1);
+    program.push(number(negative ? -1 : value));
+    return error::success;
+}
+
+inline view_interpreter::result view_interpreter::op_push_size(
+    view_program& program, const data_slice& data)
+{
+    BC_CONSTEXPR auto op_75 = static_cast<uint8_t>(opcode::push_size_75);
+
+    if (data.size() > op_75)
+        return error::op_push_size;
+
+    program.push_move(stack_item(data));
+    return error::success;
+}
+
+inline view_interpreter::result view_interpreter::op_push_data(
+    view_program& program, const data_slice& data, uint32_t size_limit)
+{
+    if (data.size() > size_limit)
+        return error::op_push_data;
+
+    program.push_move(stack_item(data));
+    return error::success;
+}
+
+// Operations (not shared).
+//-----------------------------------------------------------------------------
+
+inline view_interpreter::result view_interpreter::op_ripemd160(
+    view_program& program)
+{
+    if (program.empty())
+        return error::op_ripemd160;
+
+    program.push_move(stack_item(ripemd160_hash(program.pop())));
+    return error::success;
+}
+
+inline view_interpreter::result view_interpreter::op_sha1(
+    view_program& program)
+{
+    if (program.empty())
+        return error::op_sha1;
+
+    program.push_move(stack_item(sha1_hash(program.pop())));
+    return error::success;
+}
+
+inline view_interpreter::result view_interpreter::op_sha256(
+    view_program& program)
+{
+    if (program.empty())
+        return error::op_sha256;
+
+    program.push_move(stack_item(sha256_hash(program.pop())));
+    return error::success;
+}
+
+inline view_interpreter::result view_interpreter::op_hash160(
+    view_program& program)
+{
+    if (program.empty())
+        return error::op_hash160;
+
+    program.push_move(stack_item(bitcoin_short_hash(program.pop())));
+    return error::success;
+}
+
+inline view_interpreter::result view_interpreter::op_hash256(
+    view_program& program)
+{
+    if (program.empty())
+        return error::op_hash256;
+
+    program.push_move(stack_item(bitcoin_hash(program.pop())));
+    return error::success;
+}
+
+// A failed check fails the script, so it is deferrable when so configured.
+inline view_interpreter::result view_interpreter::op_check_sig_verify(
+    view_program& program, bool deferrable)
+{
+    if (program.size() < 2)
+        return error::op_check_sig_verify1;
+
+    uint8_t sighash;
+    ec_signature signature;
+    auto bip66 = chain::script::is_enabled(program.forks(), bip66_rule);
+    auto bip143 = chain::script::is_enabled(program.forks(), bip143_rule);
+    auto version = bip143 ? program.version() : script_version::unversioned;
+
+    const auto public_key = program.pop();
+    const auto endorsement = program.pop();
+
+    // BIP66: Continue to allow empty signature to push false vs. fail.
+    if (endorsement.empty())
+        return error::incorrect_signature;
+
+    // Parse endorsement into DER signature into an EC signature.
+    sighash = *std::prev(endorsement.end());
+    const data_slice distinguished(endorsement.begin(),
+        std::prev(endorsement.end()));
+
+    if (!parse_signature(signature, distinguished, bip66))
+        return error::invalid_signature_encoding;
+
+    const auto& script = program.script();
+
+    // Without a code separator the subscript is the script (no copy), and
+    // find and delete of the signature only copies the script if found.
+    // BIP143: find and delete of the signature is not applied for v0.
+    if (program.version() == script_version::zero ||
+        !script.is_found({ endorsement.begin(), endorsement.end() }))
+        return program.check_signature(signature, sighash, public_key,
+            script, version, deferrable) ? error::success :
+                error::incorrect_signature;
+
+    chain::script script_code(script);
+    script_code.find_and_delete({ endorsement.to_chunk() });
+
+    // Version condition preserves independence of bip141 and bip143.
+    return program.check_signature(signature, sighash, public_key,
+        script_code, version, deferrable) ? error::success :
+            error::incorrect_signature;
+}
+
+// The result is deferrable only if it is the final result of the program.
+inline view_interpreter::result view_interpreter::op_check_sig(
+    view_program& program, bool last)
+{
+    const auto verified = op_check_sig_verify(program,
+        program.is_deferred(last));
+    const auto bip66 = chain::script::is_enabled(program.forks(), bip66_rule);
+
+    // BIP66: invalid signature encoding fails the operation.
+    if (bip66 && verified == error::invalid_signature_encoding)
+        return error::op_check_sig;
+
+    program.push(verified == error::success);
+    return error::success;
+}
+
+// It is expected that the compiler will produce a very efficient jump table.
+inline view_interpreter::result view_interpreter::run_op(
+    const operation_iterator& op, view_program& program)
+{
+    const auto code = op.code();
+    BITCOIN_ASSERT(op.data().empty() || op.is_push());
+
+    switch (code)
+    {
+        case opcode::push_size_0:
+        case opcode::push_size_1:
+        case opcode::push_size_2:
+        case opcode::push_size_3:
+        case opcode::push_size_4:
+        case opcode::push_size_5:
+        case opcode::push_size_6:
+        case opcode::push_size_7:
+        case opcode::push_size_8:
+        case opcode::push_size_9:
+        case opcode::push_size_10:
+        case opcode::push_size_11:
+        case opcode::push_size_12:
+        case opcode::push_size_13:
+        case opcode::push_size_14:
+        case opcode::push_size_15:
+        case opcode::push_size_16:
+        case opcode::push_size_17:
+        case opcode::push_size_18:
+        case opcode::push_size_19:
+        case opcode::push_size_20:
+        case opcode::push_size_21:
+        case opcode::push_size_22:
+        case opcode::push_size_23:
+        case opcode::push_size_24:
+        case opcode::push_size_25:
+        case opcode::push_size_26:
+        case opcode::push_size_27:
+        case opcode::push_size_28:
+        case opcode::push_size_29:
+        case opcode::push_size_30:
+        case opcode::push_size_31:
+        case opcode::push_size_32:
+        case opcode::push_size_33:
+        case opcode::push_size_34:
+        case opcode::push_size_35:
+        case opcode::push_size_36:
+        case opcode::push_size_37:
+        case opcode::push_size_38:
+        case opcode::push_size_39:
+        case opcode::push_size_40:
+        case opcode::push_size_41:
+        case opcode::push_size_42:
+        case opcode::push_size_43:
+        case opcode::push_size_44:
+        case opcode::push_size_45:
+        case opcode::push_size_46:
+        case opcode::push_size_47:
+        case opcode::push_size_48:
+        case opcode::push_size_49:
+        case opcode::push_size_50:
+        case opcode::push_size_51:
+        case opcode::push_size_52:
+        case opcode::push_size_53:
+        case opcode::push_size_54:
+        case opcode::push_size_55:
+        case opcode::push_size_56:
+        case opcode::push_size_57:
+        case opcode::push_size_58:
+        case opcode::push_size_59:
+        case opcode::push_size_60:
+        case opcode::push_size_61:
+        case opcode::push_size_62:
+        case opcode::push_size_63:
+        case opcode::push_size_64:
+        case opcode::push_size_65:
+        case opcode::push_size_66:
+        case opcode::push_size_67:
+        case opcode::push_size_68:
+        case opcode::push_size_69:
+        case opcode::push_size_70:
+        case opcode::push_size_71:
+        case opcode::push_size_72:
+        case opcode::push_size_73:
+        case opcode::push_size_74:
+        case opcode::push_size_75:
+            return op_push_size(program, op.data());
+        case opcode::push_one_size:
+            return op_push_data(program, op.data(), max_uint8);
+        case opcode::push_two_size:
+            return op_push_data(program, op.data(), max_uint16);
+        case opcode::push_four_size:
+            return op_push_data(program, op.data(), max_uint32);
+        case opcode::push_negative_1:
+            return op_push_number(program, number::negative_1);
+        case opcode::reserved_80:
+            return op_reserved(code);
+        case opcode::push_positive_1:
+            return op_push_number(program, number::positive_1);
+        case opcode::push_positive_2:
+            return op_push_number(program, number::positive_2);
+        case opcode::push_positive_3:
+            return op_push_number(program, number::positive_3);
+        case opcode::push_positive_4:
+            return op_push_number(program, number::positive_4);
+        case opcode::push_positive_5:
+            return op_push_number(program, number::positive_5);
+        case opcode::push_positive_6:
+            return op_push_number(program, number::positive_6);
+        case opcode::push_positive_7:
+            return op_push_number(program, number::positive_7);
+        case opcode::push_positive_8:
+            return op_push_number(program, number::positive_8);
+        case opcode::push_positive_9:
+            return op_push_number(program, number::positive_9);
+        case opcode::push_positive_10:
+            return op_push_number(program, number::positive_10);
+        case opcode::push_positive_11:
+            return op_push_number(program, number::positive_11);
+        case opcode::push_positive_12:
+            return op_push_number(program, number::positive_12);
+        case opcode::push_positive_13:
+            return op_push_number(program, number::positive_13);
+        case opcode::push_positive_14:
+            return op_push_number(program, number::positive_14);
+        case opcode::push_positive_15:
+            return op_push_number(program, number::positive_15);
+        case opcode::push_positive_16:
+            return op_push_number(program, number::positive_16);
+        case opcode::nop:
+            return op_nop(code);
+        case opcode::reserved_98:
+            return op_reserved(code);
+        case opcode::if_:
+            return op_if(program);
+        case opcode::notif:
+            return op_notif(program);
+        case opcode::disabled_verif:
+            return op_disabled(code);
+        case opcode::disabled_vernotif:
+            return op_disabled(code);
+        case opcode::else_:
+            return op_else(program);
+        case opcode::endif:
+            return op_endif(program);
+        case opcode::verify:
+            return op_verify(program);
+        case opcode::return_:
+            return op_return(program);
+        case opcode::toaltstack:
+            return op_to_alt_stack(program);
+        case opcode::fromaltstack:
+            return op_from_alt_stack(program);
+        case opcode::drop2:
+            return op_drop2(program);
+        case opcode::dup2:
+            return op_dup2(program);
+        case opcode::dup3:
+            return op_dup3(program);
+        case opcode::over2:
+            return op_over2(program);
+        case opcode::rot2:
+            return op_rot2(program);
+        case opcode::swap2:
+            return op_swap2(program);
+        case opcode::ifdup:
+            return op_if_dup(program);
+        case opcode::depth:
+            return op_depth(program);
+        case opcode::drop:
+            return op_drop(program);
+        case opcode::dup:
+            return op_dup(program);
+        case opcode::nip:
+            return op_nip(program);
+        case opcode::over:
+            return op_over(program);
+        case opcode::pick:
+            return op_pick(program);
+        case opcode::roll:
+            return op_roll(program);
+        case opcode::rot:
+            return op_rot(program);
+        case opcode::swap:
+            return op_swap(program);
+        case opcode::tuck:
+            return op_tuck(program);
+        case opcode::disabled_cat:
+            return op_disabled(code);
+        case opcode::disabled_substr:
+            return op_disabled(code);
+        case opcode::disabled_left:
+            return op_disabled(code);
+        case opcode::disabled_right:
+            return op_disabled(code);
+        case opcode::size:
+            return op_size(program);
+        case opcode::disabled_invert:
+            return op_disabled(code);
+        case opcode::disabled_and:
+            return op_disabled(code);
+        case opcode::disabled_or:
+            return op_disabled(code);
+        case opcode::disabled_xor:
+            return op_disabled(code);
+        case opcode::equal:
+            return op_equal(program);
+        case opcode::equalverify:
+            return op_equal_verify(program);
+        case opcode::reserved_137:
+            return op_reserved(code);
+        case opcode::reserved_138:
+            return op_reserved(code);
+        case opcode::add1:
+            return op_add1(program);
+        case opcode::sub1:
+            return op_sub1(program);
+        case opcode::disabled_mul2:
+            return op_disabled(code);
+        case opcode::disabled_div2:
+            return op_disabled(code);
+        case opcode::negate:
+            return op_negate(program);
+        case opcode::abs:
+            return op_abs(program);
+        case opcode::not_:
+            return op_not(program);
+        case opcode::nonzero:
+            return op_nonzero(program);
+        case opcode::add:
+            return op_add(program);
+        case opcode::sub:
+            return op_sub(program);
+        case opcode::disabled_mul:
+            return op_disabled(code);
+        case opcode::disabled_div:
+            return op_disabled(code);
+        case opcode::disabled_mod:
+            return op_disabled(code);
+        case opcode::disabled_lshift:
+            return op_disabled(code);
+        case opcode::disabled_rshift:
+            return op_disabled(code);
+        case opcode::booland:
+            return op_bool_and(program);
+        case opcode::boolor:
+            return op_bool_or(program);
+        case opcode::numequal:
+            return op_num_equal(program);
+        case opcode::numequalverify:
+            return op_num_equal_verify(program);
+        case opcode::numnotequal:
+            return op_num_not_equal(program);
+        case opcode::lessthan:
+            return op_less_than(program);
+        case opcode::greaterthan:
+            return op_greater_than(program);
+        case opcode::lessthanorequal:
+            return op_less_than_or_equal(program);
+        case opcode::greaterthanorequal:
+            return op_greater_than_or_equal(program);
+        case opcode::min:
+            return op_min(program);
+        case opcode::max:
+            return op_max(program);
+        case opcode::within:
+            return op_within(program);
+        case opcode::ripemd160:
+            return op_ripemd160(program);
+        case opcode::sha1:
+            return op_sha1(program);
+        case opcode::sha256:
+            return op_sha256(program);
+        case opcode::hash160:
+            return op_hash160(program);
+        case opcode::hash256:
+            return op_hash256(program);
+        case opcode::checksig:
+            return op_check_sig(program, op.is_last());
+        case opcode::checksigverify:
+            return op_check_sig_verify(program);
+        case opcode::codeseparator:
+        case opcode::checkmultisig:
+        case opcode::checkmultisigverify:
+            BITCOIN_ASSERT_MSG(false, "unsupported operation");
+            return error::operation_failed;
+        case opcode::nop1:
+            return op_nop(code);
+        case opcode::checklocktimeverify:
+            return op_check_locktime_verify(program);
+        case opcode::checksequenceverify:
+            return op_check_sequence_verify(program);
+        case opcode::nop4:
+        case opcode::nop5:
+        case opcode::nop6:
+        case opcode::nop7:
+        case opcode::nop8:
+        case opcode::nop9:
+        case opcode::nop10:
+            return op_nop(code);
+        case opcode::reserved_186:
+        case opcode::reserved_187:
+        case opcode::reserved_188:
+        case opcode::reserved_189:
+        case opcode::reserved_190:
+        case opcode::reserved_191:
+        case opcode::reserved_192:
+        case opcode::reserved_193:
+        case opcode::reserved_194:
+        case opcode::reserved_195:
+        case opcode::reserved_196:
+        case opcode::reserved_197:
+        case opcode::reserved_198:
+        case opcode::reserved_199:
+        case opcode::reserved_200:
+        case opcode::reserved_201:
+        case opcode::reserved_202:
+        case opcode::reserved_203:
+        case opcode::reserved_204:
+        case opcode::reserved_205:
+        case opcode::reserved_206:
+        case opcode::reserved_207:
+        case opcode::reserved_208:
+        case opcode::reserved_209:
+        case opcode::reserved_210:
+        case opcode::reserved_211:
+        case opcode::reserved_212:
+        case opcode::reserved_213:
+        case opcode::reserved_214:
+        case opcode::reserved_215:
+        case opcode::reserved_216:
+        case opcode::reserved_217:
+        case opcode::reserved_218:
+        case opcode::reserved_219:
+        case opcode::reserved_220:
+        case opcode::reserved_221:
+        case opcode::reserved_222:
+        case opcode::reserved_223:
+        case opcode::reserved_224:
+        case opcode::reserved_225:
+        case opcode::reserved_226:
+        case opcode::reserved_227:
+        case opcode::reserved_228:
+        case opcode::reserved_229:
+        case opcode::reserved_230:
+        case opcode::reserved_231:
+        case opcode::reserved_232:
+        case opcode::reserved_233:
+        case opcode::reserved_234:
+        case opcode::reserved_235:
+        case opcode::reserved_236:
+        case opcode::reserved_237:
+        case opcode::reserved_238:
+        case opcode::reserved_239:
+        case opcode::reserved_240:
+        case opcode::reserved_241:
+        case opcode::reserved_242:
+        case opcode::reserved_243:
+        case opcode::reserved_244:
+        case opcode::reserved_245:
+        case opcode::reserved_246:
+        case opcode::reserved_247:
+        case opcode::reserved_248:
+        case opcode::reserved_249:
+        case opcode::reserved_250:
+        case opcode::reserved_251:
+        case opcode::reserved_252:
+        case opcode::reserved_253:
+        case opcode::reserved_254:
+        case opcode::reserved_255:
+        default:
+            return op_reserved(code);
+    }
+}
+
+} // namespace machine
+} // namespace system
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,362 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_MACHINE_VIEW_PROGRAM_IPP
+#define LIBBITCOIN_SYSTEM_MACHINE_VIEW_PROGRAM_IPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <bitcoin/system/chain/script.hpp>
+#include <bitcoin/system/chain/transaction.hpp>
+#include <bitcoin/system/constants.hpp>
+#include <bitcoin/system/machine/number.hpp>
+#include <bitcoin/system/machine/operation.hpp>
+#include <bitcoin/system/machine/operation_iterator.hpp>
+#include <bitcoin/system/machine/script_version.hpp>
+#include <bitcoin/system/machine/stack_item.hpp>
+#include <bitcoin/system/utility/assert.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace machine {
+
+// Constant registers.
+//-----------------------------------------------------------------------------
+
+// Check initial program state for validity (i.e. can evaluation return true).
+inline bool view_program::is_invalid() const
+{
+    const auto push_size = [](const stack_item& item)
+    {
+        return item.size() <= max_push_data_size;
+    };
+
+    // Invalid operations are detected from the bytes, without decoding.
+    auto valid = true;
+    operation_iterator op(script_.bytes());
+    while (op.next())
+        valid = op.is_valid();
+
+    // Stack elements must be within push size limit (bip141).
+    return !valid
+        || script_.is_unspendable()
+        || script_.is_oversized()
+        || !std::all_of(primary_.begin(), primary_.end(), push_size);
+}
+
+inline uint32_t view_program::forks() const
+{
+    return forks_;
+}
+
+inline uint32_t view_program::input_index() const
+{
+    return input_index_;
+}
+
+inline uint64_t view_program::value() const
+{
+    return value_;
+}
+
+inline script_version view_program::version() const
+{
+    return version_;
+}
+
+inline const chain::script& view_program::script() const
+{
+    return script_;
+}
+
+inline const chain::transaction& view_program::transaction() const
+{
+    return transaction_;
+}
+
+// Instructions.
+//-----------------------------------------------------------------------------
+
+inline bool view_program::increment_operation_count(opcode code)
+{
+    // Addition is safe due to script size metadata.
+    if (operation::is_counted(code))
+        ++operation_count_;
+
+    return operation_count_ <= max_counted_ops;
+}
+
+inline bool view_program::increment_operation_count(int32_t public_keys)
+{
+    static const auto max_keys = static_cast<int32_t>(max_script_public_keys);
+
+    // bit.ly/2d1bsdB
+    if (public_keys < 0 || public_keys > max_keys)
+        return false;
+
+    // Addition is safe due to script size metadata.
+    operation_count_ += public_keys;
+    return operation_count_ <= max_counted_ops;
+}
+
+// Primary stack (push).
+//-----------------------------------------------------------------------------
+
+inline void view_program::push(bool value)
+{
+    primary_.push_back(stack_item::from_bool(value));
+}
+
+inline void view_program::push(const number& value)
+{
+    primary_.push_back(stack_item(value));
+}
+
+// Items do not own their data, so a move is a copy, as with program.
+inline void view_program::push_move(stack_item&& item)
+{
+    primary_.push_back(item);
+}
+
+inline void view_program::push_copy(const stack_item& item)
+{
+    primary_.push_back(item);
+}
+
+// Primary stack (pop).
+//-----------------------------------------------------------------------------
+
+// This must be guarded.
+inline stack_item view_program::pop()
+{
+    BITCOIN_ASSERT(!empty());
+    const auto value = primary_.back();
+    primary_.pop_back();
+    return value;
+}
+
+inline bool view_program::pop(int32_t& out_value)
+{
+    number value;
+    if (!pop(value))
+        return false;
+
+    out_value = value.int32();
+    return true;
+}
+
+inline bool view_program::pop(number& out_number, size_t maxiumum_size)
+{
+    return !empty() && pop().to_number(out_number, maxiumum_size);
+}
+
+inline bool view_program::pop_binary(number& first, number& second)
+{
+    // The right hand side number is at the top of the stack.
+    return pop(first) && pop(second);
+}
+
+inline bool view_program::pop_ternary(number& first, number& second,
+    number& third)
+{
+    // The upper bound is at stack top, lower bound next, value next.
+    return pop(first) && pop(second) && pop(third);
+}
+
+// Determines if popped value is valid post-pop stack index and returns index.
+inline bool view_program::pop_position(stack_iterator& out_position)
+{
+    int32_t signed_index;
+    if (!pop(signed_index))
+        return false;
+
+    // Ensure the index is within bounds.
+
+    if (signed_index < 0)
+        return false;
+
+    const auto index = static_cast<uint32_t>(signed_index);
+
+    if (index >= size())
+        return false;
+
+    out_position = position(index);
+    return true;
+}
+
+// Primary push/pop optimizations (active).
+//-----------------------------------------------------------------------------
+
+// The item is copied before the push, as the push may reallocate the stack.
+inline void view_program::duplicate(size_t index)
+{
+    const auto copy = item(index);
+    push_copy(copy);
+}
+
+inline void view_program::swap(size_t index_left, size_t index_right)
+{
+    std::swap(*position(index_left), *position(index_right));
+}
+
+inline void view_program::erase(const stack_iterator& position)
+{
+    primary_.erase(position);
+}
+
+inline void view_program::erase(const stack_iterator& first,
+    const stack_iterator& last)
+{
+    primary_.erase(first, last);
+}
+
+// Primary push/pop optimizations (passive).
+//-----------------------------------------------------------------------------
+
+// private
+inline bool view_program::stack_to_bool(bool clean) const
+{
+    if (clean && primary_.size() != 1)
+        return false;
+
+    return primary_.back().is_true();
+}
+
+inline bool view_program::empty() const
+{
+    return primary_.empty();
+}
+
+// This must be guarded (intended for interpreter internal use).
+inline bool view_program::stack_true(bool clean) const
+{
+    BITCOIN_ASSERT(!empty());
+    return stack_to_bool(clean);
+}
+
+// This is safe to call when empty (intended for completion handlers).
+inline bool view_program::stack_result(bool clean) const
+{
+    return !empty() && stack_true(clean);
+}
+
+inline bool view_program::is_stack_overflow() const
+{
+    // bit.ly/2cowHlP
+    // Addition is safe due to script size metadata.
+    return size() + alternate_.size() > max_stack_size;
+}
+
+inline bool view_program::if_(opcode code) const
+{
+    // Skip operation if failed and the operator is unconditional.
+    return operation::is_conditional(code) || succeeded();
+}
+
+// This must be guarded.
+inline const stack_item& view_program::item(size_t index) const
+{
+    BITCOIN_ASSERT(index < size());
+    return *std::prev(primary_.end(), ++index);
+}
+
+inline bool view_program::top(number& out_number, size_t maxiumum_size) const
+{
+    return !empty() && item(0).to_number(out_number, maxiumum_size);
+}
+
+// This must be guarded.
+inline view_program::stack_iterator view_program::position(size_t index)
+{
+    // Decrementing 1 makes the stack index zero-based (unlike satoshi).
+    BITCOIN_ASSERT(index < size());
+    return std::prev(primary_.end(), ++index);
+}
+
+inline size_t view_program::size() const
+{
+    return primary_.size();
+}
+
+// Alternate stack.
+//-----------------------------------------------------------------------------
+
+inline bool view_program::empty_alternate() const
+{
+    return alternate_.empty();
+}
+
+inline void view_program::push_alternate(const stack_item& value)
+{
+    alternate_.push_back(value);
+}
+
+// This must be guarded.
+inline stack_item view_program::pop_alternate()
+{
+    BITCOIN_ASSERT(!alternate_.empty());
+    const auto value = alternate_.back();
+    alternate_.pop_back();
+    return value;
+}
+
+// Conditional stack.
+//-----------------------------------------------------------------------------
+
+inline void view_program::open(bool value)
+{
+    negative_count_ += (value ? 0 : 1);
+    condition_.push_back(value);
+}
+
+// This must be guarded.
+inline void view_program::negate()
+{
+    BITCOIN_ASSERT(!closed());
+    const auto value = condition_.back();
+    negative_count_ += (value ? 1 : -1);
+    condition_.back() = !value;
+}
+
+// This must be guarded.
+inline void view_program::close()
+{
+    BITCOIN_ASSERT(!closed());
+    const auto value = condition_.back();
+    negative_count_ += (value ? 0 : -1);
+    condition_.pop_back();
+}
+
+inline bool view_program::closed() const
+{
+    return condition_.empty();
+}
+
+inline bool view_program::succeeded() const
+{
+    return negative_count_ == 0;
+}
+
+} // namespace machine
+} // namespace system
+} // namespace libbitcoin
+
+#endif
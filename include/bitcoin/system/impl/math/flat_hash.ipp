@@ -0,0 +1,308 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_FLAT_HASH_IPP
+#define LIBBITCOIN_SYSTEM_FLAT_HASH_IPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <bitcoin/system/utility/assert.hpp>
+#include <bitcoin/system/utility/endian.hpp>
+
+namespace libbitcoin {
+namespace system {
+
+// salted_hash
+//-----------------------------------------------------------------------------
+
+// The murmur3 64 bit finalizer, over the salted key. Each slot bit depends
+// on all bits of the key and salt, as a multiply alone carries only upward.
+inline size_t salted_hash::mix(uint64_t value) const
+{
+    value ^= salt_;
+    value = (value ^ (value >> 33)) * 0xff51afd7ed558ccd;
+    value = (value ^ (value >> 33)) * 0xc4ceb9fe1a85ec53;
+    return static_cast<size_t>(value ^ (value >> 33));
+}
+
+template <size_t Size>
+size_t digest_hasher<byte_array<Size>>::operator()(
+    const byte_array<Size>& key) const
+{
+    return mix(from_little_endian_unsafe<uint64_t>(key.begin()));
+}
+
+// flat_table
+//-----------------------------------------------------------------------------
+
+template <typename Key, typename Slot, typename Hasher>
+flat_table<Key, Slot, Hasher>::flat_table(size_t entries, const Hasher& hasher)
+  : size_(0), mask_(0), hasher_(hasher)
+{
+    reserve(entries);
+}
+
+template <typename Key, typename Slot, typename Hasher>
+size_t flat_table<Key, Slot, Hasher>::capacity() const
+{
+    return slots_.size() / 2u;
+}
+
+template <typename Key, typename Slot, typename Hasher>
+size_t flat_table<Key, Slot, Hasher>::size() const
+{
+    return size_;
+}
+
+template <typename Key, typename Slot, typename Hasher>
+bool flat_table<Key, Slot, Hasher>::empty() const
+{
+    return size_ == 0;
+}
+
+template <typename Key, typename Slot, typename Hasher>
+void flat_table<Key, Slot, Hasher>::reserve(size_t entries)
+{
+    if (entries > capacity())
+        rehash(slot_count(entries));
+}
+
+template <typename Key, typename Slot, typename Hasher>
+void flat_table<Key, Slot, Hasher>::clear()
+{
+    // Release any resources held by values of the map.
+    for (size_t index = 0; index < slots_.size(); ++index)
+        if (used_[index] != 0)
+            slots_[index] = Slot();
+
+    std::fill(used_.begin(), used_.end(), 0);
+    size_ = 0;
+}
+
+template <typename Key, typename Slot, typename Hasher>
+bool flat_table<Key, Slot, Hasher>::contains(const Key& key) const
+{
+    return !slots_.empty() && used_[locate(key)] != 0;
+}
+
+// Backward shift deletion, so that no tombstones are required.
+template <typename Key, typename Slot, typename Hasher>
+bool flat_table<Key, Slot, Hasher>::erase(const Key& key)
+{
+    if (slots_.empty())
+        return false;
+
+    auto hole = locate(key);
+
+    if (used_[hole] == 0)
+        return false;
+
+    for (auto next = (hole + 1u) & mask_; used_[next] != 0;
+        next = (next + 1u) & mask_)
+    {
+        // An entry whose home lies cyclically in (hole, next] must stay.
+        const auto distance = (next - home(key_of(slots_[next]))) & mask_;
+
+        if (distance < ((next - hole) & mask_))
+            continue;
+
+        slots_[hole] = std::move(slots_[next]);
+        hole = next;
+    }
+
+    slots_[hole] = Slot();
+    used_[hole] = 0;
+    --size_;
+    return true;
+}
+
+template <typename Key, typename Slot, typename Hasher>
+size_t flat_table<Key, Slot, Hasher>::locate(const Key& key) const
+{
+    BITCOIN_ASSERT(!slots_.empty());
+    auto index = home(key);
+
+    // The table is at most half full, so an empty slot is always found.
+    while (used_[index] != 0 && key_of(slots_[index]) != key)
+        index = (index + 1u) & mask_;
+
+    return index;
+}
+
+template <typename Key, typename Slot, typename Hasher>
+size_t flat_table<Key, Slot, Hasher>::prepare(const Key& key)
+{
+    reserve(size_ + 1u);
+    return locate(key);
+}
+
+template <typename Key, typename Slot, typename Hasher>
+Slot& flat_table<Key, Slot, Hasher>::occupy(size_t index, Slot&& slot)
+{
+    BITCOIN_ASSERT(used_[index] == 0);
+    used_[index] = 1;
+    ++size_;
+    return slots_[index] = std::move(slot);
+}
+
+template <typename Key, typename Slot, typename Hasher>
+bool flat_table<Key, Slot, Hasher>::is_used(size_t index) const
+{
+    return used_[index] != 0;
+}
+
+template <typename Key, typename Slot, typename Hasher>
+Slot& flat_table<Key, Slot, Hasher>::slot(size_t index)
+{
+    return slots_[index];
+}
+
+template <typename Key, typename Slot, typename Hasher>
+const Slot& flat_table<Key, Slot, Hasher>::slot(size_t index) const
+{
+    return slots_[index];
+}
+
+template <typename Key, typename Slot, typename Hasher>
+const Key& flat_table<Key, Slot, Hasher>::key_of(const Key& slot)
+{
+    return slot;
+}
+
+template <typename Key, typename Slot, typename Hasher>
+template <typename Value>
+const Key& flat_table<Key, Slot, Hasher>::key_of(
+    const std::pair<Key, Value>& slot)
+{
+    return slot.first;
+}
+
+// A power of two at least twice the number of entries.
+template <typename Key, typename Slot, typename Hasher>
+size_t flat_table<Key, Slot, Hasher>::slot_count(size_t entries)
+{
+    size_t slots = 2;
+
+    while (slots < 2u * entries)
+        slots <<= 1;
+
+    return slots;
+}
+
+template <typename Key, typename Slot, typename Hasher>
+size_t flat_table<Key, Slot, Hasher>::home(const Key& key) const
+{
+    return hasher_(key) & mask_;
+}
+
+template <typename Key, typename Slot, typename Hasher>
+void flat_table<Key, Slot, Hasher>::rehash(size_t slots)
+{
+    std::vector<Slot> previous_slots(slots);
+    std::vector<uint8_t> previous_used(slots, 0);
+    previous_slots.swap(slots_);
+    previous_used.swap(used_);
+    mask_ = slots - 1u;
+
+    for (size_t index = 0; index < previous_slots.size(); ++index)
+    {
+        if (previous_used[index] != 0)
+        {
+            const auto target = locate(key_of(previous_slots[index]));
+            slots_[target] = std::move(previous_slots[index]);
+            used_[target] = 1;
+        }
+    }
+}
+
+// flat_set
+//-----------------------------------------------------------------------------
+
+template <typename Key, typename Hasher>
+flat_set<Key, Hasher>::flat_set(size_t entries, const Hasher& hasher)
+  : flat_table<Key, Key, Hasher>(entries, hasher)
+{
+}
+
+template <typename Key, typename Hasher>
+bool flat_set<Key, Hasher>::insert(const Key& key)
+{
+    const auto index = this->prepare(key);
+
+    if (this->is_used(index))
+        return false;
+
+    this->occupy(index, Key(key));
+    return true;
+}
+
+// flat_map
+//-----------------------------------------------------------------------------
+
+template <typename Key, typename Value, typename Hasher>
+flat_map<Key, Value, Hasher>::flat_map(size_t entries, const Hasher& hasher)
+  : flat_table<Key, std::pair<Key, Value>, Hasher>(entries, hasher)
+{
+}
+
+template <typename Key, typename Value, typename Hasher>
+Value* flat_map<Key, Value, Hasher>::find(const Key& key)
+{
+    if (this->empty())
+        return nullptr;
+
+    const auto index = this->locate(key);
+    return this->is_used(index) ? &this->slot(index).second : nullptr;
+}
+
+template <typename Key, typename Value, typename Hasher>
+const Value* flat_map<Key, Value, Hasher>::find(const Key& key) const
+{
+    if (this->empty())
+        return nullptr;
+
+    const auto index = this->locate(key);
+    return this->is_used(index) ? &this->slot(index).second : nullptr;
+}
+
+template <typename Key, typename Value, typename Hasher>
+std::pair<Value*, bool> flat_map<Key, Value, Hasher>::emplace(const Key& key,
+    const Value& value)
+{
+    const auto index = this->prepare(key);
+
+    if (this->is_used(index))
+        return { &this->slot(index).second, false };
+
+    auto& slot = this->occupy(index, std::make_pair(key, value));
+    return { &slot.second, true };
+}
+
+template <typename Key, typename Value, typename Hasher>
+Value& flat_map<Key, Value, Hasher>::operator[](const Key& key)
+{
+    return *emplace(key, Value()).first;
+}
+
+} // namespace system
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,530 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_UINT256_IPP
+#define LIBBITCOIN_SYSTEM_UINT256_IPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/utility/endian.hpp>
+
+namespace libbitcoin {
+namespace system {
+
+static BC_CONSTEXPR size_t uint256_word_bits = 64;
+static BC_CONSTEXPR size_t uint256_words = 4;
+static BC_CONSTEXPR uint64_t uint256_half_mask = 0xffffffff;
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+BC_CONSTCTOR uint256::uint256()
+  : uint256(0, 0, 0, 0)
+{
+}
+
+BC_CONSTCTOR uint256::uint256(uint64_t value)
+  : uint256(value, 0, 0, 0)
+{
+}
+
+BC_CONSTCTOR uint256::uint256(uint64_t word0, uint64_t word1, uint64_t word2,
+    uint64_t word3)
+  : word0_(word0), word1_(word1), word2_(word2), word3_(word3)
+{
+}
+
+inline uint256::uint256(const hash_digest& hash)
+  : uint256(
+        from_little_endian_unsafe<uint64_t>(hash.begin() + 0),
+        from_little_endian_unsafe<uint64_t>(hash.begin() + 8),
+        from_little_endian_unsafe<uint64_t>(hash.begin() + 16),
+        from_little_endian_unsafe<uint64_t>(hash.begin() + 24))
+{
+}
+
+inline hash_digest uint256::to_hash() const
+{
+    hash_digest out;
+    auto it = out.begin();
+
+    for (size_t index = 0; index < uint256_words; ++index)
+    {
+        const auto bytes = to_little_endian(word(index));
+        it = std::copy(bytes.begin(), bytes.end(), it);
+    }
+
+    return out;
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+BC_CONSTFUNC uint64_t uint256::word(size_t index) const
+{
+    return
+        index == 0 ? word0_ :
+        index == 1 ? word1_ :
+        index == 2 ? word2_ :
+        index == 3 ? word3_ : 0;
+}
+
+BC_CONSTFUNC size_t uint256::bit_length(uint64_t value)
+{
+    return value == 0 ? 0 : 1 + bit_length(value >> 1);
+}
+
+BC_CONSTFUNC size_t uint256::bit_length() const
+{
+    return
+        word3_ != 0 ? 3 * uint256_word_bits + bit_length(word3_) :
+        word2_ != 0 ? 2 * uint256_word_bits + bit_length(word2_) :
+        word1_ != 0 ? 1 * uint256_word_bits + bit_length(word1_) :
+            bit_length(word0_);
+}
+
+BC_CONSTFUNC int uint256::compare(const uint256& other, size_t index) const
+{
+    return
+        word(index) < other.word(index) ? -1 :
+        word(index) > other.word(index) ? 1 :
+        index == 0 ? 0 : compare(other, index - 1);
+}
+
+BC_CONSTFUNC int uint256::compare(const uint256& other) const
+{
+    return compare(other, uint256_words - 1);
+}
+
+BC_CONSTFUNC uint256::operator uint64_t() const
+{
+    return word0_;
+}
+
+inline uint256::operator uint256_t() const
+{
+    return to_uint256(to_hash());
+}
+
+// Bitwise.
+//-----------------------------------------------------------------------------
+
+BC_CONSTFUNC uint256 uint256::operator~() const
+{
+    return uint256(~word0_, ~word1_, ~word2_, ~word3_);
+}
+
+BC_CONSTFUNC uint64_t uint256::shifted_left(size_t index, size_t words,
+    size_t bits) const
+{
+    return index < words ? 0 :
+        (word(index - words) << bits) |
+        (bits == 0 || index == words ? 0 :
+            word(index - words - 1) >> (uint256_word_bits - bits));
+}
+
+BC_CONSTFUNC uint64_t uint256::shifted_right(size_t index, size_t words,
+    size_t bits) const
+{
+    return words >= uint256_words ? 0 :
+        (word(index + words) >> bits) |
+        (bits == 0 ? 0 :
+            word(index + words + 1) << (uint256_word_bits - bits));
+}
+
+BC_CONSTFUNC uint256 uint256::operator<<(size_t shift) const
+{
+    return uint256(
+        shifted_left(0, shift / uint256_word_bits, shift % uint256_word_bits),
+        shifted_left(1, shift / uint256_word_bits, shift % uint256_word_bits),
+        shifted_left(2, shift / uint256_word_bits, shift % uint256_word_bits),
+        shifted_left(3, shift / uint256_word_bits, shift % uint256_word_bits));
+}
+
+BC_CONSTFUNC uint256 uint256::operator>>(size_t shift) const
+{
+    return uint256(
+        shifted_right(0, shift / uint256_word_bits, shift % uint256_word_bits),
+        shifted_right(1, shift / uint256_word_bits, shift % uint256_word_bits),
+        shifted_right(2, shift / uint256_word_bits, shift % uint256_word_bits),
+        shifted_right(3, shift / uint256_word_bits, shift % uint256_word_bits));
+}
+
+// Arithmetic.
+//-----------------------------------------------------------------------------
+
+// One if adding the words and the carry overflows, otherwise zero.
+BC_CONSTFUNC uint64_t uint256::carried(uint64_t left, uint64_t right,
+    uint64_t carry)
+{
+    return (left + right < left) || (left + right + carry < carry) ? 1 : 0;
+}
+
+BC_CONSTFUNC uint64_t uint256::carry(const uint256& other, size_t index) const
+{
+    return index == 0 ? 0 : carried(word(index - 1), other.word(index - 1),
+        carry(other, index - 1));
+}
+
+BC_CONSTFUNC uint64_t uint256::sum(const uint256& other, size_t index) const
+{
+    return word(index) + other.word(index) + carry(other, index);
+}
+
+BC_CONSTFUNC uint256 uint256::operator+(const uint256& other) const
+{
+    return uint256(sum(other, 0), sum(other, 1), sum(other, 2),
+        sum(other, 3));
+}
+
+BC_CONSTFUNC uint256 uint256::operator-(const uint256& other) const
+{
+    // Two's complement negation, modulo 2^256.
+    return *this + ~other + uint256(1);
+}
+
+inline void uint256::to_halves(half_words& out) const
+{
+    for (size_t index = 0; index < uint256_words; ++index)
+    {
+        out[2 * index + 0] = static_cast<uint32_t>(word(index));
+        out[2 * index + 1] = static_cast<uint32_t>(word(index) >> 32);
+    }
+}
+
+inline uint256 uint256::from_halves(const half_words& halves)
+{
+    const auto join = [&](size_t index)
+    {
+        return (uint64_t(halves[2 * index + 1]) << 32) | halves[2 * index];
+    };
+
+    return uint256(join(0), join(1), join(2), join(3));
+}
+
+// The low word of the full product, with the high word set to out.
+inline uint64_t uint256::multiply(uint64_t left, uint64_t right,
+    uint64_t& high)
+{
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 uint128;
+    const auto product = static_cast<uint128>(left) * right;
+    high = static_cast<uint64_t>(product >> uint256_word_bits);
+    return static_cast<uint64_t>(product);
+#else
+    const auto left_low = left & uint256_half_mask;
+    const auto left_high = left >> 32;
+    const auto right_low = right & uint256_half_mask;
+    const auto right_high = right >> 32;
+    const auto low = left_low * right_low;
+    const auto middle = (low >> 32) + (left_high * right_low & uint256_half_mask)
+        + left_low * right_high;
+    high = left_high * right_high + (left_high * right_low >> 32) +
+        (middle >> 32);
+    return (middle << 32) | (low & uint256_half_mask);
+#endif
+}
+
+inline uint256 uint256::operator*(const uint256& other) const
+{
+    uint64_t product[] = { 0, 0, 0, 0 };
+
+    // Schoolbook multiplication of words, truncated to 256 bits.
+    for (size_t i = 0; i < uint256_words; ++i)
+    {
+        const auto left = word(i);
+
+        if (left == 0)
+            continue;
+
+        uint64_t carry = 0;
+
+        for (size_t j = 0; i + j < uint256_words; ++j)
+        {
+            uint64_t high;
+            const auto low = multiply(left, other.word(j), high);
+            auto& target = product[i + j];
+            target += carry;
+            high += target < carry ? 1 : 0;
+            target += low;
+            high += target < low ? 1 : 0;
+            carry = high;
+        }
+    }
+
+    return uint256(product[0], product[1], product[2], product[3]);
+}
+
+inline size_t uint256::significant_halves(const half_words& halves)
+{
+    size_t count = 8;
+
+    while (count > 0 && halves[count - 1] == 0)
+        --count;
+
+    return count;
+}
+
+// Long division in base 2^32 (Knuth, TAOCP vol. 2, 4.3.1, algorithm D).
+inline void uint256::divide(uint256& quotient, uint256& remainder,
+    const uint256& dividend, const uint256& divisor)
+{
+    if (divisor == 0)
+        throw std::overflow_error("uint256 division by zero");
+
+    if (dividend < divisor)
+    {
+        quotient = 0;
+        remainder = dividend;
+        return;
+    }
+
+    half_words numerator, denominator;
+    half_words digits = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    dividend.to_halves(numerator);
+    divisor.to_halves(denominator);
+    const auto m = significant_halves(numerator);
+    const auto n = significant_halves(denominator);
+
+    // Short division by a single digit, such as a retarget interval.
+    if (n == 1)
+    {
+        const uint64_t digit = denominator[0];
+        uint64_t carry = 0;
+
+        for (auto index = m; index > 0; --index)
+        {
+            const auto value = (carry << 32) | numerator[index - 1];
+            digits[index - 1] = static_cast<uint32_t>(value / digit);
+            carry = value % digit;
+        }
+
+        quotient = from_halves(digits);
+        remainder = carry;
+        return;
+    }
+
+    // Normalize so that the high digit of the divisor has its high bit set.
+    const auto shift = 32 - bit_length(denominator[n - 1]);
+    uint32_t u[9];
+    uint32_t v[8];
+
+    for (size_t index = n - 1; index > 0; --index)
+        v[index] = shift == 0 ? denominator[index] :
+            (denominator[index] << shift) |
+            (denominator[index - 1] >> (32 - shift));
+
+    v[0] = denominator[0] << shift;
+    u[m] = shift == 0 ? 0 : numerator[m - 1] >> (32 - shift);
+
+    for (size_t index = m - 1; index > 0; --index)
+        u[index] = shift == 0 ? numerator[index] :
+            (numerator[index] << shift) |
+            (numerator[index - 1] >> (32 - shift));
+
+    u[0] = numerator[0] << shift;
+
+    for (auto j = m - n + 1; j > 0; --j)
+    {
+        const auto at = j - 1;
+
+        // Estimate the quotient digit from the top two digits, then correct.
+        const auto top = (uint64_t(u[at + n]) << 32) | u[at + n - 1];
+        auto estimate = top / v[n - 1];
+        auto rest = top % v[n - 1];
+
+        while (estimate > uint256_half_mask ||
+            estimate * v[n - 2] > ((rest << 32) | u[at + n - 2]))
+        {
+            --estimate;
+            rest += v[n - 1];
+
+            if (rest > uint256_half_mask)
+                break;
+        }
+
+        // Multiply and subtract, tracking the signed borrow.
+        int64_t borrow = 0;
+        int64_t value;
+
+        for (size_t index = 0; index < n; ++index)
+        {
+            const auto product = estimate * v[index];
+            value = int64_t(u[index + at]) - borrow -
+                int64_t(product & uint256_half_mask);
+            u[index + at] = static_cast<uint32_t>(value);
+            borrow = int64_t(product >> 32) - (value >> 32);
+        }
+
+        value = int64_t(u[at + n]) - borrow;
+        u[at + n] = static_cast<uint32_t>(value);
+        digits[at] = static_cast<uint32_t>(estimate);
+
+        // The estimate was one too large, so add the divisor back.
+        if (value < 0)
+        {
+            --digits[at];
+            uint64_t carry = 0;
+
+            for (size_t index = 0; index < n; ++index)
+            {
+                const auto sum = uint64_t(u[index + at]) + v[index] + carry;
+                u[index + at] = static_cast<uint32_t>(sum);
+                carry = sum >> 32;
+            }
+
+            u[at + n] = static_cast<uint32_t>(u[at + n] + carry);
+        }
+    }
+
+    // Denormalize the remainder.
+    half_words rest = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+    for (size_t index = 0; index < n; ++index)
+        rest[index] = shift == 0 ? u[index] :
+            (u[index] >> shift) | (u[index + 1] << (32 - shift));
+
+    quotient = from_halves(digits);
+    remainder = from_halves(rest);
+}
+
+inline uint256 uint256::operator/(const uint256& other) const
+{
+    uint256 quotient, remainder;
+    divide(quotient, remainder, *this, other);
+    return quotient;
+}
+
+inline uint256 uint256::operator%(const uint256& other) const
+{
+    uint256 quotient, remainder;
+    divide(quotient, remainder, *this, other);
+    return remainder;
+}
+
+// Assignment.
+//-----------------------------------------------------------------------------
+
+inline uint256& uint256::operator<<=(size_t shift)
+{
+    return *this = *this << shift;
+}
+
+inline uint256& uint256::operator>>=(size_t shift)
+{
+    return *this = *this >> shift;
+}
+
+inline uint256& uint256::operator+=(const uint256& other)
+{
+    return *this = *this + other;
+}
+
+inline uint256& uint256::operator-=(const uint256& other)
+{
+    return *this = *this - other;
+}
+
+inline uint256& uint256::operator*=(const uint256& other)
+{
+    return *this = *this * other;
+}
+
+inline uint256& uint256::operator/=(const uint256& other)
+{
+    return *this = *this / other;
+}
+
+inline uint256& uint256::operator%=(const uint256& other)
+{
+    return *this = *this % other;
+}
+
+inline uint256& uint256::operator++()
+{
+    return *this += 1;
+}
+
+// Comparison.
+//-----------------------------------------------------------------------------
+
+BC_CONSTFUNC bool operator==(const uint256& left, const uint256& right)
+{
+    return left.compare(right) == 0;
+}
+
+BC_CONSTFUNC bool operator!=(const uint256& left, const uint256& right)
+{
+    return left.compare(right) != 0;
+}
+
+BC_CONSTFUNC bool operator<(const uint256& left, const uint256& right)
+{
+    return left.compare(right) < 0;
+}
+
+BC_CONSTFUNC bool operator<=(const uint256& left, const uint256& right)
+{
+    return left.compare(right) <= 0;
+}
+
+BC_CONSTFUNC bool operator>(const uint256& left, const uint256& right)
+{
+    return left.compare(right) > 0;
+}
+
+BC_CONSTFUNC bool operator>=(const uint256& left, const uint256& right)
+{
+    return left.compare(right) >= 0;
+}
+
+inline std::ostream& operator<<(std::ostream& output, const uint256& value)
+{
+    // Decimal digits are produced in groups of 19, the most that fit a word.
+    static const uint64_t group = 10000000000000000000u;
+
+    if (value == 0)
+        return output << '0';
+
+    std::string digits;
+    auto remaining = value;
+
+    while (remaining != 0)
+    {
+        const auto low = static_cast<uint64_t>(remaining % group);
+        remaining /= group;
+        auto text = std::to_string(low);
+
+        if (remaining != 0)
+            text.insert(0, 19 - text.size(), '0');
+
+        digits.insert(0, text);
+    }
+
+    return output << digits;
+}
+
+} // namespace system
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_CACHED_HASH_IPP
+#define LIBBITCOIN_SYSTEM_CACHED_HASH_IPP
+
+#include <atomic>
+#include <cstdint>
+#include <bitcoin/system/math/hash.hpp>
+
+namespace libbitcoin {
+namespace system {
+
+inline cached_hash::cached_hash()
+  : state_(empty)
+{
+}
+
+inline cached_hash::cached_hash(const cached_hash& other)
+  : state_(empty)
+{
+    hash_digest hash;
+    if (other.get(hash))
+        set(hash);
+}
+
+inline cached_hash& cached_hash::operator=(const cached_hash& other)
+{
+    hash_digest hash;
+    reset();
+
+    if (other.get(hash))
+        set(hash);
+
+    return *this;
+}
+
+inline bool cached_hash::get(hash_digest& out) const
+{
+    // Acquire pairs with the release of publication.
+    if (state_.load(std::memory_order_acquire) != published)
+        return false;
+
+    out = hash_;
+    return true;
+}
+
+template <typename Compute>
+hash_digest cached_hash::get(Compute compute) const
+{
+    hash_digest hash;
+    if (get(hash))
+        return hash;
+
+    hash = compute();
+    set(hash);
+    return hash;
+}
+
+inline void cached_hash::set(const hash_digest& hash) const
+{
+    // Only one writer may claim the empty state, others do not wait.
+    uint8_t expected = empty;
+    if (!state_.compare_exchange_strong(expected, writing,
+        std::memory_order_acquire))
+        return;
+
+    hash_ = hash;
+    state_.store(published, std::memory_order_release);
+}
+
+inline void cached_hash::reset()
+{
+    state_.store(empty, std::memory_order_release);
+}
+
+} // namespace system
+} // namespace libbitcoin
+
+#endif
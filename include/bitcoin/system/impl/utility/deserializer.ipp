@@ -249,20 +249,16 @@ data_chunk deserializer<Iterator, CheckSafe>::read_bytes()
 template <typename Iterator, bool CheckSafe>
 data_chunk deserializer<Iterator, CheckSafe>::read_bytes(size_t size)
 {
-    // TODO: avoid unnecessary default zero fill using
-    // the allocator adapter here: stackoverflow.com/a/21028912/1172329.
-    data_chunk out(size);
-
     if (!safe(size))
         invalidate();
 
-    if (!valid_ || size == 0)
-        return out;
+    if (!valid_)
+        return data_chunk(size);
 
+    // Construct from the range, avoiding a zero fill before the copy.
     const auto begin = iterator_;
     iterator_ += size;
-    std::copy_n(begin, size, out.begin());
-    return out;
+    return data_chunk(begin, iterator_);
 }
 
 template <typename Iterator, bool CheckSafe>
@@ -413,6 +409,11 @@ deserializer<Iterator, false> make_unsafe_deserializer(const Iterator begin)
     return deserializer<Iterator, false>(begin);
 }
 
+inline byte_reader make_byte_reader(const data_slice& data)
+{
+    return byte_reader(data.begin(), data.end());
+}
+
 } // namespace system
 } // namespace libbitcoin
 
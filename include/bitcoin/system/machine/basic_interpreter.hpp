@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_MACHINE_BASIC_INTERPRETER_HPP
+#define LIBBITCOIN_SYSTEM_MACHINE_BASIC_INTERPRETER_HPP
+
+#include <bitcoin/system/define.hpp>
+#include <bitcoin/system/error.hpp>
+#include <bitcoin/system/machine/opcode.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace machine {
+
+/// The operations of interpreter and view_interpreter that do not depend on
+/// the type of stack item, over the program of each (program or view_program).
+template <typename Program>
+class basic_interpreter
+{
+public:
+    typedef error::error_code_t result;
+
+    // Operations (shared).
+    //-------------------------------------------------------------------------
+
+    static result op_nop(opcode);
+    static result op_disabled(opcode);
+    static result op_reserved(opcode);
+
+    // Operations (not shared).
+    //-------------------------------------------------------------------------
+
+    static result op_if(Program& program);
+    static result op_notif(Program& program);
+    static result op_else(Program& program);
+    static result op_endif(Program& program);
+    static result op_verify(Program& program);
+    static result op_return(Program& program);
+    static result op_to_alt_stack(Program& program);
+    static result op_from_alt_stack(Program& program);
+    static result op_drop2(Program& program);
+    static result op_dup2(Program& program);
+    static result op_dup3(Program& program);
+    static result op_over2(Program& program);
+    static result op_rot2(Program& program);
+    static result op_swap2(Program& program);
+    static result op_if_dup(Program& program);
+    static result op_depth(Program& program);
+    static result op_drop(Program& program);
+    static result op_dup(Program& program);
+    static result op_nip(Program& program);
+    static result op_over(Program& program);
+    static result op_pick(Program& program);
+    static result op_roll(Program& program);
+    static result op_rot(Program& program);
+    static result op_swap(Program& program);
+    static result op_tuck(Program& program);
+    static result op_size(Program& program);
+    static result op_equal(Program& program);
+    static result op_equal_verify(Program& program);
+    static result op_add1(Program& program);
+    static result op_sub1(Program& program);
+    static result op_negate(Program& program);
+    static result op_abs(Program& program);
+    static result op_not(Program& program);
+    static result op_nonzero(Program& program);
+    static result op_add(Program& program);
+    static result op_sub(Program& program);
+    static result op_bool_and(Program& program);
+    static result op_bool_or(Program& program);
+    static result op_num_equal(Program& program);
+    static result op_num_equal_verify(Program& program);
+    static result op_num_not_equal(Program& program);
+    static result op_less_than(Program& program);
+    static result op_greater_than(Program& program);
+    static result op_less_than_or_equal(Program& program);
+    static result op_greater_than_or_equal(Program& program);
+    static result op_min(Program& program);
+    static result op_max(Program& program);
+    static result op_within(Program& program);
+    static result op_check_locktime_verify(Program& program);
+    static result op_check_sequence_verify(Program& program);
+};
+
+} // namespace machine
+} // namespace system
+} // namespace libbitcoin
+
+#include <bitcoin/system/impl/machine/basic_interpreter.ipp>
+
+#endif
@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_MACHINE_COMPILED_SCRIPT_HPP
+#define LIBBITCOIN_SYSTEM_MACHINE_COMPILED_SCRIPT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/system/chain/script.hpp>
+#include <bitcoin/system/define.hpp>
+#include <bitcoin/system/error.hpp>
+#include <bitcoin/system/machine/interpreter.hpp>
+#include <bitcoin/system/machine/opcode.hpp>
+#include <bitcoin/system/machine/operation.hpp>
+#include <bitcoin/system/machine/program.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace machine {
+
+/// A script predecoded for threaded execution by interpreter::run(compiled,
+/// program). Each instruction carries its resolved operation handler, its
+/// static (data independent) failure, and for conditionals the jump over the
+/// branch to the next else/endif of the same depth. The script operations are
+/// referenced, so the script must outlive the compiled script, and a program
+/// run with it must be constructed from the same script.
+class BC_API compiled_script
+{
+public:
+    typedef interpreter::result (*handler)(program&, const operation&);
+
+    struct instruction
+    {
+        /// The operation handler, resolved from the opcode.
+        handler run;
+
+        /// The operation within the script.
+        const operation* op;
+
+        /// A push size or disabled opcode failure, success otherwise.
+        error::error_code_t failure;
+
+        /// The operation is conditional (if, notif, else, endif).
+        bool conditional;
+
+        /// Conditionals: the index of the next else/endif of the same depth
+        /// (or the instruction count), the number of counted operations
+        /// before it, and whether none of those has a static failure.
+        uint32_t next;
+        uint32_t skipped;
+        bool jumpable;
+    };
+
+    typedef std::vector<instruction> list;
+
+    /// Decode the operations of the script.
+    compiled_script(const chain::script& script);
+
+    /// Properties.
+    const chain::script& script() const;
+    const list& instructions() const;
+
+private:
+    static handler to_handler(opcode code);
+    void resolve_jumps();
+
+    // Handler adapters for operations not of the handler signature.
+    template <interpreter::result (*Operation)(program&)>
+    static interpreter::result run(program& program, const operation&);
+    template <uint32_t Limit>
+    static interpreter::result push_data(program& program,
+        const operation& op);
+    static interpreter::result push_negative(program& program,
+        const operation& op);
+    static interpreter::result push_positive(program& program,
+        const operation& op);
+    static interpreter::result nop(program& program, const operation& op);
+    static interpreter::result disabled(program& program,
+        const operation& op);
+    static interpreter::result reserved(program& program,
+        const operation& op);
+    static interpreter::result check_sig_verify(program& program,
+        const operation& op);
+    static interpreter::result check_multisig_verify(program& program,
+        const operation& op);
+
+    const chain::script& script_;
+    list instructions_;
+};
+
+} // namespace machine
+} // namespace system
+} // namespace libbitcoin
+
+#endif
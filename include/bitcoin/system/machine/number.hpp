@@ -61,6 +61,9 @@ public:
     static const uint8_t positive_16;
     static const uint8_t negative_sign;
 
+    /// The maximum size of the value as a byte vector.
+    static BC_CONSTEXPR size_t max_data_size = sizeof(int64_t) + 1;
+
     /// Construct with zero value.
     number();
 
@@ -68,7 +71,7 @@ public:
     explicit number(int64_t value);
 
     /// Replace the value derived from a byte vector with LSB first ordering.
-    bool set_data(const data_chunk& data, size_t max_size);
+    bool set_data(const data_slice& data, size_t max_size);
 
     // Properties
     //-------------------------------------------------------------------------
@@ -76,6 +79,13 @@ public:
     /// Return the value as a byte vector with LSB first ordering.
     data_chunk data() const;
 
+    /// Return the size of the value as a byte vector, without encoding it.
+    size_t data_size() const;
+
+    /// Write the value as data() to a buffer of at least max_data_size bytes.
+    /// Return the number of bytes written.
+    size_t to_data(uint8_t* buffer) const;
+
     /// Return the value bounded by the limits of int32.
     int32_t int32() const;
 
@@ -27,6 +27,7 @@
 #include <bitcoin/system/machine/opcode.hpp>
 #include <bitcoin/system/machine/script_pattern.hpp>
 #include <bitcoin/system/utility/data.hpp>
+#include <bitcoin/system/utility/deserializer.hpp>
 #include <bitcoin/system/utility/reader.hpp>
 #include <bitcoin/system/utility/writer.hpp>
 
@@ -72,6 +73,7 @@ public:
     bool from_data(const data_chunk& encoded);
     bool from_data(std::istream& stream);
     bool from_data(reader& source);
+    bool from_data(byte_reader& source);
 
     bool from_string(const std::string& mnemonic);
 
@@ -105,11 +107,11 @@ public:
 
     /// Compute the minimal data opcode for a given chunk of data.
     /// Caller should clear data if converting to non-payload opcode.
-    static opcode minimal_opcode_from_data(const data_chunk& data);
+    static opcode minimal_opcode_from_data(const data_slice& data);
 
     /// Compute the nominal data opcode for a given chunk of data.
     /// Restricted to sized data, avoids conversion to numeric opcodes.
-    static opcode nominal_opcode_from_data(const data_chunk& data);
+    static opcode nominal_opcode_from_data(const data_slice& data);
 
     /// Convert the [1..16] value to the corresponding opcode (or undefined).
     static opcode opcode_from_positive(uint8_t value);
@@ -144,11 +146,15 @@ public:
 protected:
     operation(opcode code, data_chunk&& data, bool valid);
     operation(opcode code, const data_chunk& data, bool valid);
-    static uint32_t read_data_size(opcode code, reader& source);
+    template <typename Source>
+    static uint32_t read_data_size(opcode code, Source& source);
     opcode opcode_from_data(const data_chunk& data, bool minimal);
     void reset();
 
 private:
+    template <typename Source>
+    bool deserialize(Source& source);
+
     opcode code_;
     data_chunk data_;
     bool valid_;
@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_MACHINE_OPERATION_ITERATOR_HPP
+#define LIBBITCOIN_SYSTEM_MACHINE_OPERATION_ITERATOR_HPP
+
+#include <cstdint>
+#include <bitcoin/system/define.hpp>
+#include <bitcoin/system/machine/opcode.hpp>
+#include <bitcoin/system/utility/data.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace machine {
+
+/// Non-allocating iteration over the operations of a serialized script.
+/// Push data is referenced within the script, which must outlive the iterator.
+/// Decoding matches script::operations, where a push that overruns the script
+/// is the last operation, is invalid and has the invalid opcode and no data.
+class BC_API operation_iterator
+{
+public:
+    operation_iterator(const data_slice& script);
+
+    /// Decode the next operation, false if there are no more operations.
+    bool next();
+
+    /// The current operation (undefined until next returns true).
+    opcode code() const;
+    data_slice data() const;
+    bool is_valid() const;
+
+    /// True if the current operation is the last of the script.
+    bool is_last() const;
+
+    /// Categories of the current operation, as machine::operation.
+    bool is_push() const;
+    bool is_version() const;
+    bool is_relaxed_push() const;
+    bool is_minimal_push() const;
+
+private:
+    void invalidate();
+
+    const uint8_t* position_;
+    const uint8_t* const end_;
+    const uint8_t* data_;
+    uint32_t size_;
+    opcode code_;
+    bool valid_;
+};
+
+} // namespace machine
+} // namespace system
+} // namespace libbitcoin
+
+#endif
@@ -28,6 +28,8 @@
 #include <bitcoin/system/machine/opcode.hpp>
 #include <bitcoin/system/machine/operation.hpp>
 #include <bitcoin/system/machine/script_version.hpp>
+#include <bitcoin/system/machine/signature_batch.hpp>
+#include <bitcoin/system/math/elliptic_curve.hpp>
 #include <bitcoin/system/utility/data.hpp>
 
 namespace libbitcoin {
@@ -74,11 +76,24 @@ public:
     /// Utilities.
     bool is_invalid() const;
 
+    /// Defer signature checks to the batch, which must outlive the program.
+    /// A final program result is used only to pass or fail the script, in
+    /// which case a signature check by the last operation is also deferred.
+    void set_batch(signature_batch& batch, bool final_result);
+    bool is_deferred() const;
+    bool is_deferred(const operation& last) const;
+
+    /// Check the signature, or defer the check to the batch if deferrable.
+    bool check_signature(const ec_signature& signature, uint8_t sighash_type,
+        const data_chunk& public_key, const chain::script& script_code,
+        script_version version, bool deferrable);
+
     /// Constant registers.
     uint32_t forks() const;
     uint32_t input_index() const;
     uint64_t value() const;
     script_version version() const;
+    const chain::script& script() const;
     const chain::transaction& transaction() const;
 
     /// Program registers.
@@ -92,6 +107,7 @@ public:
     code evaluate(const operation& op);
     bool increment_operation_count(const operation& op);
     bool increment_operation_count(int32_t public_keys);
+    bool skip_operation_count(size_t counted_operations);
     bool set_jump_register(const operation& op, int32_t offset);
 
     // Primary stack.
@@ -99,6 +115,7 @@ public:
 
     /// Primary push.
     void push(bool value);
+    void push(const number& value);
     void push_move(value_type&& item);
     void push_copy(const value_type& item);
 
@@ -158,6 +175,8 @@ private:
     const uint64_t value_;
     const script_version version_;
 
+    signature_batch* batch_;
+    bool final_;
     size_t negative_count_;
     size_t operation_count_;
     op_iterator jump_;
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_MACHINE_SIGNATURE_BATCH_HPP
+#define LIBBITCOIN_SYSTEM_MACHINE_SIGNATURE_BATCH_HPP
+
+#include <cstddef>
+#include <vector>
+#include <bitcoin/system/define.hpp>
+#include <bitcoin/system/error.hpp>
+#include <bitcoin/system/math/elliptic_curve.hpp>
+#include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/utility/data.hpp>
+#include <bitcoin/system/utility/thread.hpp>
+#include <bitcoin/system/utility/threadpool.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace machine {
+
+/// A collector of deferred signature verifications, such as for a block.
+/// Script evaluation with a batch assumes the success of each signature
+/// check that cannot change the script result other than by failing it,
+/// recording the check here. A script is then valid only if the batch also
+/// verifies. Pushes are thread safe, verification follows all pushes.
+class BC_API signature_batch
+{
+public:
+    signature_batch();
+
+    /// Record a signature check, thread safe.
+    void push(const data_chunk& public_key, const hash_digest& sighash,
+        const ec_signature& signature);
+
+    /// The number of recorded signature checks.
+    size_t size() const;
+
+    /// Clear all recorded signature checks.
+    void clear();
+
+    /// Verify all recorded signature checks on the calling thread.
+    code verify() const;
+
+    /// Verify all recorded signature checks on the pool (and calling thread).
+    code verify(threadpool& pool) const;
+
+    /// Cache all recorded signature checks, once verified and accepted.
+    void store() const;
+
+private:
+    struct check
+    {
+        data_chunk public_key;
+        hash_digest sighash;
+        ec_signature signature;
+    };
+
+    static bool verify(const check& check);
+
+    std::vector<check> checks_;
+    mutable shared_mutex mutex_;
+};
+
+} // namespace machine
+} // namespace system
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_MACHINE_STACK_ITEM_HPP
+#define LIBBITCOIN_SYSTEM_MACHINE_STACK_ITEM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/system/define.hpp>
+#include <bitcoin/system/machine/number.hpp>
+#include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/utility/data.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace machine {
+
+/// A script stack item that does not allocate. This is either a view of
+/// script or witness bytes, which must outlive the item, or a value computed
+/// by the interpreter, which is held in place (hashes, numbers and booleans).
+/// A number is held as its value and is encoded only when its bytes are
+/// observed, so numeric operations on numeric results do not encode.
+class BC_API stack_item
+{
+public:
+    /// The maximum size of a held value.
+    static BC_CONSTEXPR size_t capacity = hash_size;
+
+    /// An empty (false) item.
+    stack_item();
+
+    /// A view of the data, which must outlive the item.
+    explicit stack_item(const data_slice& view);
+
+    /// A copy of the value.
+    template <size_t Size>
+    explicit stack_item(const byte_array<Size>& value);
+
+    /// The number, encoded as its data when observed.
+    explicit stack_item(const number& value);
+
+    /// The true (one) or false (empty) item.
+    static stack_item from_bool(bool value);
+
+    /// Properties.
+    const uint8_t* data() const;
+    const uint8_t* begin() const;
+    const uint8_t* end() const;
+    size_t size() const;
+    bool empty() const;
+
+    /// Utilities.
+    bool is_true() const;
+    bool to_number(number& out_number, size_t maximum_size) const;
+    data_chunk to_chunk() const;
+    bool operator==(const stack_item& other) const;
+    bool operator!=(const stack_item& other) const;
+
+private:
+    void encode() const;
+
+    const uint8_t* view_;
+    int64_t number_;
+    bool numeric_;
+    mutable bool encoded_;
+    mutable uint32_t size_;
+    mutable uint8_t value_[capacity];
+};
+
+} // namespace machine
+} // namespace system
+} // namespace libbitcoin
+
+#include <bitcoin/system/impl/machine/stack_item.ipp>
+
+#endif
@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_MACHINE_VIEW_INTERPRETER_HPP
+#define LIBBITCOIN_SYSTEM_MACHINE_VIEW_INTERPRETER_HPP
+
+#include <cstdint>
+#include <bitcoin/system/chain/script.hpp>
+#include <bitcoin/system/define.hpp>
+#include <bitcoin/system/error.hpp>
+#include <bitcoin/system/machine/basic_interpreter.hpp>
+#include <bitcoin/system/machine/opcode.hpp>
+#include <bitcoin/system/machine/operation_iterator.hpp>
+#include <bitcoin/system/machine/stack_item.hpp>
+#include <bitcoin/system/machine/view_program.hpp>
+#include <bitcoin/system/utility/data.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace machine {
+
+/// A script interpreter that evaluates the serialized script over a stack of
+/// views, with the results of interpreter::run. Pushes and stack operations
+/// do not allocate. Scripts with code separators or multisig operations are
+/// not supported, and must be evaluated by interpreter::run. Operations that
+/// do not depend on the stack item type are shared with interpreter.
+class BC_API view_interpreter
+  : public basic_interpreter<view_program>
+{
+public:
+    // Operations (shared).
+    //-------------------------------------------------------------------------
+
+    static result op_push_number(view_program& program, uint8_t value);
+    static result op_push_size(view_program& program, const data_slice& data);
+    static result op_push_data(view_program& program, const data_slice& data,
+        uint32_t size_limit);
+
+    // Operations (not shared).
+    //-------------------------------------------------------------------------
+
+    static result op_ripemd160(view_program& program);
+    static result op_sha1(view_program& program);
+    static result op_sha256(view_program& program);
+    static result op_hash160(view_program& program);
+    static result op_hash256(view_program& program);
+    static result op_check_sig_verify(view_program& program,
+        bool deferrable=true);
+    static result op_check_sig(view_program& program, bool last);
+
+    /// True if all operations of the serialized script are supported.
+    static bool is_supported(const data_slice& script);
+
+    /// Run program script, which must be supported.
+    static code run(view_program& program);
+
+private:
+    static result run_op(const operation_iterator& op, view_program& program);
+};
+
+} // namespace machine
+} // namespace system
+} // namespace libbitcoin
+
+#include <bitcoin/system/impl/machine/view_interpreter.ipp>
+
+#endif
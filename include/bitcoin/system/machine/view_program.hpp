@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_MACHINE_VIEW_PROGRAM_HPP
+#define LIBBITCOIN_SYSTEM_MACHINE_VIEW_PROGRAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/system/chain/script.hpp>
+#include <bitcoin/system/chain/transaction.hpp>
+#include <bitcoin/system/constants.hpp>
+#include <bitcoin/system/define.hpp>
+#include <bitcoin/system/machine/number.hpp>
+#include <bitcoin/system/machine/opcode.hpp>
+#include <bitcoin/system/machine/script_version.hpp>
+#include <bitcoin/system/machine/signature_batch.hpp>
+#include <bitcoin/system/machine/stack_item.hpp>
+#include <bitcoin/system/math/elliptic_curve.hpp>
+#include <bitcoin/system/utility/data.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace machine {
+
+/// The state of a script evaluated by view_interpreter, as machine::program.
+/// Stack items are views into the script and initial stack bytes, so the
+/// script, transaction and initial stack must outlive the program.
+class BC_API view_program
+{
+public:
+    typedef stack_item value_type;
+    typedef std::vector<stack_item> stack;
+    typedef stack::iterator stack_iterator;
+
+    /// Create an instance with empty stacks, value unused/max (input run).
+    view_program(const chain::script& script,
+        const chain::transaction& transaction, uint32_t input_index,
+        uint32_t forks);
+
+    /// Create an instance with a stack of views (witness run, v0 by default).
+    view_program(const chain::script& script,
+        const chain::transaction& transaction, uint32_t input_index,
+        uint32_t forks, const data_stack& stack, uint64_t value,
+        script_version version=script_version::zero);
+
+    /// Create using copied tx, input, forks, value, stack (prevout run).
+    view_program(const chain::script& script, const view_program& other);
+
+    /// Utilities.
+    bool is_invalid() const;
+
+    /// Defer signature checks to the batch, which must outlive the program.
+    void set_batch(signature_batch& batch, bool final_result);
+    bool is_deferred() const;
+    bool is_deferred(bool last) const;
+
+    /// Check the signature, or defer the check to the batch if deferrable.
+    bool check_signature(const ec_signature& signature, uint8_t sighash_type,
+        const stack_item& public_key, const chain::script& script_code,
+        script_version version, bool deferrable);
+
+    /// Constant registers.
+    uint32_t forks() const;
+    uint32_t input_index() const;
+    uint64_t value() const;
+    script_version version() const;
+    const chain::script& script() const;
+    const chain::transaction& transaction() const;
+
+    /// Instructions.
+    code evaluate();
+    bool increment_operation_count(opcode code);
+    bool increment_operation_count(int32_t public_keys);
+
+    // Primary stack.
+    //-------------------------------------------------------------------------
+
+    /// Primary push.
+    void push(bool value);
+    void push(const number& value);
+    void push_move(stack_item&& item);
+    void push_copy(const stack_item& item);
+
+    /// Primary pop.
+    stack_item pop();
+    bool pop(int32_t& out_value);
+    bool pop(number& out_number, size_t maxiumum_size=max_number_size);
+    bool pop_binary(number& first, number& second);
+    bool pop_ternary(number& first, number& second, number& third);
+    bool pop_position(stack_iterator& out_position);
+
+    /// Primary push/pop optimizations (active).
+    void duplicate(size_t index);
+    void swap(size_t index_left, size_t index_right);
+    void erase(const stack_iterator& position);
+    void erase(const stack_iterator& first, const stack_iterator& last);
+
+    /// Primary push/pop optimizations (passive).
+    bool empty() const;
+    bool stack_true(bool clean) const;
+    bool stack_result(bool clean) const;
+    bool is_stack_overflow() const;
+    bool if_(opcode code) const;
+    const stack_item& item(size_t index) const;
+    bool top(number& out_number, size_t maxiumum_size=max_number_size) const;
+    stack_iterator position(size_t index);
+    size_t size() const;
+
+    // Alternate stack.
+    //-------------------------------------------------------------------------
+
+    bool empty_alternate() const;
+    void push_alternate(const stack_item& value);
+    stack_item pop_alternate();
+
+    // Conditional stack.
+    //-------------------------------------------------------------------------
+
+    void open(bool value);
+    void negate();
+    void close();
+    bool closed() const;
+    bool succeeded() const;
+
+private:
+    // A space-efficient dynamic bitset (specialized).
+    typedef std::vector<bool> bool_stack;
+
+    bool stack_to_bool(bool clean) const;
+
+    const chain::script& script_;
+    const chain::transaction& transaction_;
+    const uint32_t input_index_;
+    const uint32_t forks_;
+    const uint64_t value_;
+    const script_version version_;
+
+    signature_batch* batch_;
+    bool final_;
+    size_t negative_count_;
+    size_t operation_count_;
+    stack primary_;
+    stack alternate_;
+    bool_stack condition_;
+};
+
+} // namespace machine
+} // namespace system
+} // namespace libbitcoin
+
+#include <bitcoin/system/impl/machine/view_program.ipp>
+
+#endif
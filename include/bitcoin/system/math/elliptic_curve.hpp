@@ -23,6 +23,7 @@
 #include <bitcoin/system/compat.hpp>
 #include <bitcoin/system/define.hpp>
 #include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/math/signature_cache.hpp>
 #include <bitcoin/system/utility/data.hpp>
 
 namespace libbitcoin {
@@ -166,7 +167,7 @@ BC_API bool parse_endorsement(uint8_t& sighash_type,
 /// Parse a DER encoded signature with optional strict DER enforcement.
 /// Treat an empty DER signature as invalid, in accordance with BIP66.
 BC_API bool parse_signature(ec_signature& out,
-    const der_signature& der_signature, bool strict);
+    const data_slice& der_signature, bool strict);
 
 /// Encode an EC signature as DER (strict).
 BC_API bool encode_signature(der_signature& out, const ec_signature& signature);
@@ -187,9 +188,21 @@ BC_API bool verify_signature(const ec_uncompressed& point,
     const hash_digest& hash, const ec_signature& signature);
 
 /// Verify an EC signature using a potential point.
+/// This consults the signature verification cache and populates it on success.
 BC_API bool verify_signature(const data_slice& point, const hash_digest& hash,
     const ec_signature& signature);
 
+/// Verify an EC signature using a potential point.
+/// This neither consults nor populates the signature verification cache.
+BC_API bool verify_signature_uncached(const data_slice& point,
+    const hash_digest& hash, const ec_signature& signature);
+
+/// The cache of successful verify_signature(point, hash, signature) results,
+/// such as of pool acceptance, and of the batched signature checks of blocks
+/// accepted by block::connect (see signature_batch::store).
+/// This is disabled (zero capacity) until its capacity is set.
+BC_API signature_cache& signature_verification_cache();
+
 // Recoverable sign/recover
 // ----------------------------------------------------------------------------
 
@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_FLAT_HASH_HPP
+#define LIBBITCOIN_SYSTEM_FLAT_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <bitcoin/system/define.hpp>
+#include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/utility/data.hpp>
+
+namespace libbitcoin {
+namespace system {
+
+/// Mixes 64 bits of an already uniformly distributed key with a salt.
+/// The salt is random by default and precedes a nonlinear finalizer, so
+/// table slot collisions depend on the salt and cannot be precomputed.
+class BC_API salted_hash
+{
+public:
+    salted_hash();
+    explicit salted_hash(uint64_t salt);
+
+protected:
+    size_t mix(uint64_t value) const;
+
+private:
+    uint64_t salt_;
+};
+
+/// Table hasher for digest keys, which takes 8 bytes of the key instead of
+/// hashing every byte, as std::hash and boost::hash of byte_array do.
+/// Keys must be hashes of content (such as txids), not chosen values.
+template <typename Key>
+struct digest_hasher;
+
+template <size_t Size>
+struct digest_hasher<byte_array<Size>>
+  : public salted_hash
+{
+    static_assert(Size >= sizeof(uint64_t), "key is too short");
+
+    digest_hasher() {}
+    explicit digest_hasher(uint64_t salt) : salted_hash(salt) {}
+
+    size_t operator()(const byte_array<Size>& key) const;
+};
+
+/// Open addressing (linear probe) table of slots, at most half full.
+/// Storage is reserved up front and retained by clear, so a table that is
+/// reused or reserved to its final size does not reallocate or rehash.
+template <typename Key, typename Slot, typename Hasher>
+class flat_table
+{
+public:
+    /// Number of entries that can be held without growth.
+    size_t capacity() const;
+    size_t size() const;
+    bool empty() const;
+
+    /// Reserve storage for at least the given number of entries.
+    void reserve(size_t entries);
+
+    /// Remove all entries, retaining storage.
+    void clear();
+
+    bool contains(const Key& key) const;
+
+    /// Remove the key, returning false if it was not present.
+    bool erase(const Key& key);
+
+protected:
+    flat_table(size_t entries, const Hasher& hasher);
+
+    // The slot of the key, or the empty slot at which to insert it.
+    size_t locate(const Key& key) const;
+
+    // Make room for one more entry, returning the slot of the key.
+    size_t prepare(const Key& key);
+
+    // Occupy the empty slot (from prepare).
+    Slot& occupy(size_t index, Slot&& slot);
+
+    bool is_used(size_t index) const;
+    Slot& slot(size_t index);
+    const Slot& slot(size_t index) const;
+
+private:
+    static const Key& key_of(const Key& slot);
+    template <typename Value>
+    static const Key& key_of(const std::pair<Key, Value>& slot);
+    static size_t slot_count(size_t entries);
+
+    size_t home(const Key& key) const;
+    void rehash(size_t slots);
+
+    std::vector<Slot> slots_;
+    std::vector<uint8_t> used_;
+    size_t size_;
+    size_t mask_;
+    Hasher hasher_;
+};
+
+/// A set of digest keys, not thread safe.
+template <typename Key, typename Hasher=digest_hasher<Key>>
+class flat_set
+  : public flat_table<Key, Key, Hasher>
+{
+public:
+    flat_set(size_t entries=0, const Hasher& hasher=Hasher());
+
+    /// Add the key, returning false if it was already present.
+    bool insert(const Key& key);
+};
+
+/// A map of digest keys to values, not thread safe.
+template <typename Key, typename Value, typename Hasher=digest_hasher<Key>>
+class flat_map
+  : public flat_table<Key, std::pair<Key, Value>, Hasher>
+{
+public:
+    flat_map(size_t entries=0, const Hasher& hasher=Hasher());
+
+    /// The value of the key, or nullptr if not present.
+    Value* find(const Key& key);
+    const Value* find(const Key& key) const;
+
+    /// Add the key and value if the key is not present, returning the value
+    /// of the key and true if it was added.
+    std::pair<Value*, bool> emplace(const Key& key, const Value& value);
+
+    /// The value of the key, added as default if not present.
+    Value& operator[](const Key& key);
+};
+
+typedef flat_set<hash_digest> hash_digest_set;
+typedef flat_set<short_hash> short_hash_set;
+
+/// Remove duplicates in place, retaining the first of each (not sorted).
+/// Hashes may be chosen, as they are keyed by siphash with a random key.
+BC_API hash_list& distinct_unsorted(hash_list& list);
+
+} // namespace system
+} // namespace libbitcoin
+
+#include <bitcoin/system/impl/math/flat_hash.ipp>
+
+#endif
@@ -108,11 +108,47 @@ BC_CONSTEXPR mini_hash null_mini_hash
     }
 };
 
+/// SHA256 compression function implementations.
+enum class sha256_backend
+{
+    scalar,
+    sse41,
+    avx2,
+    avx512,
+    shani
+};
+
 inline uint256_t to_uint256(const hash_digest& hash)
 {
     return from_little_endian<uint256_t>(hash.begin(), hash.end());
 }
 
+/// Incremental sha256 hashing, copyable so as to retain a midstate.
+/// This is not zeroized and is intended for public data only.
+class BC_API sha256_context
+{
+public:
+    sha256_context();
+
+    /// Append data to the hashed message.
+    void write(const data_slice& data);
+    void write(const uint8_t* data, size_t size);
+
+    /// The number of bytes written.
+    uint64_t size() const;
+
+    /// The sha256 hash of the bytes written (does not modify the context).
+    hash_digest single_hash() const;
+
+    /// The bitcoin hash of the bytes written (does not modify the context).
+    hash_digest double_hash() const;
+
+private:
+    uint32_t state_[8];
+    uint64_t size_;
+    uint8_t buffer_[64];
+};
+
 /// Generate a scrypt hash to fill a byte array.
 template <size_t Size>
 byte_array<Size> scrypt(const data_slice& data, const data_slice& salt,
@@ -125,6 +161,19 @@ BC_API data_chunk scrypt(const data_slice& data, const data_slice& salt,
 /// Generate a bitcoin hash.
 BC_API hash_digest bitcoin_hash(const data_slice& data);
 
+/// Generate a bitcoin hash of each 64 byte block, such as merkle tree nodes.
+/// Blocks are hashed in parallel (4, 8 or 16 lanes) as the backend allows.
+/// The data size should be a multiple of 64 bytes, a remainder is ignored.
+BC_API hash_list bitcoin_hash_batch(const data_slice& blocks);
+
+/// Generate a bitcoin hash of a 64 byte message, such as a merkle node pair.
+/// The padding is constant and precomputed, this is faster than bitcoin_hash.
+BC_API hash_digest double_sha256_64(const long_hash& data);
+
+/// Generate a bitcoin hash of an 80 byte message, such as a block header.
+/// The padding is constant and precomputed, this is faster than bitcoin_hash.
+BC_API hash_digest double_sha256_80(const byte_array<80>& data);
+
 /// Generate a scrypt hash.
 BC_API hash_digest scrypt_hash(const data_slice& data);
 
@@ -143,11 +192,27 @@ BC_API data_chunk sha1_hash_chunk(const data_slice& data);
 BC_API hash_digest sha256_hash(const data_slice& data);
 BC_API data_chunk sha256_hash_chunk(const data_slice& data);
 
+/// Generate a sha256 hash of each 32 byte digest, such as a first round.
+/// Digests are hashed in parallel (4, 8 or 16 lanes) as the backend allows.
+/// The data size should be a multiple of 32 bytes, a remainder is ignored.
+BC_API hash_list sha256_hash_batch(const data_slice& digests);
+
 /// Generate a sha256 hash.
 /// This hash function is used in electrum seed stretching.
 BC_API hash_digest sha256_hash(const data_slice& first,
     const data_slice& second);
 
+/// Determine if the sha256 backend is supported by the current processor.
+BC_API bool sha256_available(sha256_backend backend);
+
+/// Get the sha256 backend in use, initially the fastest available.
+BC_API sha256_backend sha256_selected();
+
+/// Set the sha256 backend used by all sha256-based hashing.
+/// Returns false (and has no effect) if the backend is not available.
+/// This is thread safe, but it is intended for test and benchmarking.
+BC_API bool sha256_select(sha256_backend backend);
+
 // Generate a hmac sha256 hash.
 BC_API hash_digest hmac_sha256_hash(const data_slice& data,
     const data_slice& key);
@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_SIGNATURE_CACHE_HPP
+#define LIBBITCOIN_SYSTEM_SIGNATURE_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+#include <bitcoin/system/define.hpp>
+#include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/utility/data.hpp>
+#include <bitcoin/system/utility/thread.hpp>
+
+namespace libbitcoin {
+namespace system {
+
+/// A bounded set of successful signature verifications, thread safe.
+/// Entries are salted hashes of the public key, signature hash and signature,
+/// so collisions cannot be precomputed. The oldest entry is evicted when full.
+/// Zero capacity disables the cache.
+class BC_API signature_cache
+{
+public:
+    signature_cache(size_t capacity);
+
+    /// Determine if the verification is cached, counting the hit or miss.
+    bool contains(const data_slice& point, const hash_digest& hash,
+        const data_slice& signature) const;
+
+    /// Cache a successful verification.
+    void store(const data_slice& point, const hash_digest& hash,
+        const data_slice& signature);
+
+    /// Change the capacity, clearing the cache.
+    void set_capacity(size_t capacity);
+
+    /// Remove all entries (counters are not reset).
+    void clear();
+
+    size_t size() const;
+    size_t capacity() const;
+    uint64_t hits() const;
+    uint64_t misses() const;
+
+private:
+    // The key is a salted hash, so its leading bytes are a sufficient hash.
+    struct key_hasher
+    {
+        size_t operator()(const hash_digest& key) const;
+    };
+
+    typedef std::unordered_set<hash_digest, key_hasher> key_set;
+
+    hash_digest to_key(const data_slice& point, const hash_digest& hash,
+        const data_slice& signature) const;
+
+    // This is the midstate of the salt, which is not exposed.
+    sha256_context salted_;
+
+    // These are protected by mutex.
+    size_t capacity_;
+    size_t next_;
+    key_set keys_;
+    std::vector<hash_digest> order_;
+    mutable shared_mutex mutex_;
+
+    mutable std::atomic<uint64_t> hits_;
+    mutable std::atomic<uint64_t> misses_;
+};
+
+} // namespace system
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_UINT256_HPP
+#define LIBBITCOIN_SYSTEM_UINT256_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <bitcoin/system/compat.hpp>
+#include <bitcoin/system/define.hpp>
+#include <bitcoin/system/math/hash.hpp>
+
+namespace libbitcoin {
+namespace system {
+
+/// An unsigned 256 bit number of four 64 bit words, with modular arithmetic.
+/// This is a fixed width replacement for uint256_t in proof of work math.
+/// Construction, comparison, shifts, addition and subtraction are constexpr.
+class uint256
+{
+public:
+    /// Construct zero.
+    BC_CONSTCTOR uint256();
+
+    /// Construct from a 64 bit value (implicit, as with integral types).
+    BC_CONSTCTOR uint256(uint64_t value);
+
+    /// Construct from words, least significant first.
+    BC_CONSTCTOR uint256(uint64_t word0, uint64_t word1, uint64_t word2,
+        uint64_t word3);
+
+    /// Construct from a little-endian hash, as with to_uint256.
+    explicit uint256(const hash_digest& hash);
+
+    /// The little-endian hash of the value.
+    hash_digest to_hash() const;
+
+    /// The word at index, least significant first, zero if out of range.
+    BC_CONSTFUNC uint64_t word(size_t index) const;
+
+    /// The number of significant bits, zero for zero.
+    BC_CONSTFUNC size_t bit_length() const;
+
+    /// -1, 0 or 1 as this value is less than, equal to or above other.
+    BC_CONSTFUNC int compare(const uint256& other) const;
+
+    /// The least significant 64 bits.
+    BC_CONSTFUNC explicit operator uint64_t() const;
+
+    /// The same value as uint256_t, for callers of the big number type.
+    operator uint256_t() const;
+
+    BC_CONSTFUNC uint256 operator~() const;
+    BC_CONSTFUNC uint256 operator<<(size_t shift) const;
+    BC_CONSTFUNC uint256 operator>>(size_t shift) const;
+    BC_CONSTFUNC uint256 operator+(const uint256& other) const;
+    BC_CONSTFUNC uint256 operator-(const uint256& other) const;
+    uint256 operator*(const uint256& other) const;
+
+    /// Division by zero throws std::overflow_error, as does uint256_t.
+    uint256 operator/(const uint256& other) const;
+    uint256 operator%(const uint256& other) const;
+
+    uint256& operator<<=(size_t shift);
+    uint256& operator>>=(size_t shift);
+    uint256& operator+=(const uint256& other);
+    uint256& operator-=(const uint256& other);
+    uint256& operator*=(const uint256& other);
+    uint256& operator/=(const uint256& other);
+    uint256& operator%=(const uint256& other);
+    uint256& operator++();
+
+private:
+    typedef uint32_t half_words[8];
+
+    BC_CONSTFUNC int compare(const uint256& other, size_t index) const;
+    BC_CONSTFUNC uint64_t shifted_left(size_t index, size_t words,
+        size_t bits) const;
+    BC_CONSTFUNC uint64_t shifted_right(size_t index, size_t words,
+        size_t bits) const;
+    BC_CONSTFUNC uint64_t carry(const uint256& other, size_t index) const;
+    BC_CONSTFUNC uint64_t sum(const uint256& other, size_t index) const;
+
+    static BC_CONSTFUNC size_t bit_length(uint64_t value);
+    static BC_CONSTFUNC uint64_t carried(uint64_t left, uint64_t right,
+        uint64_t carry);
+
+    static uint64_t multiply(uint64_t left, uint64_t right, uint64_t& high);
+    static size_t significant_halves(const half_words& halves);
+    void to_halves(half_words& out) const;
+    static uint256 from_halves(const half_words& halves);
+    static void divide(uint256& quotient, uint256& remainder,
+        const uint256& dividend, const uint256& divisor);
+
+    uint64_t word0_;
+    uint64_t word1_;
+    uint64_t word2_;
+    uint64_t word3_;
+};
+
+BC_CONSTFUNC bool operator==(const uint256& left, const uint256& right);
+BC_CONSTFUNC bool operator!=(const uint256& left, const uint256& right);
+BC_CONSTFUNC bool operator<(const uint256& left, const uint256& right);
+BC_CONSTFUNC bool operator<=(const uint256& left, const uint256& right);
+BC_CONSTFUNC bool operator>(const uint256& left, const uint256& right);
+BC_CONSTFUNC bool operator>=(const uint256& left, const uint256& right);
+
+/// Write the value in decimal.
+std::ostream& operator<<(std::ostream& output, const uint256& value);
+
+} // namespace system
+} // namespace libbitcoin
+
+#include <bitcoin/system/impl/math/uint256.ipp>
+
+#endif
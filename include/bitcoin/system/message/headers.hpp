@@ -24,13 +24,17 @@
 #include <istream>
 #include <memory>
 #include <string>
+#include <vector>
+#include <bitcoin/system/chain/median_time_window.hpp>
 #include <bitcoin/system/define.hpp>
+#include <bitcoin/system/error.hpp>
 #include <bitcoin/system/math/hash.hpp>
 #include <bitcoin/system/message/header.hpp>
 #include <bitcoin/system/message/inventory.hpp>
 #include <bitcoin/system/message/inventory_vector.hpp>
 #include <bitcoin/system/utility/data.hpp>
 #include <bitcoin/system/utility/reader.hpp>
+#include <bitcoin/system/utility/threadpool.hpp>
 #include <bitcoin/system/utility/writer.hpp>
 
 namespace libbitcoin {
@@ -60,6 +64,21 @@ public:
     void set_elements(header::list&& values);
 
     bool is_sequential() const;
+
+    /// Check the linkage of each header to its predecessor in the list, and
+    /// its proof of work and timestamp (as header::check). Headers are hashed
+    /// and checked in parallel on the pool (and the calling thread). The
+    /// result is the first error in order, as if checked sequentially.
+    code check(threadpool& pool, uint32_t timestamp_limit_seconds,
+        uint32_t proof_of_work_limit, bool scrypt=false) const;
+
+    /// Compute the median time past of each header in one pass, sliding the
+    /// window from the timestamps preceding the first header (see
+    /// chain_state::child_median_window). The result is timestamp_too_early
+    /// for the first header not later than its median time past, and out
+    /// holds the medians of the headers that precede it.
+    code accept_timestamps(chain::median_time_window window,
+        std::vector<uint32_t>& out) const;
     void to_hashes(hash_list& out) const;
     void to_inventory(inventory_vector::list& out,
         inventory::type_id type) const;
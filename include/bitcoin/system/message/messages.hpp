@@ -60,8 +60,12 @@
 #include <bitcoin/system/message/transaction.hpp>
 #include <bitcoin/system/message/verack.hpp>
 #include <bitcoin/system/message/version.hpp>
-#include <bitcoin/system/utility/container_sink.hpp>
+#include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/utility/assert.hpp>
 #include <bitcoin/system/utility/data.hpp>
+#include <bitcoin/system/utility/endian.hpp>
+#include <bitcoin/system/utility/serializer.hpp>
+#include <bitcoin/system/utility/sha256_buffer_writer.hpp>
 
 // Minimum current libbitcoin protocol version:     31402
 // Minimum current satoshi client protocol version: 31800
@@ -167,43 +171,40 @@ DECLARE_MESSAGE_POINTER_LIST_POINTER_TYPES(transaction);
 
 namespace message {
 
-/// Serialize a message object to the Bitcoin wire protocol encoding.
+/// Serialize a message object to the Bitcoin wire protocol encoding, into
+/// the buffer, which is resized to the message (retaining its capacity).
+/// The payload is written in place and hashed as it is written, and the
+/// heading is then written in place before it, so the payload is not copied.
 template <typename Message>
-data_chunk serialize(uint32_t version, const Message& packet,
+void serialize(data_chunk& out, uint32_t version, const Message& packet,
     uint32_t magic)
 {
     const auto heading_size = heading::satoshi_fixed_size();
     const auto payload_size = packet.serialized_size(version);
-    const auto message_size = heading_size + payload_size;
-
-    // Unfortunately data_sink doesn't support seek, so this is a little ugly.
-    // The header requires payload size and checksum but prepends the payload.
-    // Use a stream to prevent unnecessary copying of the payload.
-    data_chunk data;
+    out.resize(heading_size + payload_size);
 
-    // Reserve memory for the full message.
-    data.reserve(message_size);
+    sha256_context context;
+    sha256_buffer_writer payload(out.data() + heading_size, payload_size,
+        context);
+    packet.to_data(version, payload);
+    payload.flush();
+    BITCOIN_ASSERT(payload && payload.size() == payload_size);
 
-    // Size the vector for the heading so that payload insertion will follow.
-    data.resize(heading_size);
-
-    // Insert the payload after the heading and into the reservation.
-    data_sink ostream(data);
-    packet.to_data(version, ostream);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == message_size);
-
-    // Create the payload checksum without copying the buffer.
-    const data_slice slice(data.data() + heading_size, data.data() + message_size);
-    const auto check = bitcoin_checksum(slice);
+    const auto check = from_little_endian_unsafe<uint32_t>(
+        context.double_hash().begin());
     const auto payload_size32 = safe_unsigned<uint32_t>(payload_size);
 
-    // Create and serialize the heading to a temporary variable (12 bytes).
-    heading head(magic, Message::command, payload_size32, check);
-    auto heading = head.to_data();
+    auto sink = make_unsafe_serializer(out.begin());
+    heading(magic, Message::command, payload_size32, check).to_data(sink);
+}
 
-    // Move the heading into the allocated beginning of the message buffer.
-    std::move(heading.begin(), heading.end(), data.begin());
+/// Serialize a message object to the Bitcoin wire protocol encoding.
+template <typename Message>
+data_chunk serialize(uint32_t version, const Message& packet,
+    uint32_t magic)
+{
+    data_chunk data;
+    serialize(data, version, packet, magic);
     return data;
 }
 
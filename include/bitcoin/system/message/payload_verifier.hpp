@@ -0,0 +1,68 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_MESSAGE_PAYLOAD_VERIFIER_HPP
+#define LIBBITCOIN_SYSTEM_MESSAGE_PAYLOAD_VERIFIER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/system/define.hpp>
+#include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/message/heading.hpp>
+#include <bitcoin/system/utility/data.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace message {
+
+/// Verify an inbound payload against its heading as the payload is received,
+/// so that the payload is hashed in the chunks read, without a second pass.
+class BC_API payload_verifier
+{
+public:
+    /// The heading payload size is limited to maximum_payload_size, see
+    /// heading::maximum_payload_size.
+    payload_verifier(const heading& head, size_t maximum_payload_size);
+
+    /// False if the heading payload size exceeds the maximum.
+    bool is_valid_size() const;
+
+    /// The number of payload bytes not yet received.
+    size_t remaining() const;
+
+    /// Hash the next chunk of the payload.
+    /// False if the size is invalid or the chunk overruns the payload.
+    bool write(const data_slice& chunk);
+    bool write(const uint8_t* data, size_t size);
+
+    /// True if the payload is complete and matches the heading checksum.
+    bool is_valid() const;
+
+private:
+    const uint32_t checksum_;
+    const size_t payload_size_;
+    const bool valid_size_;
+    bool overrun_;
+    sha256_context context_;
+};
+
+} // namespace message
+} // namespace system
+} // namespace libbitcoin
+
+#endif
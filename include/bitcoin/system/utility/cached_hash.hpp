@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_CACHED_HASH_HPP
+#define LIBBITCOIN_SYSTEM_CACHED_HASH_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <bitcoin/system/math/hash.hpp>
+
+namespace libbitcoin {
+namespace system {
+
+/// A lazily computed hash, stored inline and published once without locks.
+/// Reading a published hash is an acquire load and a copy. Computations may
+/// race, in which case the first published is retained (all are equal).
+/// Copy, assignment and reset are not thread safe, as with other members.
+class cached_hash
+{
+public:
+    cached_hash();
+    cached_hash(const cached_hash& other);
+    cached_hash& operator=(const cached_hash& other);
+
+    /// Get the hash if published.
+    bool get(hash_digest& out) const;
+
+    /// Get the published hash, otherwise compute and publish it.
+    template <typename Compute>
+    hash_digest get(Compute compute) const;
+
+    /// Publish the hash, unless already published.
+    void set(const hash_digest& hash) const;
+
+    /// Clear the published hash.
+    void reset();
+
+private:
+    enum : uint8_t
+    {
+        empty,
+        writing,
+        published
+    };
+
+    mutable std::atomic<uint8_t> state_;
+    mutable hash_digest hash_;
+};
+
+} // namespace system
+} // namespace libbitcoin
+
+#include <bitcoin/system/impl/utility/cached_hash.ipp>
+
+#endif
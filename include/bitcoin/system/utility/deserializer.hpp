@@ -33,8 +33,9 @@ namespace libbitcoin {
 namespace system {
 
 /// Reader to wrap arbitrary iterator.
+/// This is final so that reads through a concrete reference are not virtual.
 template <typename Iterator, bool CheckSafe>
-class deserializer
+class deserializer final
   : public reader/*, noncopyable*/
 {
 public:
@@ -116,6 +117,11 @@ private:
     const Iterator end_;
 };
 
+/// Bounds checked reader over a contiguous byte buffer.
+/// Chain object deserialization over this type is not virtual and not stream
+/// based, field reads are inlined and read_bytes copies directly from memory.
+typedef deserializer<const uint8_t*, true> byte_reader;
+
 // Factories.
 //-----------------------------------------------------------------------------
 
@@ -130,6 +136,9 @@ deserializer<Iterator, true> make_safe_deserializer(const Iterator begin,
 template <typename Iterator>
 deserializer<Iterator, false> make_unsafe_deserializer(const Iterator begin);
 
+/// Bounds checked reader over the data (which must outlive the reader).
+byte_reader make_byte_reader(const data_slice& data);
+
 } // namespace system
 } // namespace libbitcoin
 
@@ -0,0 +1,44 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_PARALLEL_HPP
+#define LIBBITCOIN_SYSTEM_PARALLEL_HPP
+
+#include <cstddef>
+#include <functional>
+#include <bitcoin/system/define.hpp>
+#include <bitcoin/system/error.hpp>
+#include <bitcoin/system/utility/threadpool.hpp>
+
+namespace libbitcoin {
+namespace system {
+
+typedef std::function<code(size_t index)> indexed_job;
+
+/// Invoke job for each index in [0, count) on the threads of the pool and on
+/// the calling thread, returning upon completion of all jobs. The result is
+/// the error of the lowest failing index, as in sequential execution. Jobs
+/// above a known failure are skipped (cancelled). The calling thread works
+/// as well, so this completes even if the pool is empty or fully occupied.
+BC_API code parallel_first_error(threadpool& pool, size_t count,
+    const indexed_job& job);
+
+} // namespace system
+} // namespace libbitcoin
+
+#endif
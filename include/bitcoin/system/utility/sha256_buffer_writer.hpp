@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_SHA256_BUFFER_WRITER_HPP
+#define LIBBITCOIN_SYSTEM_SHA256_BUFFER_WRITER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/system/define.hpp>
+#include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/utility/sha256_writer.hpp>
+
+namespace libbitcoin {
+namespace system {
+
+/// Writer to serialize into a fixed size buffer while hashing the written
+/// data. Written bytes are hashed in strides, while still in cache, so that
+/// small writes do not each incur a hash call. Writing past the end of the
+/// buffer invalidates the writer and discards that and all later writes.
+class BC_API sha256_buffer_writer
+  : public sha256_writer
+{
+public:
+    sha256_buffer_writer(uint8_t* buffer, size_t size,
+        sha256_context& context);
+
+    /// The number of bytes written.
+    size_t size() const;
+
+    /// Hash the written bytes that have not yet been hashed.
+    void flush();
+
+    /// Context.
+    operator bool() const;
+    bool operator!() const;
+
+    /// Write required size buffer.
+    using sha256_writer::write_bytes;
+    void write_bytes(const uint8_t* data, size_t size);
+
+    /// Advance without writing, the skipped bytes are zeroed.
+    void skip(size_t size);
+
+private:
+    void hash_stride();
+
+    uint8_t* const begin_;
+    uint8_t* const end_;
+    uint8_t* position_;
+    uint8_t* hashed_;
+    bool valid_;
+};
+
+} // namespace system
+} // namespace libbitcoin
+
+#endif
@@ -27,7 +27,6 @@
 #include <numeric>
 #include <type_traits>
 #include <utility>
-#include <unordered_map>
 #include <boost/range/adaptor/reversed.hpp>
 #include <bitcoin/system/chain/chain_state.hpp>
 #include <bitcoin/system/chain/input_point.hpp>
@@ -35,6 +34,7 @@
 #include <bitcoin/system/config/checkpoint.hpp>
 #include <bitcoin/system/constants.hpp>
 #include <bitcoin/system/error.hpp>
+#include <bitcoin/system/math/flat_hash.hpp>
 #include <bitcoin/system/math/hash.hpp>
 #include <bitcoin/system/math/limits.hpp>
 #include <bitcoin/system/machine/opcode.hpp>
@@ -47,6 +47,7 @@
 #include <bitcoin/system/utility/container_source.hpp>
 #include <bitcoin/system/utility/istream_reader.hpp>
 #include <bitcoin/system/utility/ostream_writer.hpp>
+#include <bitcoin/system/utility/parallel.hpp>
 
 namespace libbitcoin {
 namespace system {
@@ -161,8 +162,8 @@ block block::factory(reader& source, bool witness)
 
 bool block::from_data(const data_chunk& data, bool witness)
 {
-    data_source istream(data);
-    return from_data(istream, witness);
+    auto source = make_byte_reader(data);
+    return from_data(source, witness);
 }
 
 bool block::from_data(std::istream& stream, bool witness)
@@ -172,7 +173,8 @@ bool block::from_data(std::istream& stream, bool witness)
 }
 
 // Full block deserialization is always canonical encoding.
-bool block::from_data(reader& source, bool witness)
+template <typename Source>
+bool block::deserialize(Source& source, bool witness)
 {
     const auto start = asio::steady_clock::now();
 
@@ -205,6 +207,16 @@ bool block::from_data(reader& source, bool witness)
     return source;
 }
 
+bool block::from_data(reader& source, bool witness)
+{
+    return deserialize(source, witness);
+}
+
+bool block::from_data(byte_reader& source, bool witness)
+{
+    return deserialize(source, witness);
+}
+
 // private
 void block::reset()
 {
@@ -254,16 +266,7 @@ void block::to_data(writer& sink, bool witness) const
 
 hash_list block::to_hashes(bool witness) const
 {
-    hash_list out;
-    out.reserve(transactions_.size());
-    const auto to_hash = [&out, witness](const transaction& tx)
-    {
-        out.push_back(tx.hash(witness));
-    };
-
-    // Hash ordering matters, don't use std::transform here.
-    std::for_each(transactions_.begin(), transactions_.end(), to_hash);
-    return out;
+    return transaction::hashes(transactions_, witness);
 }
 
 // Properties (size, accessors, cache).
@@ -588,23 +591,17 @@ hash_digest block::generate_merkle_root(bool witness) const
     if (transactions_.empty())
         return null_hash;
 
-    hash_list update;
     auto merkle = to_hashes(witness);
 
-    // Initial capacity is half of the original list (clear doesn't reset).
-    update.reserve((merkle.size() + 1) / 2);
-
     while (merkle.size() > 1)
     {
         // If number of hashes is odd, duplicate last hash in the list.
         if (merkle.size() % 2 != 0)
             merkle.push_back(merkle.back());
 
-        for (auto it = merkle.begin(); it != merkle.end(); it += 2)
-            update.push_back(bitcoin_hash(build_chunk({ it[0], it[1] })));
-
-        std::swap(merkle, update);
-        update.clear();
+        // Each adjacent pair of hashes is a contiguous 64 byte block.
+        merkle = bitcoin_hash_batch(
+            { merkle.front().data(), merkle.back().data() + hash_size });
     }
 
     // There is now only one item in the list.
@@ -617,15 +614,15 @@ hash_digest block::generate_merkle_root(bool witness) const
 //*****************************************************************************
 bool block::is_forward_reference() const
 {
-    std::unordered_map<hash_digest, bool> hashes(transactions_.size());
+    hash_digest_set hashes(transactions_.size());
     const auto is_forward = [&hashes](const input& input)
     {
-        return hashes.count(input.previous_output().hash()) != 0;
+        return hashes.contains(input.previous_output().hash());
     };
 
     for (const auto& tx: reverse(transactions_))
     {
-        hashes.emplace(tx.hash(), true);
+        hashes.insert(tx.hash());
 
         if (std::any_of(tx.inputs().begin(), tx.inputs().end(), is_forward))
             return true;
@@ -657,6 +654,48 @@ bool block::is_internal_double_spend() const
     return !distinct;
 }
 
+code block::check_internal_spends() const
+{
+    const auto& txs = transactions_;
+    const auto count = txs.size();
+
+    if (count == 0)
+        return error::success;
+
+    // Each transaction hash maps to its last position (plus one) in the block.
+    flat_map<hash_digest, size_t> positions(count);
+
+    for (size_t tx = 0; tx < count; ++tx)
+        positions[txs[tx].hash()] = tx + 1u;
+
+    // Both tables are sized up front, so neither is rehashed.
+    point_set spends(total_non_coinbase_inputs());
+    auto double_spend = false;
+
+    for (size_t tx = 0; tx < count; ++tx)
+    {
+        for (const auto& input: txs[tx].inputs())
+        {
+            const auto& prevout = input.previous_output();
+            const auto position = positions.find(prevout.hash());
+
+            // Spends an output of this or a later transaction in the block.
+            if (position != nullptr && *position > tx)
+                return error::forward_reference;
+
+            // Continue only to find a forward reference, which takes priority.
+            if (tx == 0 || double_spend)
+                continue;
+
+            if (!spends.insert(prevout))
+                double_spend = true;
+        }
+    }
+
+    return double_spend ? error::block_internal_double_spend :
+        error::success;
+}
+
 bool block::is_valid_merkle_root() const
 {
     return generate_merkle_root() == header_.merkle_root();
@@ -718,8 +757,8 @@ bool block::is_valid_witness_commitment() const
     if (coinbase.inputs().front().extract_reserved_hash(reserved))
         for (const auto& output: reverse(coinbase.outputs()))
             if (output.extract_committed_hash(committed))
-                return committed == bitcoin_hash(
-                    build_chunk({ generate_merkle_root(true), reserved }));
+                return committed == double_sha256_64(
+                    splice(generate_merkle_root(true), reserved));
 
     // If no txs in block are segregated the commitment is optional (bip141).
     return !is_segregated();
@@ -791,6 +830,84 @@ code block::connect_transactions(const chain_state& state) const
     return error::success;
 }
 
+// Scripts of each connected transaction are cached (if the cache is enabled).
+static void cache_connected(const transaction::list& txs, uint32_t forks)
+{
+    auto& cache = script_verification_cache();
+
+    if (cache.capacity() == 0)
+        return;
+
+    for (const auto& tx: txs)
+        if (!tx.is_coinbase())
+            cache.store(tx.hash(true), forks);
+}
+
+code block::connect_transactions(const chain_state& state,
+    threadpool& pool) const
+{
+    code ec;
+    if ((ec = connect_inputs(state, pool, nullptr)))
+        return ec;
+
+    cache_connected(transactions_, state.enabled_forks());
+    return error::success;
+}
+
+// Signature checks are only recorded, the batch is verified by connect.
+code block::connect_transactions(const chain_state& state, threadpool& pool,
+    machine::signature_batch& batch) const
+{
+    return connect_inputs(state, pool, &batch);
+}
+
+code block::connect_inputs(const chain_state& state, threadpool& pool,
+    machine::signature_batch* batch) const
+{
+    struct input_reference
+    {
+        const transaction* tx;
+        size_t index;
+        bool verified;
+    };
+
+    std::vector<input_reference> inputs;
+    inputs.reserve(total_inputs());
+
+    const auto& cache = script_verification_cache();
+    const auto cached = cache.capacity() != 0;
+    const auto forks = state.enabled_forks();
+
+    // Coinbase inputs are not connected (see transaction::connect_input).
+    // Transactions with cached script verification are not reverified.
+    for (const auto& tx: transactions_)
+    {
+        if (tx.is_coinbase())
+            continue;
+
+        const auto verified = cached && cache.contains(tx.hash(true), forks);
+
+        for (size_t input = 0; input < tx.inputs().size(); ++input)
+            inputs.push_back({ &tx, input, verified });
+    }
+
+    // Inputs are ordered by tx, so the first failure is the sequential one.
+    // Cached scripts are verified, the presence of their prevouts is not.
+    const auto connect = [&](size_t index) -> code
+    {
+        const auto& reference = inputs[index];
+        const auto& input = reference.tx->inputs()[reference.index];
+
+        if (!reference.verified)
+            return reference.tx->connect_input(state, reference.index, batch);
+
+        return input.previous_output().metadata.cache.is_valid() ?
+            error::success : error::missing_previous_output;
+    };
+
+    return parallel_first_error(pool, inputs.size(), connect);
+}
+
 // Validation.
 //-----------------------------------------------------------------------------
 
@@ -817,17 +934,14 @@ code block::check(uint64_t max_money, uint32_t timestamp_limit_seconds,
     else if (is_extra_coinbases())
         return error::extra_coinbases;
 
-    // TODO: determinable from tx pool graph.
-    else if (is_forward_reference())
-        return error::forward_reference;
-
     // This is subset of is_internal_double_spend if collisions cannot happen.
     ////else if (!is_distinct_transaction_set())
     ////    return error::internal_duplicate;
 
     // TODO: determinable from tx pool graph.
-    else if (is_internal_double_spend())
-        return error::block_internal_double_spend;
+    // This is is_forward_reference and then is_internal_double_spend.
+    else if ((ec = check_internal_spends()))
+        return ec;
 
     // TODO: relates height to tx.hash(false) (pool cache).
     else if (!is_valid_merkle_root())
@@ -844,6 +958,55 @@ code block::check(uint64_t max_money, uint32_t timestamp_limit_seconds,
         return check_transactions(max_money);
 }
 
+// Stages are jobs in the order of check(), followed by a job for each
+// transaction, so the lowest failing job is the sequential failure.
+code block::check(uint64_t max_money, uint32_t timestamp_limit_seconds,
+    uint32_t proof_of_work_limit, threadpool& pool, bool scrypt,
+    bool header) const
+{
+    static BC_CONSTEXPR size_t stages = 4;
+    const auto start = asio::steady_clock::now();
+
+    const auto check = [&](size_t stage) -> code
+    {
+        switch (stage)
+        {
+            case 0:
+                return header ? header_.check(timestamp_limit_seconds,
+                    proof_of_work_limit, scrypt) : error::success;
+
+            // These are cheap and dependent, so they share a stage.
+            case 1:
+                if (serialized_size(false) > max_block_size)
+                    return error::block_size_limit;
+                else if (transactions_.empty())
+                    return error::empty_block;
+                else if (!transactions_.front().is_coinbase())
+                    return error::first_not_coinbase;
+                else if (is_extra_coinbases())
+                    return error::extra_coinbases;
+                else
+                    return error::success;
+
+            case 2:
+                return check_internal_spends();
+
+            case 3:
+                return is_valid_merkle_root() ? error::success :
+                    error::merkle_mismatch;
+
+            default:
+                return transactions_[stage - stages].check(max_money, false);
+        }
+    };
+
+    const auto ec = parallel_first_error(pool,
+        stages + transactions_.size(), check);
+
+    metadata.check = asio::steady_clock::now() - start;
+    return ec;
+}
+
 code block::accept(const system::settings& settings, bool transactions,
     bool header) const
 {
@@ -905,6 +1068,75 @@ code block::accept(const chain_state& state,
         return ec;
 }
 
+// Stages are jobs in the order of accept(), followed (if transactions) by a
+// job for each transaction, so the lowest failing job is the sequential one.
+code block::accept(const chain_state& state,
+    const system::settings& settings, threadpool& pool, bool transactions,
+    bool header) const
+{
+    static BC_CONSTEXPR size_t stages = 7;
+    const auto start = asio::steady_clock::now();
+    const auto bip16 = state.is_enabled(bip16_rule);
+    const auto bip34 = state.is_enabled(bip34_rule);
+    const auto bip42 = state.is_enabled(bip42_rule);
+    const auto bip113 = state.is_enabled(bip113_rule);
+    const auto bip141 = state.is_enabled(bip141_rule);
+
+    const auto max_sigops = bip141 ? max_fast_sigops : max_block_sigops;
+    const auto block_time = bip113 ? state.median_time_past() :
+        header_.timestamp();
+
+    const auto accept = [&](size_t stage) -> code
+    {
+        switch (stage)
+        {
+            case 0:
+                return header ? header_.accept(state) : error::success;
+
+            case 1:
+                return bip141 && weight() > max_block_weight ?
+                    error::block_weight_limit : error::success;
+
+            case 2:
+                return bip34 && !is_valid_coinbase_script(state.height()) ?
+                    error::coinbase_height_mismatch : error::success;
+
+            case 3:
+                return !is_valid_coinbase_claim(state.height(),
+                    settings.subsidy_interval_blocks,
+                    settings.initial_subsidy(), bip42) ?
+                    error::coinbase_value_limit : error::success;
+
+            case 4:
+                return !is_final(state.height(), block_time) ?
+                    error::block_non_final : error::success;
+
+            case 5:
+                return bip141 && !is_valid_witness_commitment() ?
+                    error::invalid_witness_commitment : error::success;
+
+            case 6:
+                return signature_operations(bip16, bip141) > max_sigops ?
+                    error::block_embedded_sigop_limit : error::success;
+
+            default:
+                return transactions_[stage - stages].accept(state, false);
+        }
+    };
+
+    code ec;
+
+    // Only the header is accepted under checkpoint, as in sequential accept.
+    if (state.is_under_checkpoint())
+        ec = header ? header_.accept(state) : error::success;
+    else
+        ec = parallel_first_error(pool, transactions ?
+            stages + transactions_.size() : stages - 1u, accept);
+
+    metadata.accept = asio::steady_clock::now() - start;
+    return ec;
+}
+
 code block::connect() const
 {
     const auto state = header_.metadata.state;
@@ -919,6 +1151,35 @@ code block::connect(const chain_state& state) const
     return connect_transactions(state);
 }
 
+code block::connect(const chain_state& state, threadpool& pool) const
+{
+    const auto start = asio::steady_clock::now();
+    const auto ec = state.is_under_checkpoint() ? error::success :
+        connect_transactions(state, pool);
+
+    metadata.connect = asio::steady_clock::now() - start;
+    return ec;
+}
+
+code block::connect(const chain_state& state, threadpool& pool,
+    machine::signature_batch& batch) const
+{
+    const auto start = asio::steady_clock::now();
+    code ec;
+
+    // Signatures are cached only once the block is accepted.
+    if (!state.is_under_checkpoint() &&
+        !(ec = connect_transactions(state, pool, batch)) &&
+        !(ec = batch.verify(pool)))
+    {
+        batch.store();
+        cache_connected(transactions_, state.enabled_forks());
+    }
+
+    metadata.connect = asio::steady_clock::now() - start;
+    return ec;
+}
+
 } // namespace chain
 } // namespace system
 } // namespace libbitcoin
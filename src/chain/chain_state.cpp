@@ -22,20 +22,24 @@
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
-#include <boost/multiprecision/integer.hpp>
+#include <memory>
+#include <vector>
 #include <boost/range/adaptor/reversed.hpp>
 #include <bitcoin/system/chain/block.hpp>
 #include <bitcoin/system/chain/chain_state.hpp>
 #include <bitcoin/system/chain/compact.hpp>
+#include <bitcoin/system/chain/median_time_window.hpp>
 #include <bitcoin/system/chain/script.hpp>
 #include <bitcoin/system/config/checkpoint.hpp>
 #include <bitcoin/system/constants.hpp>
 #include <bitcoin/system/math/hash.hpp>
 #include <bitcoin/system/math/limits.hpp>
+#include <bitcoin/system/math/uint256.hpp>
 #include <bitcoin/system/machine/opcode.hpp>
 #include <bitcoin/system/machine/rule_fork.hpp>
 #include <bitcoin/system/settings.hpp>
 #include <bitcoin/system/unicode/unicode.hpp>
+#include <bitcoin/system/utility/thread.hpp>
 #include <bitcoin/system/utility/timer.hpp>
 
 namespace libbitcoin {
@@ -76,41 +80,322 @@ inline uint32_t bits_high(const chain_state::data& values)
     return values.bits.ordered.back();
 }
 
+//*****************************************************************************
+// CONSENSUS: Though unspecified in bip34, the satoshi implementation
+// performed this comparison using the signed integer version value.
+//*****************************************************************************
+inline bool is_at_least(uint32_t value, uint32_t version)
+{
+    return static_cast<int32_t>(value) >= static_cast<int32_t>(version);
+}
+
+inline size_t count_at_least(const chain_state::versions& values,
+    uint32_t version)
+{
+    return std::count_if(values.begin(), values.end(), [=](uint32_t value)
+    {
+        return is_at_least(value, version);
+    });
+}
+
+// history
+//-----------------------------------------------------------------------------
+
+// A ring of header values shared by the incremental states of a branch.
+// Each entry carries running totals of the sampled version predicates, so
+// that the count over any retained window is the difference of two entries.
+struct chain_state::history
+{
+    struct entry
+    {
+        size_t height;
+        hash_digest hash;
+        uint32_t bits;
+        version_counts totals;
+    };
+
+    history(size_t capacity, size_t base);
+
+    static history_ptr create(const data& values,
+        const system::settings& settings);
+    static history_ptr extend(const chain_state& parent,
+        const system::settings& settings);
+
+    bool get_bits(bitss& out, size_t height, uint32_t forks,
+        const system::settings& settings) const;
+    bool get_counts(version_counts& out, size_t height, size_t count) const;
+
+private:
+    const entry* find(size_t height) const;
+    bool push(size_t height, const hash_digest& hash, uint32_t bits,
+        uint32_t version, const system::settings& settings);
+
+    // The ring must retain the longest sample below any derivable state.
+    static size_t capacity(const system::settings& settings);
+
+    // Totals are relative to this height, lower entries were never pushed.
+    const size_t base_;
+    size_t size_;
+    size_t top_;
+    std::vector<entry> entries_;
+    mutable shared_mutex mutex_;
+};
+
+chain_state::history::history(size_t capacity, size_t base)
+  : base_(base), size_(0), top_(0), entries_(capacity)
+{
+}
+
+// static
+size_t chain_state::history::capacity(const system::settings& settings)
+{
+    const auto sample = std::max({ settings.retargeting_interval(),
+        settings.activation_sample, median_time_past_interval });
+
+    // Retain as many states again above the longest sample.
+    return 2u * (sample + 1u);
+}
+
+// static
+chain_state::history_ptr chain_state::history::create(const data& values,
+    const system::settings& settings)
+{
+    const auto& bits = values.bits.ordered;
+    const auto& versions = values.version.ordered;
+    const auto count = std::min(values.height, std::max(bits.size(),
+        versions.size()));
+
+    auto result = std::make_shared<history>(capacity(settings),
+        values.height - count);
+
+    // Samples are ordered by height with high (block - 1) last.
+    for (auto height = values.height - count; height < values.height;
+        ++height)
+    {
+        const auto back = values.height - height;
+        const auto bit = back > bits.size() ? 0u : bits[bits.size() - back];
+        const auto version = back > versions.size() ? 0u :
+            versions[versions.size() - back];
+
+        result->push(height, null_hash, bit, version, settings);
+    }
+
+    return result;
+}
+
+// static
+// Append the parent's values, copying the branch to a new ring on a fork.
+chain_state::history_ptr chain_state::history::extend(
+    const chain_state& parent, const system::settings& settings)
+{
+    const auto& values = parent.data_;
+    const auto& current = parent.history_;
+    const auto height = values.height;
+
+    if (!current)
+        return {};
+
+    unique_lock lock(current->mutex_);
+    const auto existing = current->find(height);
+
+    // The parent is already in the branch (e.g. block of a header state).
+    if (existing != nullptr && existing->hash == values.hash)
+        return current;
+
+    // The parent is at the top of the branch.
+    if (existing == nullptr && (current->size_ == 0 ?
+        height == current->base_ : height == current->top_ + 1u))
+        return current->push(height, values.hash, values.bits.self,
+            values.version.self, settings) ? current : history_ptr{};
+
+    // The parent forks the branch, so copy the retained values below it.
+    auto result = std::make_shared<history>(current->entries_.size(),
+        current->base_);
+
+    const auto bottom = current->size_ == 0 ? height :
+        current->top_ + 1u - current->size_;
+
+    for (auto index = bottom; index < height; ++index)
+    {
+        const auto entry = current->find(index);
+
+        // The parent's sample is no longer retained.
+        if (entry == nullptr)
+            return {};
+
+        result->entries_[index % result->entries_.size()] = *entry;
+        result->top_ = index;
+        ++result->size_;
+    }
+
+    return result->push(height, values.hash, values.bits.self,
+        values.version.self, settings) ? result : history_ptr{};
+}
+
+// Get the bits sample of the state at height, limited to those read by the
+// work computation (i.e. ending at a retarget height or non-limit bits).
+bool chain_state::history::get_bits(bitss& out, size_t height, uint32_t forks,
+    const system::settings& settings) const
+{
+    const auto interval = settings.retargeting_interval();
+    const auto limit = settings.proof_of_work_limit;
+    const auto scan = bits_count(height, forks, interval) > 1u;
+
+    shared_lock lock(mutex_);
+    out.clear();
+
+    for (auto index = height; index > 0;)
+    {
+        const auto entry = find(--index);
+
+        if (entry == nullptr)
+            return false;
+
+        out.push_front(entry->bits);
+
+        if (!scan || is_retarget_or_non_limit(index, entry->bits, interval,
+            limit))
+            return true;
+    }
+
+    return true;
+}
+
+// Get the version predicate counts over the count values below height.
+bool chain_state::history::get_counts(version_counts& out, size_t height,
+    size_t count) const
+{
+    out = { 0, 0, 0 };
+
+    if (count == 0)
+        return true;
+
+    shared_lock lock(mutex_);
+    const auto high = find(height - 1u);
+
+    if (high == nullptr)
+        return false;
+
+    const auto low = height - count;
+
+    if (low <= base_)
+    {
+        out = high->totals;
+        return true;
+    }
+
+    const auto floor = find(low - 1u);
+
+    if (floor == nullptr)
+        return false;
+
+    out.bip34 = high->totals.bip34 - floor->totals.bip34;
+    out.bip66 = high->totals.bip66 - floor->totals.bip66;
+    out.bip65 = high->totals.bip65 - floor->totals.bip65;
+    return true;
+}
+
+// private
+const chain_state::history::entry* chain_state::history::find(
+    size_t height) const
+{
+    if (size_ == 0 || height > top_ || top_ - height >= size_)
+        return nullptr;
+
+    return &entries_[height % entries_.size()];
+}
+
+// private
+// The height must be that of the next entry, which replaces the oldest.
+bool chain_state::history::push(size_t height, const hash_digest& hash,
+    uint32_t bits, uint32_t version, const system::settings& settings)
+{
+    version_counts totals{ 0, 0, 0 };
+
+    if (height > base_)
+    {
+        const auto previous = find(height - 1u);
+
+        if (previous == nullptr)
+            return false;
+
+        totals = previous->totals;
+    }
+
+    totals.bip34 += is_at_least(version, settings.bip34_version) ? 1u : 0u;
+    totals.bip66 += is_at_least(version, settings.bip66_version) ? 1u : 0u;
+    totals.bip65 += is_at_least(version, settings.bip65_version) ? 1u : 0u;
+
+    entries_[height % entries_.size()] = { height, hash, bits, totals };
+    size_ = std::min(size_ + 1u, entries_.size());
+    top_ = height;
+    return true;
+}
+
 // activation
 //-----------------------------------------------------------------------------
 
 chain_state::activations chain_state::activation(const data& values,
     uint32_t forks, const system::settings& settings)
+{
+    return activation(values, to_counts(values, settings), forks, settings);
+}
+
+// An invalid (uncounted) state has no version-based activations.
+chain_state::activations chain_state::activation(const data& values,
+    const boost::optional<version_counts>& counts, uint32_t forks,
+    const system::settings& settings)
+{
+    static const version_counts none{ 0, 0, 0 };
+    return activation(values, counts ? *counts : none, forks, settings);
+}
+
+// Compute bip34-based activation version summaries.
+chain_state::version_counts chain_state::to_counts(const data& values,
+    const system::settings& settings)
+{
+    const auto& history = values.version.ordered;
+    return
+    {
+        count_at_least(history, settings.bip34_version),
+        count_at_least(history, settings.bip66_version),
+        count_at_least(history, settings.bip65_version)
+    };
+}
+
+// Incremental states take summaries from the shared history, which must
+// retain the sample at the time of construction.
+boost::optional<chain_state::version_counts> chain_state::to_counts(
+    const data& values, const history_ptr& history, uint32_t forks,
+    const system::settings& settings)
+{
+    if (!history)
+        return to_counts(values, settings);
+
+    version_counts counts;
+    const auto count = version_count(values.height, forks,
+        settings.activation_sample);
+
+    if (!history->get_counts(counts, values.height, count))
+        return boost::none;
+
+    return counts;
+}
+
+chain_state::activations chain_state::activation(const data& values,
+    const version_counts& counts, uint32_t forks,
+    const system::settings& settings)
 {
     const auto height = values.height;
     const auto version = values.version.self;
-    const auto& history = values.version.ordered;
     const auto frozen = script::is_enabled(forks, rule_fork::bip90_rule);
     const auto difficult = script::is_enabled(forks, rule_fork::difficult);
     const auto retarget = script::is_enabled(forks, rule_fork::retarget);
     const auto mainnet = retarget && difficult;
 
-    //*************************************************************************
-    // CONSENSUS: Though unspecified in bip34, the satoshi implementation
-    // performed this comparison using the signed integer version value.
-    //*************************************************************************
-    const auto ge = [](uint32_t value, uint32_t version)
-    {
-        return static_cast<int32_t>(value) >= static_cast<int32_t>(version);
-    };
-
-    // Declare bip34-based version predicates.
-    const auto ge_2 = [=](uint32_t value) { return ge(value,
-        settings.bip34_version); };
-    const auto ge_3 = [=](uint32_t value) { return ge(value,
-        settings.bip66_version); };
-    const auto ge_4 = [=](uint32_t value) { return ge(value,
-        settings.bip65_version); };
-
-    // Compute bip34-based activation version summaries.
-    const auto count_2 = std::count_if(history.begin(), history.end(), ge_2);
-    const auto count_3 = std::count_if(history.begin(), history.end(), ge_3);
-    const auto count_4 = std::count_if(history.begin(), history.end(), ge_4);
+    const auto count_2 = counts.bip34;
+    const auto count_3 = counts.bip66;
+    const auto count_4 = counts.bip65;
 
     // Frozen activations (require version and enforce above freeze height).
     const auto bip34_ice = frozen && height >= settings.bip34_freeze;
@@ -281,15 +566,17 @@ size_t chain_state::bip9_bit1_height(size_t height,
 
 uint32_t chain_state::median_time_past(const data& values, uint32_t)
 {
-    // Create a copy for the in-place sort.
-    auto times = values.timestamp.ordered;
+    return to_median_window(values).median();
+}
+
+median_time_window chain_state::to_median_window(const data& values)
+{
+    median_time_window window;
 
-    // Sort the times by value to obtain the median.
-    std::sort(times.begin(), times.end());
+    for (const auto timestamp: values.timestamp.ordered)
+        window.push(timestamp);
 
-    // Consensus defines median time using modulo 2 element selection.
-    // This differs from arithmetic median which averages two middle values.
-    return times.empty() ? 0 : times[times.size() / 2];
+    return window;
 }
 
 // work_required
@@ -326,19 +613,19 @@ uint32_t chain_state::work_required_retarget(const data& values, uint32_t forks,
     uint32_t proof_of_work_limit, uint32_t minimum_timespan,
     uint32_t maximum_timespan, uint32_t retargeting_interval_seconds)
 {
-    static const uint256_t pow_limit(compact{ proof_of_work_limit });
+    const uint256 pow_limit(compact{ proof_of_work_limit });
 
     const compact bits(bits_high(values));
     BITCOIN_ASSERT_MSG(!bits.is_overflowed(), "previous block has bad bits");
 
-    uint256_t target(bits);
+    uint256 target(bits);
 
     // Conditionally implement retarget overflow patch (e.g. Litecoin).
+    // This shifts if the target msb is not below that of the limit.
     const auto retarget_overflow = script::is_enabled(forks,
         rule_fork::retarget_overflow_patch);
-    const auto shift = retarget_overflow && (
-        boost::multiprecision::msb(target) + 1 >
-        boost::multiprecision::msb(pow_limit)) ? 1u : 0u;
+    const auto shift = retarget_overflow &&
+        target.bit_length() >= pow_limit.bit_length() ? 1u : 0u;
 
     target >>= shift;
     target *= retarget_timespan(values, minimum_timespan, maximum_timespan);
@@ -525,7 +812,7 @@ uint32_t chain_state::retargeting_interval(
 
 // This is promotion from a preceding height to the next.
 chain_state::data chain_state::to_pool(const chain_state& top,
-    const system::settings& settings)
+    const history_ptr& history, const system::settings& settings)
 {
     // Alias configured forks.
     const auto forks = top.forks_;
@@ -533,6 +820,10 @@ chain_state::data chain_state::to_pool(const chain_state& top,
     // Retargeting is only activated via configuration.
     const auto retarget = script::is_enabled(forks, rule_fork::retarget);
 
+    // An incremental parent that cannot be extended produces invalid state.
+    if (top.history_ && !history)
+        return {};
+
     // Copy data from presumed previous-height block state.
     auto data = top.data_;
 
@@ -540,19 +831,32 @@ chain_state::data chain_state::to_pool(const chain_state& top,
     const auto height = data.height + 1u;
 
     // Enqueue previous block values to collections.
-    data.bits.ordered.push_back(data.bits.self);
-    data.version.ordered.push_back(data.version.self);
     data.timestamp.ordered.push_back(data.timestamp.self);
 
-    // If bits collection overflows, dequeue oldest member.
-    if (data.bits.ordered.size() >
-        bits_count(height, forks, settings.retargeting_interval()))
-        data.bits.ordered.pop_front();
+    if (history)
+    {
+        // Bits are sampled from the history, versions are counted on
+        // construction of the state (see to_counts).
+        if (!history->get_bits(data.bits.ordered, height, forks, settings))
+            return {};
 
-    // If version collection overflows, dequeue oldest member.
-    if (data.version.ordered.size() > version_count(height, forks,
-            settings.activation_sample))
-        data.version.ordered.pop_front();
+        data.version.ordered.clear();
+    }
+    else
+    {
+        data.bits.ordered.push_back(data.bits.self);
+        data.version.ordered.push_back(data.version.self);
+
+        // If bits collection overflows, dequeue oldest member.
+        if (data.bits.ordered.size() >
+            bits_count(height, forks, settings.retargeting_interval()))
+            data.bits.ordered.pop_front();
+
+        // If version collection overflows, dequeue oldest member.
+        if (data.version.ordered.size() > version_count(height, forks,
+                settings.activation_sample))
+            data.version.ordered.pop_front();
+    }
 
     // If timestamp collection overflows, dequeue oldest member.
     if (data.timestamp.ordered.size() > timestamp_count(height, forks))
@@ -584,13 +888,16 @@ chain_state::data chain_state::to_pool(const chain_state& top,
 // This generates a state for the pool above the presumed top block state.
 chain_state::chain_state(const chain_state& top,
     const system::settings& settings)
-  : data_(to_pool(top, settings)),
+  : history_(history::extend(top, settings)),
+    data_(to_pool(top, history_, settings)),
     forks_(top.forks_),
     stale_seconds_(top.stale_seconds_),
     checkpoints_(top.checkpoints_),
-    active_(activation(data_, forks_, settings)),
+    counts_(to_counts(data_, history_, forks_, settings)),
+    active_(activation(data_, counts_, forks_, settings)),
     work_required_(work_required(data_, forks_, settings)),
-    median_time_past_(median_time_past(data_, forks_))
+    median_window_(top.child_median_window()),
+    median_time_past_(median_window_.median())
 {
 }
 
@@ -622,16 +929,20 @@ chain_state::data chain_state::to_block(const chain_state& pool,
 
 // Constructor (tx pool to block).
 // This assumes that the pool state is the same height as the block.
+// The version sample is that of the pool, so its counts are not requeried.
 chain_state::chain_state(const chain_state& pool, const block& block,
     const system::settings& settings)
-  : data_(to_block(pool, block, settings.bip9_bit0_active_checkpoint,
+  : history_(pool.history_),
+    data_(to_block(pool, block, settings.bip9_bit0_active_checkpoint,
         settings.bip9_bit1_active_checkpoint)),
     forks_(pool.forks_),
     stale_seconds_(pool.stale_seconds_),
     checkpoints_(pool.checkpoints_),
-    active_(activation(data_, forks_, settings)),
+    counts_(pool.counts_),
+    active_(activation(data_, counts_, forks_, settings)),
     work_required_(work_required(data_, forks_, settings)),
-    median_time_past_(median_time_past(data_, forks_))
+    median_window_(pool.median_window_),
+    median_time_past_(median_window_.median())
 {
 }
 
@@ -641,7 +952,7 @@ chain_state::data chain_state::to_header(const chain_state& parent,
     BITCOIN_ASSERT(header.previous_block_hash() == parent.hash());
 
     // Copy and promote data from presumed parent-height header/block state.
-    auto data = to_pool(parent, settings);
+    auto data = to_pool(parent, history_, settings);
 
     // Replace the pool (empty) current block state with given header state.
     // Preserve data.timestamp.retarget promotion.
@@ -665,26 +976,43 @@ chain_state::data chain_state::to_header(const chain_state& parent,
 // This assumes that parent is the state of the header's previous block.
 chain_state::chain_state(const chain_state& parent, const header& header,
     const system::settings& settings)
-  : data_(to_header(parent, header, settings)),
+  : history_(history::extend(parent, settings)),
+    data_(to_header(parent, header, settings)),
     forks_(parent.forks_),
     stale_seconds_(parent.stale_seconds_),
     checkpoints_(parent.checkpoints_),
-    active_(activation(data_, forks_, settings)),
+    counts_(to_counts(data_, history_, forks_, settings)),
+    active_(activation(data_, counts_, forks_, settings)),
     work_required_(work_required(data_, forks_, settings)),
-    median_time_past_(median_time_past(data_, forks_))
+    median_window_(parent.child_median_window()),
+    median_time_past_(median_window_.median())
 {
 }
 
 // Constructor (from raw data).
 chain_state::chain_state(data&& values, const checkpoints& checkpoints,
     uint32_t forks, uint32_t stale_seconds, const system::settings& settings)
-  : data_(std::move(values)),
+  : chain_state(std::move(values), checkpoints, forks, stale_seconds,
+        settings, false)
+{
+}
+
+// Constructor (from raw data, optionally incremental).
+// The history is seeded from the given samples.
+chain_state::chain_state(data&& values, const checkpoints& checkpoints,
+    uint32_t forks, uint32_t stale_seconds, const system::settings& settings,
+    bool incremental)
+  : history_(incremental ? history::create(values, settings) :
+        history_ptr{}),
+    data_(std::move(values)),
     forks_(forks),
     stale_seconds_(stale_seconds),
     checkpoints_(checkpoints),
-    active_(activation(data_, forks_, settings)),
+    counts_(to_counts(data_, settings)),
+    active_(activation(data_, counts_, forks_, settings)),
     work_required_(work_required(data_, forks_, settings)),
-    median_time_past_(median_time_past(data_, forks_))
+    median_window_(to_median_window(data_)),
+    median_time_past_(median_window_.median())
 {
 }
 
@@ -693,7 +1021,12 @@ chain_state::chain_state(data&& values, const checkpoints& checkpoints,
 // These are the conditions that would cause exception during execution.
 bool chain_state::is_valid() const
 {
-    return data_.height != 0;
+    return data_.height != 0 && counts_ != boost::none;
+}
+
+bool chain_state::is_incremental() const
+{
+    return history_ != nullptr;
 }
 
 // If there is a zero limit then the chain is never considered stale.
@@ -736,6 +1069,13 @@ uint32_t chain_state::median_time_past() const
     return median_time_past_;
 }
 
+median_time_window chain_state::child_median_window() const
+{
+    auto window = median_window_;
+    window.push(data_.timestamp.self);
+    return window;
+}
+
 uint32_t chain_state::work_required() const
 {
     return work_required_;
@@ -18,8 +18,11 @@
  */
 #include <bitcoin/system/chain/compact.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <bitcoin/system/constants.hpp>
 #include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/math/uint256.hpp>
 #include <bitcoin/system/utility/assert.hpp>
 
 namespace libbitcoin {
@@ -80,14 +83,59 @@ inline uint32_t shift_high(uint8_t exponent)
     return  8 * (exponent - 3);
 }
 
-inline size_t logical_size(uint256_t value)
+inline size_t logical_size(const uint256& value)
 {
-    auto byte = 0;
+    return (value.bit_length() + 7) / 8;
+}
+
+inline uint64_t to_word(const uint256_t& value, size_t index)
+{
+    static const uint256_t word_mask(max_uint64);
+    return static_cast<uint64_t>((value >> (64 * index)) & word_mask);
+}
+
+inline uint256 to_fixed(const uint256_t& value)
+{
+    return
+    {
+        to_word(value, 0),
+        to_word(value, 1),
+        to_word(value, 2),
+        to_word(value, 3)
+    };
+}
+
+// Static
+//-----------------------------------------------------------------------------
+
+// Returns false on overflow, negatives are converted to zero (as big).
+bool compact::to_target(hash_digest& out, uint32_t compact)
+{
+    out.fill(0);
+
+    //*************************************************************************
+    // CONSENSUS: The sign bit is not honored and it instead produces zero.
+    //*************************************************************************
+    if (is_negated(compact))
+        return true;
 
-    for (; value != 0; ++byte)
-        value >>= 8;
+    auto mantissa = compact & mantissa_max;
+    const auto exponent = static_cast<uint8_t>(compact >> mantissa_bits);
+    size_t offset = 0;
 
-    return byte;
+    if (exponent <= 3)
+        mantissa >>= shift_low(exponent);
+    else if (is_overflow(exponent, mantissa))
+        return false;
+    else
+        offset = shift_high(exponent) / 8;
+
+    // Only zero bytes of the mantissa may lie beyond the number.
+    for (size_t byte = 0; byte < mantissa_bits / 8; ++byte)
+        if (offset + byte < hash_size)
+            out[offset + byte] = static_cast<uint8_t>(mantissa >> (8 * byte));
+
+    return true;
 }
 
 // Constructors
@@ -99,12 +147,17 @@ compact::compact(uint32_t compact)
     normal_ = from_big(big_);
 }
 
-compact::compact(const uint256_t& value)
+compact::compact(const uint256& value)
   : big_(value), overflowed_(false)
 {
     normal_ = from_big(big_);
 }
 
+compact::compact(const uint256_t& value)
+  : compact(to_fixed(value))
+{
+}
+
 bool compact::is_overflowed() const
 {
     return overflowed_;
@@ -115,13 +168,18 @@ uint32_t compact::normal() const
     return normal_;
 }
 
-compact::operator const uint256_t&() const
+compact::operator const uint256&() const
+{
+    return big_;
+}
+
+compact::operator uint256_t() const
 {
     return big_;
 }
 
 // Returns false on overflow, negatives are converted to zero.
-bool compact::from_compact(uint256_t& out, uint32_t compact)
+bool compact::from_compact(uint256& out, uint32_t compact)
 {
     //*************************************************************************
     // CONSENSUS: The sign bit is not honored and it instead produces zero.
@@ -157,7 +215,7 @@ bool compact::from_compact(uint256_t& out, uint32_t compact)
     return true;
 }
 
-uint32_t compact::from_big(const uint256_t& big)
+uint32_t compact::from_big(const uint256& big)
 {
     // This value is limited to 32, so exponent cannot overflow.
     auto exponent = static_cast<uint8_t>(logical_size(big));
@@ -30,6 +30,7 @@
 #include <bitcoin/system/utility/container_source.hpp>
 #include <bitcoin/system/utility/istream_reader.hpp>
 #include <bitcoin/system/utility/ostream_writer.hpp>
+#include <bitcoin/system/utility/serializer.hpp>
 
 namespace libbitcoin {
 namespace system {
@@ -47,7 +48,7 @@ header::header()
 }
 
 header::header(header&& other)
-  : hash_(other.hash_cache()),
+  : hash_(other.hash_),
     version_(other.version_),
     previous_block_hash_(std::move(other.previous_block_hash_)),
     merkle_root_(std::move(other.merkle_root_)),
@@ -59,7 +60,7 @@ header::header(header&& other)
 }
 
 header::header(const header& other)
-  : hash_(other.hash_cache()),
+  : hash_(other.hash_),
     version_(other.version_),
     previous_block_hash_(other.previous_block_hash_),
     merkle_root_(other.merkle_root_),
@@ -95,19 +96,12 @@ header::header(uint32_t version, const hash_digest& previous_block_hash,
 {
 }
 
-// Private cache access for copy/move construction.
-header::hash_ptr header::hash_cache() const
-{
-    shared_lock lock(mutex_);
-    return hash_;
-}
-
 // Operators.
 //-----------------------------------------------------------------------------
 
 header& header::operator=(header&& other)
 {
-    hash_ = other.hash_cache();
+    hash_ = other.hash_;
     version_ = other.version_;
     previous_block_hash_ = std::move(other.previous_block_hash_);
     merkle_root_ = std::move(other.merkle_root_);
@@ -120,7 +114,7 @@ header& header::operator=(header&& other)
 
 header& header::operator=(const header& other)
 {
-    hash_ = other.hash_cache();
+    hash_ = other.hash_;
     version_ = other.version_;
     previous_block_hash_ = other.previous_block_hash_;
     merkle_root_ = other.merkle_root_;
@@ -191,8 +185,8 @@ header header::factory(reader& source, const hash_digest& hash, bool wire)
 
 bool header::from_data(const data_chunk& data, bool wire)
 {
-    data_source istream(data);
-    return from_data(istream, wire);
+    auto source = make_byte_reader(data);
+    return from_data(source, wire);
 }
 
 bool header::from_data(std::istream& stream, bool wire)
@@ -201,7 +195,8 @@ bool header::from_data(std::istream& stream, bool wire)
     return from_data(source, wire);
 }
 
-bool header::from_data(reader& source, bool)
+template <typename Source>
+bool header::deserialize(Source& source)
 {
     ////reset();
 
@@ -218,12 +213,23 @@ bool header::from_data(reader& source, bool)
     return source;
 }
 
+bool header::from_data(reader& source, bool)
+{
+    return deserialize(source);
+}
+
+bool header::from_data(byte_reader& source, bool)
+{
+    return deserialize(source);
+}
+
 bool header::from_data(reader& source, hash_digest&& hash, bool wire)
 {
     if (!from_data(source, wire))
         return false;
 
-    hash_ = std::make_shared<hash_digest>(std::move(hash));
+    hash_.reset();
+    hash_.set(hash);
     return true;
 }
 
@@ -232,7 +238,8 @@ bool header::from_data(reader& source, const hash_digest& hash, bool wire)
     if (!from_data(source, wire))
         return false;
 
-    hash_ = std::make_shared<hash_digest>(hash);
+    hash_.reset();
+    hash_.set(hash);
     return true;
 }
 
@@ -273,6 +280,15 @@ data_chunk header::to_data(bool wire) const
     return data;
 }
 
+// The header is fixed size, so this avoids allocation for hashing.
+byte_array<80> header::to_array() const
+{
+    byte_array<80> data;
+    auto serial = make_unsafe_serializer(data.begin());
+    to_data(serial);
+    return data;
+}
+
 void header::to_data(std::ostream& stream, bool wire) const
 {
     ostream_writer sink(stream);
@@ -395,43 +411,15 @@ void header::set_nonce(uint32_t value)
 // protected
 void header::invalidate_cache() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (hash_)
-    {
-        mutex_.unlock_upgrade_and_lock();
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_.reset();
-        //---------------------------------------------------------------------
-        mutex_.unlock_and_lock_upgrade();
-    }
-
-    mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
+    hash_.reset();
 }
 
 hash_digest header::hash() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (!hash_)
+    return hash_.get([this]()
     {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        mutex_.unlock_upgrade_and_lock();
-        hash_ = std::make_shared<hash_digest>(bitcoin_hash(to_data()));
-        mutex_.unlock_and_lock_upgrade();
-        //---------------------------------------------------------------------
-    }
-
-    const auto hash = *hash_;
-    mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return hash;
+        return double_sha256_80(to_array());
+    });
 }
 
 // Validation helpers.
@@ -447,35 +435,53 @@ bool header::is_valid_timestamp(uint32_t timestamp_limit_seconds) const
     return time <= future;
 }
 
-bool header::is_valid_proof_of_work(uint32_t proof_of_work_limit,
-    bool scrypt) const
+// Compare little-endian 256 bit numbers, from the most significant byte.
+static bool is_less_or_equal(const hash_digest& left,
+    const hash_digest& right)
 {
-    const auto bits = compact(bits_);
-    static const uint256_t pow_limit(compact{ proof_of_work_limit });
+    for (auto byte = hash_size; byte-- > 0;)
+        if (left[byte] != right[byte])
+            return left[byte] < right[byte];
 
-    if (bits.is_overflowed())
-        return false;
+    return true;
+}
 
-    uint256_t target(bits);
+// static
+bool header::is_valid_proof_of_work(const hash_digest& hash, uint32_t bits,
+    uint32_t proof_of_work_limit)
+{
+    hash_digest target;
+    hash_digest limit;
+
+    if (!compact::to_target(target, bits) ||
+        !compact::to_target(limit, proof_of_work_limit))
+        return false;
 
     // Ensure claimed work is within limits.
-    if (target < 1 || target > pow_limit)
+    if (target == null_hash || !is_less_or_equal(target, limit))
         return false;
 
-    // Conditionally use scrypt proof of work (e.g. Litecoin).
     // Ensure actual work is at least claimed amount (smaller is more work).
-    return to_uint256(scrypt ? scrypt_hash(to_data()) : hash()) <= target;
+    return is_less_or_equal(hash, target);
+}
+
+bool header::is_valid_proof_of_work(uint32_t proof_of_work_limit,
+    bool scrypt) const
+{
+    // Conditionally use scrypt proof of work (e.g. Litecoin).
+    return is_valid_proof_of_work(scrypt ? scrypt_hash(to_data()) : hash(),
+        bits_, proof_of_work_limit);
 }
 
 // static
-uint256_t header::proof(uint32_t bits)
+uint256 header::proof(uint32_t bits)
 {
     const auto header_bits = compact(bits);
 
     if (header_bits.is_overflowed())
         return 0;
 
-    uint256_t target(header_bits);
+    const uint256& target = header_bits;
 
     //*************************************************************************
     // CONSENSUS: satoshi will throw division by zero in the case where the
@@ -492,12 +498,11 @@ uint256_t header::proof(uint32_t bits)
     return (divisor == 0) ? 0 : (~target / divisor) + 1;
 }
 
-uint256_t header::proof() const
+uint256 header::proof() const
 {
     return proof(bits_);
 }
 
-
 // Validation.
 //-----------------------------------------------------------------------------
 
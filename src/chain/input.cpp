@@ -162,8 +162,8 @@ input input::factory(reader& source, bool wire, bool witness)
 
 bool input::from_data(const data_chunk& data, bool wire, bool witness)
 {
-    data_source istream(data);
-    return from_data(istream, wire, witness);
+    auto source = make_byte_reader(data);
+    return from_data(source, wire, witness);
 }
 
 bool input::from_data(std::istream& stream, bool wire, bool witness)
@@ -172,7 +172,8 @@ bool input::from_data(std::istream& stream, bool wire, bool witness)
     return from_data(source, wire, witness);
 }
 
-bool input::from_data(reader& source, bool wire, bool witness)
+template <typename Source>
+bool input::deserialize(Source& source, bool wire, bool witness)
 {
     // Always write witness to store so that we know how to read it.
     witness |= !wire;
@@ -196,6 +197,16 @@ bool input::from_data(reader& source, bool wire, bool witness)
     return source;
 }
 
+bool input::from_data(reader& source, bool wire, bool witness)
+{
+    return deserialize(source, wire, witness);
+}
+
+bool input::from_data(byte_reader& source, bool wire, bool witness)
+{
+    return deserialize(source, wire, witness);
+}
+
 void input::reset()
 {
     previous_output_.reset();
@@ -0,0 +1,74 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/system/chain/median_time_window.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/system/constants.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace chain {
+
+median_time_window::median_time_window()
+  : ordered_(), sorted_(), size_(0), next_(0)
+{
+}
+
+void median_time_window::push(uint32_t timestamp)
+{
+    auto end = sorted_ + size_;
+
+    // Remove the oldest timestamp from the sorted values if full.
+    if (size_ == median_time_past_interval)
+    {
+        const auto oldest = std::lower_bound(sorted_, end, ordered_[next_]);
+        std::copy(oldest + 1, end, oldest);
+        --end;
+    }
+    else
+    {
+        ++size_;
+    }
+
+    // Insert the timestamp into the sorted values after any equal values.
+    const auto position = std::upper_bound(sorted_, end, timestamp);
+    std::copy_backward(position, end, end + 1);
+    *position = timestamp;
+
+    ordered_[next_] = timestamp;
+    next_ = (next_ + 1) % median_time_past_interval;
+}
+
+size_t median_time_window::size() const
+{
+    return size_;
+}
+
+// Consensus defines median time using modulo 2 element selection.
+// This differs from arithmetic median which averages two middle values.
+uint32_t median_time_window::median() const
+{
+    return size_ == 0 ? 0 : sorted_[size_ / 2];
+}
+
+} // namespace chain
+} // namespace system
+} // namespace libbitcoin
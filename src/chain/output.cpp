@@ -146,8 +146,8 @@ output output::factory(reader& source, bool wire)
 
 bool output::from_data(const data_chunk& data, bool wire)
 {
-    data_source istream(data);
-    return from_data(istream, wire);
+    auto source = make_byte_reader(data);
+    return from_data(source, wire);
 }
 
 bool output::from_data(std::istream& stream, bool wire)
@@ -156,7 +156,8 @@ bool output::from_data(std::istream& stream, bool wire)
     return from_data(source, wire);
 }
 
-bool output::from_data(reader& source, bool wire, bool)
+template <typename Source>
+bool output::deserialize(Source& source, bool wire)
 {
     reset();
 
@@ -180,6 +181,16 @@ bool output::from_data(reader& source, bool wire, bool)
     return source;
 }
 
+bool output::from_data(reader& source, bool wire, bool)
+{
+    return deserialize(source, wire);
+}
+
+bool output::from_data(byte_reader& source, bool wire, bool)
+{
+    return deserialize(source, wire);
+}
+
 // protected
 void output::reset()
 {
@@ -18,15 +18,19 @@
  */
 #include <bitcoin/system/chain/point.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <utility>
 #include <bitcoin/system/constants.hpp>
+#include <bitcoin/system/math/siphash.hpp>
 #include <bitcoin/system/message/messages.hpp>
 #include <bitcoin/system/utility/assert.hpp>
 #include <bitcoin/system/utility/container_sink.hpp>
 #include <bitcoin/system/utility/container_source.hpp>
+#include <bitcoin/system/utility/endian.hpp>
 #include <bitcoin/system/utility/istream_reader.hpp>
 #include <bitcoin/system/utility/ostream_writer.hpp>
+#include <bitcoin/system/utility/pseudo_random.hpp>
 
 namespace libbitcoin {
 namespace system {
@@ -150,8 +154,8 @@ point point::factory(reader& source, bool wire)
 
 bool point::from_data(const data_chunk& data, bool wire)
 {
-    data_source istream(data);
-    return from_data(istream, wire);
+    auto source = make_byte_reader(data);
+    return from_data(source, wire);
 }
 
 bool point::from_data(std::istream& stream, bool wire)
@@ -160,7 +164,8 @@ bool point::from_data(std::istream& stream, bool wire)
     return from_data(source, wire);
 }
 
-bool point::from_data(reader& source, bool wire)
+template <typename Source>
+bool point::deserialize(Source& source, bool wire)
 {
     reset();
 
@@ -186,6 +191,16 @@ bool point::from_data(reader& source, bool wire)
     return source;
 }
 
+bool point::from_data(reader& source, bool wire)
+{
+    return deserialize(source, wire);
+}
+
+bool point::from_data(byte_reader& source, bool wire)
+{
+    return deserialize(source, wire);
+}
+
 // protected
 void point::reset()
 {
@@ -316,5 +331,37 @@ bool point::is_null() const
 }
 
 } // namespace chain
+
+// digest_hasher<chain::point>
+//-----------------------------------------------------------------------------
+
+static siphash_key random_point_key()
+{
+    half_hash salt;
+    pseudo_random::fill(salt);
+    return to_siphash_key(salt);
+}
+
+digest_hasher<chain::point>::digest_hasher()
+  : key_(random_point_key())
+{
+}
+
+digest_hasher<chain::point>::digest_hasher(uint64_t salt)
+  : key_(salt, ~salt)
+{
+}
+
+size_t digest_hasher<chain::point>::operator()(const chain::point& key) const
+{
+    static BC_CONSTEXPR size_t size = hash_size + sizeof(uint32_t);
+    byte_array<size> message;
+    const auto& hash = key.hash();
+    const auto index = to_little_endian(key.index());
+    std::copy(hash.begin(), hash.end(), message.begin());
+    std::copy(index.begin(), index.end(), message.begin() + hash_size);
+    return static_cast<size_t>(siphash(key_, message));
+}
+
 } // namespace system
 } // namespace libbitcoin
@@ -35,11 +35,14 @@
 #include <bitcoin/system/math/hash.hpp>
 #include <bitcoin/system/machine/opcode.hpp>
 #include <bitcoin/system/machine/operation.hpp>
+#include <bitcoin/system/machine/operation_iterator.hpp>
 #include <bitcoin/system/machine/program.hpp>
 #include <bitcoin/system/machine/rule_fork.hpp>
 #include <bitcoin/system/machine/script_pattern.hpp>
 #include <bitcoin/system/machine/script_version.hpp>
 #include <bitcoin/system/machine/sighash_algorithm.hpp>
+#include <bitcoin/system/machine/view_interpreter.hpp>
+#include <bitcoin/system/machine/view_program.hpp>
 #include <bitcoin/system/message/messages.hpp>
 #include <bitcoin/system/utility/assert.hpp>
 #include <bitcoin/system/utility/container_sink.hpp>
@@ -47,6 +50,7 @@
 #include <bitcoin/system/utility/data.hpp>
 #include <bitcoin/system/utility/istream_reader.hpp>
 #include <bitcoin/system/utility/ostream_writer.hpp>
+#include <bitcoin/system/utility/sha256_writer.hpp>
 #include <bitcoin/system/utility/string.hpp>
 
 namespace libbitcoin {
@@ -66,6 +70,8 @@ static const auto one_hash = hash_literal(
 // A default instance is invalid (until modified).
 script::script()
   : cached_(false),
+    stripped_(false),
+    stripped_cached_(false),
     valid_(false)
 {
 }
@@ -73,6 +79,8 @@ script::script()
 script::script(script&& other)
   : operations_(std::move(other.operations_move())),
     cached_(!operations_.empty()),
+    stripped_(false),
+    stripped_cached_(false),
     bytes_(std::move(other.bytes_)),
     valid_(other.valid_)
 {
@@ -81,6 +89,8 @@ script::script(script&& other)
 script::script(const script& other)
   : operations_(other.operations_copy()),
     cached_(!operations_.empty()),
+    stripped_(false),
+    stripped_cached_(false),
     bytes_(other.bytes_),
     valid_(other.valid_)
 {
@@ -107,6 +117,7 @@ script::script(data_chunk&& encoded, bool prefix)
     // This is an optimization that avoids streaming the encoded bytes.
     bytes_ = std::move(encoded);
     cached_ = false;
+    stripped_cached_ = false;
     valid_ = true;
 }
 
@@ -137,6 +148,7 @@ script& script::operator=(script&& other)
 {
     operations_ = other.operations_move();
     cached_ = !operations_.empty();
+    stripped_cached_ = false;
     bytes_ = std::move(other.bytes_);
     valid_ = other.valid_;
     return *this;
@@ -147,6 +159,7 @@ script& script::operator=(const script& other)
 {
     operations_ = other.operations_copy();
     cached_ = !operations_.empty();
+    stripped_cached_ = false;
     bytes_ = other.bytes_;
     valid_ = other.valid_;
     return *this;
@@ -191,8 +204,8 @@ script script::factory(reader& source, bool prefix)
 
 bool script::from_data(const data_chunk& encoded, bool prefix)
 {
-    data_source istream(encoded);
-    return from_data(istream, prefix);
+    auto source = make_byte_reader(encoded);
+    return from_data(source, prefix);
 }
 
 bool script::from_data(std::istream& stream, bool prefix)
@@ -202,7 +215,8 @@ bool script::from_data(std::istream& stream, bool prefix)
 }
 
 // Concurrent read/write is not supported, so no critical section.
-bool script::from_data(reader& source, bool prefix)
+template <typename Source>
+bool script::deserialize(Source& source, bool prefix)
 {
     reset();
     valid_ = true;
@@ -229,6 +243,16 @@ bool script::from_data(reader& source, bool prefix)
     return source;
 }
 
+bool script::from_data(reader& source, bool prefix)
+{
+    return deserialize(source, prefix);
+}
+
+bool script::from_data(byte_reader& source, bool prefix)
+{
+    return deserialize(source, prefix);
+}
+
 // Concurrent read/write is not supported, so no critical section.
 bool script::from_string(const std::string& mnemonic)
 {
@@ -255,6 +279,7 @@ void script::from_operations(operation::list&& ops)
     bytes_ = operations_to_data(ops);
     operations_ = std::move(ops);
     cached_ = true;
+    stripped_cached_ = false;
     valid_ = true;
 }
 
@@ -265,6 +290,7 @@ void script::from_operations(const operation::list& ops)
     bytes_ = operations_to_data(ops);
     operations_ = ops;
     cached_ = true;
+    stripped_cached_ = false;
     valid_ = true;
 }
 
@@ -304,6 +330,7 @@ void script::reset()
     bytes_.shrink_to_fit();
     valid_ = false;
     cached_ = false;
+    stripped_cached_ = false;
     operations_.clear();
     operations_.shrink_to_fit();
 }
@@ -434,6 +461,11 @@ size_t script::serialized_size(bool prefix) const
     return size;
 }
 
+const data_chunk& script::bytes() const
+{
+    return bytes_;
+}
+
 // protected
 const operation::list& script::operations() const
 {
@@ -449,8 +481,7 @@ const operation::list& script::operations() const
     }
 
     operation op;
-    data_source istream(bytes_);
-    istream_reader source(istream);
+    auto source = make_byte_reader(bytes_);
     const auto size = bytes_.size();
 
     //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -484,20 +515,56 @@ const operation::list& script::operations() const
     return operations_;
 }
 
-// Signing (unversioned).
-//-----------------------------------------------------------------------------
+// The bytes are scanned once, without decoding operations.
+bool script::is_stripped() const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    mutex_.lock_upgrade();
 
-inline hash_digest signature_hash(const transaction& tx, uint32_t sighash_type)
+    if (stripped_cached_)
+    {
+        const auto stripped = stripped_;
+        mutex_.unlock_upgrade();
+        //---------------------------------------------------------------------
+        return stripped;
+    }
+
+    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+    mutex_.unlock_upgrade_and_lock();
+
+    auto stripped = true;
+    operation_iterator op(bytes_);
+
+    while (stripped && op.next())
+        stripped = op.is_valid() && op.code() != opcode::codeseparator;
+
+    stripped_ = stripped;
+    stripped_cached_ = true;
+
+    mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    return stripped;
+}
+
+// private
+// Once cached the operations are immutable, so the lock need not be retained.
+bool script::is_decoded() const
 {
-    // There is no rational interpretation of a signature hash for a coinbase.
-    BITCOIN_ASSERT(!tx.is_coinbase());
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    mutex_.lock_shared();
+    const auto decoded = cached_;
+    mutex_.unlock_shared();
+    ///////////////////////////////////////////////////////////////////////////
 
-    // TODO: pass overallocated stream buffer to serializer (optimization).
-    auto serialized = tx.to_data(true, false);
-    extend_data(serialized, to_little_endian(sighash_type));
-    return bitcoin_hash(serialized);
+    return decoded;
 }
 
+// Signing (unversioned).
+//-----------------------------------------------------------------------------
+
 //*****************************************************************************
 // CONSENSUS: Due to masking of bits 6/7 (8 is the anyone_can_pay flag),
 // there are 4 possible 7 bit values that can set "single" and 4 others that
@@ -516,109 +583,148 @@ inline sighash_algorithm to_sighash_enum(uint8_t sighash_type)
     }
 }
 
-static hash_digest sign_none(const transaction& tx, uint32_t input_index,
-    const script& script_code, uint8_t sighash_type)
+//*****************************************************************************
+// CONSENSUS: more wacky satoshi behavior.
+//*****************************************************************************
+// Write the prefixed script code with any code separators removed. This is
+// the serialization of the reconstructed operations, which differs from the
+// script bytes only if there is a separator or an invalid (last) operation.
+static void write_stripped(writer& sink, const script& script_code)
 {
-    input::list ins;
-    const auto& inputs = tx.inputs();
-    const auto any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
-    ins.reserve(any ? 1 : inputs.size());
-
-    BITCOIN_ASSERT(input_index < inputs.size());
-    const auto& self = inputs[input_index];
-
-    if (any)
+    if (script_code.is_stripped())
     {
-        // Retain only self.
-        ins.emplace_back(self.previous_output(), script_code, self.sequence());
+        const auto& bytes = script_code.bytes();
+        sink.write_size_little_endian(bytes.size());
+        sink.write_bytes(bytes);
+        return;
     }
-    else
+
+    const auto sum = [](size_t total, const operation& op)
     {
-        // Erase all input scripts and sequences.
-        for (const auto& input: inputs)
-            ins.emplace_back(input.previous_output(), script{}, 0);
+        return op.code() == opcode::codeseparator ? total :
+            total + op.serialized_size();
+    };
 
-        // Replace self that is lost in the loop.
-        ins[input_index].set_script(script_code);
-        ins[input_index].set_sequence(self.sequence());
-    }
+    const auto& ops = script_code.operations();
+    sink.write_size_little_endian(std::accumulate(ops.begin(), ops.end(),
+        size_t(0), sum));
 
-    // Move new inputs to new transaction and drop outputs.
-    return signature_hash({ tx.version(), tx.locktime(), std::move(ins), {} },
-        sighash_type);
+    for (const auto& op: ops)
+        if (op.code() != opcode::codeseparator)
+            op.to_data(sink);
 }
 
-static hash_digest sign_single(const transaction& tx, uint32_t input_index,
-    const script& script_code, uint8_t sighash_type)
+// Write the inputs of the signature hash preimage, with all input scripts
+// erased except that of self, and with the sequences of others optionally
+// zeroized. If anyone_can_pay is set only self is retained.
+static void write_inputs(writer& sink, const transaction& tx,
+    uint32_t input_index, const script& script_code, bool any,
+    bool sequences)
 {
-    input::list ins;
     const auto& inputs = tx.inputs();
-    const auto any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
-    ins.reserve(any ? 1 : inputs.size());
-
     BITCOIN_ASSERT(input_index < inputs.size());
     const auto& self = inputs[input_index];
 
     if (any)
     {
         // Retain only self.
-        ins.emplace_back(self.previous_output(), script_code, self.sequence());
+        sink.write_size_little_endian(1);
+        self.previous_output().to_data(sink);
+        write_stripped(sink, script_code);
+        sink.write_4_bytes_little_endian(self.sequence());
+        return;
     }
-    else
+
+    sink.write_size_little_endian(inputs.size());
+
+    for (uint32_t index = 0; index < inputs.size(); ++index)
     {
-        // Erase all input scripts and sequences.
-        for (const auto& input: inputs)
-            ins.emplace_back(input.previous_output(), script{}, 0);
+        const auto& input = inputs[index];
+        input.previous_output().to_data(sink);
 
-        // Replace self that is lost in the loop.
-        ins[input_index].set_script(script_code);
-        ins[input_index].set_sequence(self.sequence());
+        if (index == input_index)
+        {
+            write_stripped(sink, script_code);
+            sink.write_4_bytes_little_endian(self.sequence());
+        }
+        else
+        {
+            // Erase all other input scripts (and sequences if specified).
+            sink.write_size_little_endian(0);
+            sink.write_4_bytes_little_endian(sequences ? input.sequence() : 0);
+        }
     }
+}
+
+// The sighash serializations are streamed into the hash, so that neither the
+// transaction nor the script code is reconstructed (no allocation).
+static hash_digest sign_none(const transaction& tx, uint32_t input_index,
+    const script& script_code, uint8_t sighash_type)
+{
+    sha256_context context;
+    sha256_writer sink(context);
+    const auto any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
+
+    sink.write_4_bytes_little_endian(tx.version());
+    write_inputs(sink, tx, input_index, script_code, any, false);
+
+    // Drop outputs.
+    sink.write_size_little_endian(0);
+
+    sink.write_4_bytes_little_endian(tx.locktime());
+    sink.write_4_bytes_little_endian(sighash_type);
+    return context.double_hash();
+}
+
+static hash_digest sign_single(const transaction& tx, uint32_t input_index,
+    const script& script_code, uint8_t sighash_type)
+{
+    sha256_context context;
+    sha256_writer sink(context);
+    const auto any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
+
+    sink.write_4_bytes_little_endian(tx.version());
+    write_inputs(sink, tx, input_index, script_code, any, false);
 
     // Trim and clear outputs except that of specified input index.
     const auto& outputs = tx.outputs();
-    output::list outs(input_index + 1);
-
     BITCOIN_ASSERT(input_index < outputs.size());
-    outs.back() = outputs[input_index];
+    sink.write_size_little_endian(input_index + 1u);
 
-    // Move new inputs and new outputs to new transaction.
-    return signature_hash({ tx.version(), tx.locktime(), std::move(ins),
-        std::move(outs) }, sighash_type);
+    for (uint32_t index = 0; index < input_index; ++index)
+    {
+        // A default output has the null value (-1) and an empty script.
+        sink.write_8_bytes_little_endian(output::not_found);
+        sink.write_size_little_endian(0);
+    }
+
+    outputs[input_index].to_data(sink);
+
+    sink.write_4_bytes_little_endian(tx.locktime());
+    sink.write_4_bytes_little_endian(sighash_type);
+    return context.double_hash();
 }
 
 static hash_digest sign_all(const transaction& tx, uint32_t input_index,
     const script& script_code, uint8_t sighash_type)
 {
-    input::list ins;
-    const auto& inputs = tx.inputs();
+    sha256_context context;
+    sha256_writer sink(context);
     const auto any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
-    ins.reserve(any ? 1 : inputs.size());
 
-    BITCOIN_ASSERT(input_index < inputs.size());
-    const auto& self = inputs[input_index];
+    sink.write_4_bytes_little_endian(tx.version());
+    write_inputs(sink, tx, input_index, script_code, any, true);
 
-    if (any)
-    {
-        // Retain only self.
-        ins.emplace_back(self.previous_output(), script_code, self.sequence());
-    }
-    else
-    {
-        // Erase all input scripts.
-        for (const auto& input: inputs)
-            ins.emplace_back(input.previous_output(), script{},
-                input.sequence());
-
-        // Replace self that is lost in the loop.
-        ins[input_index].set_script(script_code);
-        ////ins[input_index].set_sequence(self.sequence());
-    }
+    // Retain all outputs.
+    const auto& outputs = tx.outputs();
+    sink.write_size_little_endian(outputs.size());
 
-    // Move new inputs and copy outputs to new transaction.
-    transaction out(tx.version(), tx.locktime(), input::list{}, tx.outputs());
-    out.set_inputs(std::move(ins));
-    return signature_hash(out, sighash_type);
+    for (const auto& output: outputs)
+        output.to_data(sink);
+
+    sink.write_4_bytes_little_endian(tx.locktime());
+    sink.write_4_bytes_little_endian(sighash_type);
+    return context.double_hash();
 }
 
 static bool is_index_overflow(const transaction& tx, uint32_t input_index,
@@ -629,18 +735,6 @@ static bool is_index_overflow(const transaction& tx, uint32_t input_index,
             sighash == sighash_algorithm::single);
 }
 
-// TODO: optimize to prevent script reconstruction.
-static script strip_code_seperators(const script& script_code)
-{
-    operation::list ops;
-
-    for (auto op = script_code.begin(); op != script_code.end(); ++op)
-        if (op->code() != opcode::codeseparator)
-            ops.push_back(*op);
-
-    return { std::move(ops) };
-}
-
 // private/static
 hash_digest script::generate_unversioned_signature_hash(const transaction& tx,
     uint32_t input_index, const script& script_code, uint8_t sighash_type)
@@ -653,21 +747,19 @@ hash_digest script::generate_unversioned_signature_hash(const transaction& tx,
     if (is_index_overflow(tx, input_index, sighash))
         return one_hash;
 
-    //*************************************************************************
-    // CONSENSUS: more wacky satoshi behavior.
-    //*************************************************************************
-    const auto stripped = strip_code_seperators(script_code);
+    // There is no rational interpretation of a signature hash for a coinbase.
+    BITCOIN_ASSERT(!tx.is_coinbase());
 
     // The sighash serializations are isolated for clarity and optimization.
     switch (sighash)
     {
         case sighash_algorithm::none:
-            return sign_none(tx, input_index, stripped, sighash_type);
+            return sign_none(tx, input_index, script_code, sighash_type);
         case sighash_algorithm::single:
-            return sign_single(tx, input_index, stripped, sighash_type);
+            return sign_single(tx, input_index, script_code, sighash_type);
         default:
         case sighash_algorithm::all:
-            return sign_all(tx, input_index, stripped, sighash_type);
+            return sign_all(tx, input_index, script_code, sighash_type);
     }
 }
 
@@ -749,18 +841,12 @@ data_chunk script::to_sequences(const transaction& tx)
     return data;
 }
 
-static size_t version_0_preimage_size(size_t script_size)
+static hash_digest to_output_hash(const output& output)
 {
-    return sizeof(uint32_t)
-        + hash_size
-        + hash_size
-        + point::satoshi_fixed_size()
-        + script_size
-        + sizeof(uint64_t)
-        + sizeof(uint32_t)
-        + hash_size
-        + sizeof(uint32_t)
-        + sizeof(uint32_t);
+    sha256_context context;
+    sha256_writer sink(context);
+    output.to_data(sink, true);
+    return context.double_hash();
 }
 
 // private/static
@@ -778,22 +864,13 @@ hash_digest script::generate_version_0_signature_hash(const transaction& tx,
     // Unlike unversioned algorithm this does not allow an invalid input index.
     BITCOIN_ASSERT(input_index < tx.inputs().size());
     const auto& input = tx.inputs()[input_index];
-    const auto script_size = script_code.serialized_size(true);
-    const auto size = version_0_preimage_size(script_size);
-
-    data_chunk data;
-    data.reserve(size);
-    data_sink ostream(data);
-    ostream_writer sink(ostream);
 
     // 1. transaction version (4).
-    sink.write_little_endian(tx.version());
-
     // 2. inpoints double sha256 hash (32).
-    sink.write_hash(!any ? tx.inpoints_hash() : null_hash);
-
     // 3. sequences double sha256 hash (32).
-    sink.write_hash(!any && all ? tx.sequences_hash() : null_hash);
+    // The hash midstate of this prefix is shared by all inputs of the tx.
+    auto context = tx.version_0_prefix(!any, !any && all);
+    sha256_writer sink(context);
 
     // 4. outpoint (32-byte hash + 4-byte little endian).
     input.previous_output().to_data(sink);
@@ -810,7 +887,7 @@ hash_digest script::generate_version_0_signature_hash(const transaction& tx,
     // 8. outputs (or output) double hash, or null hash (32).
     sink.write_hash(all ? tx.outputs_hash() :
         (single && input_index < tx.outputs().size() ?
-            bitcoin_hash(tx.outputs()[input_index].to_data()) : null_hash));
+            to_output_hash(tx.outputs()[input_index]) : null_hash));
 
     // 9. transaction locktime (4).
     sink.write_little_endian(tx.locktime());
@@ -818,9 +895,7 @@ hash_digest script::generate_version_0_signature_hash(const transaction& tx,
     // 10. hash type of the signature (4 [not 1]).
     sink.write_4_bytes_little_endian(sighash_type);
 
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == size);
-    return bitcoin_hash(data);
+    return context.double_hash();
 }
 
 // Signing (unversioned and version 0).
@@ -1198,6 +1273,158 @@ operation::list script::to_pay_witness_script_hash_pattern(const hash_digest& ha
     };
 }
 
+// Utilities (raw).
+//-----------------------------------------------------------------------------
+// These match the operation::list patterns above over the serialized script,
+// avoiding the allocation of operations for scripts that are only classified.
+
+namespace raw {
+
+inline bool is_endorsement_size(const data_slice& data)
+{
+    return data.size() >= min_endorsement_size
+        && data.size() <= max_endorsement_size;
+}
+
+static bool is_witness_program_pattern(const data_slice& bytes)
+{
+    operation_iterator op(bytes);
+    return op.next() && op.is_version()
+        && op.next() && op.data().size() >= min_witness_program
+            && op.data().size() <= max_witness_program
+        && !op.next();
+}
+
+static bool is_pay_null_data_pattern(const data_slice& bytes)
+{
+    operation_iterator op(bytes);
+    return op.next() && op.code() == opcode::return_
+        && op.next() && op.is_minimal_push()
+            && op.data().size() <= max_null_data_size
+        && !op.next();
+}
+
+static bool is_pay_multisig_pattern(const data_slice& bytes)
+{
+    static constexpr auto op_1 = static_cast<uint8_t>(opcode::push_positive_1);
+    static constexpr auto op_16 = static_cast<uint8_t>(opcode::push_positive_16);
+
+    operation_iterator op(bytes);
+
+    if (!op.next())
+        return false;
+
+    const auto op_m = static_cast<uint8_t>(op.code());
+
+    if (op_m < op_1 || op_m > op_16)
+        return false;
+
+    // Each public key is confirmed once it is followed by two operations.
+    size_t count = 1;
+    auto last = opcode::disabled_xor;
+    auto prior = opcode::disabled_xor;
+    auto key = true;
+    auto last_key = true;
+
+    while (op.next())
+    {
+        if (++count > 19 || !key)
+            return false;
+
+        key = last_key;
+        last_key = is_public_key(op.data());
+        prior = last;
+        last = op.code();
+    }
+
+    if (count < 4 || last != opcode::checkmultisig)
+        return false;
+
+    const auto op_n = static_cast<uint8_t>(prior);
+
+    if (op_m > op_n || op_n < op_1 || op_n > op_16)
+        return false;
+
+    return op_n - op_1 + 1u == count - 3u;
+}
+
+static bool is_pay_public_key_pattern(const data_slice& bytes)
+{
+    operation_iterator op(bytes);
+    return op.next() && is_public_key(op.data())
+        && op.next() && op.code() == opcode::checksig
+        && !op.next();
+}
+
+static bool is_pay_key_hash_pattern(const data_slice& bytes)
+{
+    operation_iterator op(bytes);
+    return op.next() && op.code() == opcode::dup
+        && op.next() && op.code() == opcode::hash160
+        && op.next() && op.data().size() == short_hash_size
+        && op.next() && op.code() == opcode::equalverify
+        && op.next() && op.code() == opcode::checksig
+        && !op.next();
+}
+
+static bool is_pay_script_hash_pattern(const data_slice& bytes)
+{
+    operation_iterator op(bytes);
+    return op.next() && op.code() == opcode::hash160
+        && op.next() && op.code() == opcode::push_size_20
+        && op.next() && op.code() == opcode::equal
+        && !op.next();
+}
+
+static bool is_sign_multisig_pattern(const data_slice& bytes)
+{
+    operation_iterator op(bytes);
+
+    if (!op.next() || op.code() != opcode::push_size_0 || !op.next())
+        return false;
+
+    do
+    {
+        if (!is_endorsement_size(op.data()))
+            return false;
+    } while (op.next());
+
+    return true;
+}
+
+static bool is_sign_public_key_pattern(const data_slice& bytes)
+{
+    operation_iterator op(bytes);
+    return op.next() && is_endorsement_size(op.data())
+        && !op.next();
+}
+
+static bool is_sign_key_hash_pattern(const data_slice& bytes)
+{
+    operation_iterator op(bytes);
+    return op.next() && is_endorsement_size(op.data())
+        && op.next() && is_public_key(op.data())
+        && !op.next();
+}
+
+static bool is_sign_script_hash_pattern(const data_slice& bytes)
+{
+    operation_iterator op(bytes);
+    auto empty = true;
+
+    while (op.next())
+    {
+        if (!op.is_push())
+            return false;
+
+        empty = op.data().empty();
+    }
+
+    return !empty;
+}
+
+} // namespace raw
+
 // Utilities (non-static).
 //-----------------------------------------------------------------------------
 
@@ -1212,13 +1439,24 @@ const data_chunk& script::witness_program() const
 
 script_version script::version() const
 {
-    // The first operations access must be method-based to guarantee the cache.
-    const auto& ops = operations();
+    opcode code;
 
-    if (!is_witness_program_pattern(ops))
-        return script_version::unversioned;
+    if (is_decoded())
+    {
+        if (!is_witness_program_pattern(operations_))
+            return script_version::unversioned;
 
-    switch (ops[0].code())
+        code = operations_[0].code();
+    }
+    else
+    {
+        if (!raw::is_witness_program_pattern(bytes_))
+            return script_version::unversioned;
+
+        code = static_cast<opcode>(bytes_.front());
+    }
+
+    switch (code)
     {
         case opcode::push_size_0:
             return script_version::zero;
@@ -1239,8 +1477,11 @@ script_pattern script::pattern() const
 // The bip141 coinbase pattern is not tested here, must test independently.
 script_pattern script::output_pattern() const
 {
-    // The first operations access must be method-based to guarantee the cache.
-    if (is_pay_key_hash_pattern(operations()))
+    // Operations are not decoded for classification if not already cached.
+    if (!is_decoded())
+        return output_pattern(bytes_);
+
+    if (is_pay_key_hash_pattern(operations_))
         return script_pattern::pay_key_hash;
 
     if (is_pay_script_hash_pattern(operations_))
@@ -1263,8 +1504,11 @@ script_pattern script::output_pattern() const
 // The bip34 coinbase pattern is not tested here, must test independently.
 script_pattern script::input_pattern() const
 {
-    // The first operations access must be method-based to guarantee the cache.
-    if (is_sign_key_hash_pattern(operations()))
+    // Operations are not decoded for classification if not already cached.
+    if (!is_decoded())
+        return input_pattern(bytes_);
+
+    if (is_sign_key_hash_pattern(operations_))
         return script_pattern::sign_key_hash;
 
     // This must follow is_sign_key_hash_pattern for ambiguity comment to hold.
@@ -1280,20 +1524,63 @@ script_pattern script::input_pattern() const
     return script_pattern::non_standard;
 }
 
+// static
+script_pattern script::output_pattern(const data_slice& bytes)
+{
+    if (raw::is_pay_key_hash_pattern(bytes))
+        return script_pattern::pay_key_hash;
+
+    if (raw::is_pay_script_hash_pattern(bytes))
+        return script_pattern::pay_script_hash;
+
+    if (raw::is_pay_null_data_pattern(bytes))
+        return script_pattern::pay_null_data;
+
+    if (raw::is_pay_public_key_pattern(bytes))
+        return script_pattern::pay_public_key;
+
+    if (raw::is_pay_multisig_pattern(bytes))
+        return script_pattern::pay_multisig;
+
+    return script_pattern::non_standard;
+}
+
+// static
+script_pattern script::input_pattern(const data_slice& bytes)
+{
+    if (raw::is_sign_key_hash_pattern(bytes))
+        return script_pattern::sign_key_hash;
+
+    if (raw::is_sign_script_hash_pattern(bytes))
+        return script_pattern::sign_script_hash;
+
+    if (raw::is_sign_public_key_pattern(bytes))
+        return script_pattern::sign_public_key;
+
+    if (raw::is_sign_multisig_pattern(bytes))
+        return script_pattern::sign_multisig;
+
+    return script_pattern::non_standard;
+}
+
 bool script::is_pay_to_witness(uint32_t forks) const
 {
     // This is used internally as an optimization over using script::pattern.
-    // The first operations access must be method-based to guarantee the cache.
-    return is_enabled(forks, rule_fork::bip141_rule) &&
-        is_witness_program_pattern(operations());
+    if (!is_enabled(forks, rule_fork::bip141_rule))
+        return false;
+
+    return is_decoded() ? is_witness_program_pattern(operations_) :
+        raw::is_witness_program_pattern(bytes_);
 }
 
 bool script::is_pay_to_script_hash(uint32_t forks) const
 {
     // This is used internally as an optimization over using script::pattern.
-    // The first operations access must be method-based to guarantee the cache.
-    return is_enabled(forks, rule_fork::bip16_rule) &&
-        is_pay_script_hash_pattern(operations());
+    if (!is_enabled(forks, rule_fork::bip16_rule))
+        return false;
+
+    return is_decoded() ? is_pay_script_hash_pattern(operations_) :
+        raw::is_pay_script_hash_pattern(bytes_);
 }
 
 // Count 1..16 multisig accurately for embedded (bip16) and witness (bip141).
@@ -1303,31 +1590,43 @@ inline size_t multisig_sigops(bool accurate, opcode code)
         operation::opcode_to_positive(code) : multisig_default_sigops;
 }
 
+inline void count_sigops(size_t& total, opcode& preceding, opcode code,
+    bool accurate)
+{
+    if (code == opcode::checksig ||
+        code == opcode::checksigverify)
+    {
+        ++total;
+    }
+    else if (
+        code == opcode::checkmultisig ||
+        code == opcode::checkmultisigverify)
+    {
+        total += multisig_sigops(accurate, preceding);
+    }
+
+    preceding = code;
+}
+
 size_t script::sigops(bool accurate) const
 {
     size_t total = 0;
     auto preceding = opcode::push_negative_1;
 
-    // The first operations access must be method-based to guarantee the cache.
-    for (const auto& op: operations())
+    if (is_decoded())
     {
-        const auto code = op.code();
+        for (const auto& op: operations_)
+            count_sigops(total, preceding, op.code(), accurate);
 
-        if (code == opcode::checksig ||
-            code == opcode::checksigverify)
-        {
-            ++total;
-        }
-        else if (
-            code == opcode::checkmultisig ||
-            code == opcode::checkmultisigverify)
-        {
-            total += multisig_sigops(accurate, preceding);
-        }
-
-        preceding = code;
+        return total;
     }
 
+    // Sigops depend only upon opcodes, so the script is not decoded for them.
+    operation_iterator op(bytes_);
+
+    while (op.next())
+        count_sigops(total, preceding, op.code(), accurate);
+
     return total;
 }
 
@@ -1348,8 +1647,7 @@ void script::find_and_delete_(const data_chunk& endorsement)
     const auto value = operation(endorsement, false).to_data();
 
     operation op;
-    data_source stream(bytes_);
-    istream_reader source(stream);
+    auto source = make_byte_reader(bytes_);
     std::vector<data_chunk::iterator> found;
 
     // The exhaustion test handles stream end and op deserialization failure.
@@ -1381,9 +1679,56 @@ void script::find_and_delete(const data_stack& endorsements)
     // Invalidate the cache so that the operations may be regenerated.
     operations_.clear();
     cached_ = false;
+    stripped_cached_ = false;
     bytes_.shrink_to_fit();
 }
 
+// True if find_and_delete of the endorsement would modify the script. The
+// endorsement is serialized as a non-minimal push and matched at any offset.
+bool script::is_found(const data_slice& endorsement) const
+{
+    const auto size = endorsement.size();
+    const auto code = operation::opcode_from_size(size);
+
+    uint8_t prefix[1 + sizeof(uint32_t)];
+    auto prefix_size = size_t(1);
+    prefix[0] = static_cast<uint8_t>(code);
+
+    switch (code)
+    {
+        case opcode::push_one_size:
+            prefix[prefix_size++] = static_cast<uint8_t>(size);
+            break;
+        case opcode::push_two_size:
+            prefix[prefix_size++] = static_cast<uint8_t>(size);
+            prefix[prefix_size++] = static_cast<uint8_t>(size >> 8);
+            break;
+        case opcode::push_four_size:
+            prefix[prefix_size++] = static_cast<uint8_t>(size);
+            prefix[prefix_size++] = static_cast<uint8_t>(size >> 8);
+            prefix[prefix_size++] = static_cast<uint8_t>(size >> 16);
+            prefix[prefix_size++] = static_cast<uint8_t>(size >> 24);
+            break;
+        default:
+            break;
+    }
+
+    const auto total = prefix_size + size;
+
+    if (bytes_.size() < total)
+        return false;
+
+    const auto last = bytes_.end() - total;
+
+    for (auto it = bytes_.begin(); it <= last; ++it)
+        if (std::equal(prefix, prefix + prefix_size, it) &&
+            std::equal(endorsement.begin(), endorsement.end(),
+                it + prefix_size))
+            return true;
+
+    return false;
+}
+
 ////// This is slightly more efficient because the script does not get parsed,
 ////// but the static template implementation is more self-explanatory.
 ////bool script::is_coinbase_pattern(size_t height) const
@@ -1408,30 +1753,45 @@ bool script::is_oversized() const
 // The criteria below are not be comprehensive but are fast to evaluate.
 bool script::is_unspendable() const
 {
-    // The first operations access must be method-based to guarantee the cache.
-    return !operations().empty() && operations_[0].code() == opcode::return_;
+    // The first opcode is the first byte, whether or not decoded.
+    return !bytes_.empty() &&
+        bytes_.front() == static_cast<uint8_t>(opcode::return_);
 }
 
 // Validation.
 //-----------------------------------------------------------------------------
 
+// A batch defers signature checks that can only fail the script. The input
+// script result is not final, as it is the initial prevout script stack.
 code script::verify(const transaction& tx, uint32_t input_index,
-    uint32_t forks, const script& prevout_script, uint64_t value)
+    uint32_t forks, const script& prevout_script, uint64_t value,
+    machine::signature_batch* batch, bool views)
 {
     if (input_index >= tx.inputs().size())
         return error::operation_failed;
 
+    // Standard spends may be evaluated over stack views, without allocation.
+    if (views && is_view_supported(tx, input_index, forks, prevout_script))
+        return verify_views(tx, input_index, forks, prevout_script, value,
+            batch);
+
     code ec;
     bool witnessed;
     const auto& in = tx.inputs()[input_index];
 
     // Evaluate input script.
     program input(in.script(), tx, input_index, forks);
+    if (batch != nullptr)
+        input.set_batch(*batch, false);
+
     if ((ec = input.evaluate()))
         return ec;
 
     // Evaluate output script using stack result from input script.
     program prevout(prevout_script, input);
+    if (batch != nullptr)
+        prevout.set_batch(*batch, true);
+
     if ((ec = prevout.evaluate()))
         return ec;
 
@@ -1448,7 +1808,7 @@ code script::verify(const transaction& tx, uint32_t input_index,
 
         // Validate the native script.
         if ((ec = in.witness().verify(tx, input_index, forks, prevout_script,
-            value)))
+            value, batch)))
             return ec;
     }
 
@@ -1462,6 +1822,9 @@ code script::verify(const transaction& tx, uint32_t input_index,
         script embedded_script(input.pop(), false);
 
         program embedded(embedded_script, std::move(input), true);
+        if (batch != nullptr)
+            embedded.set_batch(*batch, true);
+
         if ((ec = embedded.evaluate()))
             return ec;
 
@@ -1478,7 +1841,7 @@ code script::verify(const transaction& tx, uint32_t input_index,
 
             // Validate the non-native script.
             if ((ec = in.witness().verify(tx, input_index, forks,
-                embedded_script, value)))
+                embedded_script, value, batch)))
                 return ec;
         }
     }
@@ -1490,15 +1853,149 @@ code script::verify(const transaction& tx, uint32_t input_index,
     return error::success;
 }
 
+// The witness program of a witness script, obtained without decoding.
+static data_slice to_witness_program(const data_chunk& bytes)
+{
+    operation_iterator op(bytes);
+    op.next();
+    op.next();
+    return op.data();
+}
+
+// private/static
+// Scripts are evaluated by view_interpreter if all are supported and none is
+// embedded (p2sh), as the embedded script is known only after evaluation.
+bool script::is_view_supported(const transaction& tx, uint32_t input_index,
+    uint32_t forks, const script& prevout_script)
+{
+    const auto& in = tx.inputs()[input_index];
+
+    if (!view_interpreter::is_supported(in.script().bytes()) ||
+        !view_interpreter::is_supported(prevout_script.bytes()))
+        return false;
+
+    if (prevout_script.is_pay_to_witness(forks))
+    {
+        if (prevout_script.version() != script_version::zero)
+            return false;
+
+        const auto& stack = in.witness().stack();
+
+        switch (to_witness_program(prevout_script.bytes()).size())
+        {
+            case short_hash_size:
+                return true;
+            case hash_size:
+                return !stack.empty() &&
+                    view_interpreter::is_supported(stack.back());
+            default:
+                return false;
+        }
+    }
+
+    return !prevout_script.is_pay_to_script_hash(forks);
+}
+
+// private/static
+// This is script::verify and witness::verify over view_program, restricted
+// to the scripts accepted by is_view_supported.
+code script::verify_views(const transaction& tx, uint32_t input_index,
+    uint32_t forks, const script& prevout_script, uint64_t value,
+    machine::signature_batch* batch)
+{
+    code ec;
+    const auto& in = tx.inputs()[input_index];
+
+    // Evaluate input script.
+    view_program input(in.script(), tx, input_index, forks);
+    if (batch != nullptr)
+        input.set_batch(*batch, false);
+
+    if ((ec = input.evaluate()))
+        return ec;
+
+    // Evaluate output script using stack result from input script.
+    view_program prevout(prevout_script, input);
+    if (batch != nullptr)
+        prevout.set_batch(*batch, true);
+
+    if ((ec = prevout.evaluate()))
+        return ec;
+
+    // This precludes bare witness programs of -0 (undocumented).
+    if (!prevout.stack_result(false))
+        return error::stack_false;
+
+    // Triggered by output script push of version and witness program (bip141).
+    if (!prevout_script.is_pay_to_witness(forks))
+        return in.witness().empty() ? error::success :
+            error::unexpected_witness;
+
+    // The input script must be empty (bip141).
+    if (!in.script().empty())
+        return error::dirty_witness;
+
+    script witness_script;
+    const auto& stack = in.witness().stack();
+    const auto program = to_witness_program(prevout_script.bytes());
+
+    // p2wkh
+    if (program.size() == short_hash_size)
+    {
+        // Stack must be 2 elements (bip141).
+        if (stack.size() != 2)
+            return error::invalid_witness;
+
+        // Create a pay-to-key-hash input script from the program.
+        data_chunk key_hash_script;
+        key_hash_script.reserve(program.size() + 5u);
+        key_hash_script.push_back(static_cast<uint8_t>(opcode::dup));
+        key_hash_script.push_back(static_cast<uint8_t>(opcode::hash160));
+        key_hash_script.push_back(static_cast<uint8_t>(opcode::push_size_20));
+        extend_data(key_hash_script, program);
+        key_hash_script.push_back(static_cast<uint8_t>(opcode::equalverify));
+        key_hash_script.push_back(static_cast<uint8_t>(opcode::checksig));
+        witness_script.from_data(key_hash_script, false);
+    }
+
+    // p2wsh
+    else
+    {
+        // The sha256 of popped script must match program (bip141).
+        const auto hash = sha256_hash(stack.back());
+        if (!std::equal(program.begin(), program.end(), hash.begin()))
+            return error::invalid_witness;
+
+        witness_script.from_data(stack.back(), false);
+    }
+
+    view_program witness(witness_script, tx, input_index, forks, stack,
+        value, script_version::zero);
+
+    // Input script is popped from the stack (bip141).
+    if (program.size() == hash_size)
+        witness.pop();
+
+    if (batch != nullptr)
+        witness.set_batch(*batch, true);
+
+    if ((ec = witness.evaluate()))
+        return ec;
+
+    // A v0 script must succeed with a clean true stack (bip141).
+    return witness.stack_result(true) ? error::success : error::stack_false;
+}
+
 code script::verify(const transaction& tx, uint32_t input_index,
-    uint32_t forks)
+    uint32_t forks, machine::signature_batch* batch, bool views)
 {
     if (input_index >= tx.inputs().size())
         return error::operation_failed;
 
     const auto& in = tx.inputs()[input_index];
     const auto& prevout = in.previous_output().metadata.cache;
-    return verify(tx, input_index, forks, prevout.script(), prevout.value());
+    return verify(tx, input_index, forks, prevout.script(), prevout.value(),
+        batch, views);
 }
 
 } // namespace chain
@@ -0,0 +1,165 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/system/chain/script_cache.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/math/siphash.hpp>
+#include <bitcoin/system/utility/pseudo_random.hpp>
+#include <bitcoin/system/utility/thread.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace chain {
+
+// The initial bucket count, the set grows as required.
+static constexpr size_t initial_buckets = 16;
+
+static siphash_key random_key()
+{
+    half_hash salt;
+    pseudo_random::fill(salt);
+    return to_siphash_key(salt);
+}
+
+script_cache::key_hasher::key_hasher(const siphash_key& key)
+  : key(key)
+{
+}
+
+// Forks are not chosen by a peer, so they are mixed in without salt.
+size_t script_cache::key_hasher::operator()(const entry& value) const
+{
+    return static_cast<size_t>(siphash(key, value.first) ^ value.second);
+}
+
+script_cache::script_cache(size_t capacity)
+  : capacity_(capacity),
+    next_(0),
+    keys_(initial_buckets, key_hasher(random_key())),
+    hits_(0),
+    misses_(0)
+{
+}
+
+bool script_cache::contains(const hash_digest& witness_hash,
+    uint32_t forks) const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+
+    if (capacity_ == 0)
+        return false;
+
+    const auto found = keys_.find({ witness_hash, forks }) != keys_.end();
+    lock.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    ++(found ? hits_ : misses_);
+    return found;
+}
+
+void script_cache::store(const hash_digest& witness_hash, uint32_t forks)
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+
+    if (capacity_ == 0)
+        return;
+
+    // Entries verified under other forks are retained, and not matched.
+    const entry value{ witness_hash, forks };
+
+    if (!keys_.insert(value).second)
+        return;
+
+    // Evict the oldest entry once the capacity has been reached.
+    if (order_.size() < capacity_)
+    {
+        order_.push_back(value);
+        return;
+    }
+
+    keys_.erase(order_[next_]);
+    order_[next_] = value;
+    next_ = (next_ + 1) % capacity_;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void script_cache::set_capacity(size_t capacity)
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+    capacity_ = capacity;
+    reset();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void script_cache::clear()
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+    reset();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// private, protected by caller.
+void script_cache::reset()
+{
+    next_ = 0;
+    keys_.clear();
+    order_.clear();
+}
+
+size_t script_cache::size() const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+    return keys_.size();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+size_t script_cache::capacity() const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+    return capacity_;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+uint64_t script_cache::hits() const
+{
+    return hits_.load();
+}
+
+uint64_t script_cache::misses() const
+{
+    return misses_.load();
+}
+
+} // namespace chain
+} // namespace system
+} // namespace libbitcoin
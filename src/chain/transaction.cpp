@@ -33,6 +33,7 @@
 #include <bitcoin/system/chain/script.hpp>
 #include <bitcoin/system/constants.hpp>
 #include <bitcoin/system/error.hpp>
+#include <bitcoin/system/math/flat_hash.hpp>
 #include <bitcoin/system/math/hash.hpp>
 #include <bitcoin/system/math/limits.hpp>
 #include <bitcoin/system/machine/opcode.hpp>
@@ -43,6 +44,8 @@
 #include <bitcoin/system/utility/container_source.hpp>
 #include <bitcoin/system/utility/istream_reader.hpp>
 #include <bitcoin/system/utility/ostream_writer.hpp>
+#include <bitcoin/system/utility/parallel.hpp>
+#include <bitcoin/system/utility/sha256_writer.hpp>
 
 namespace libbitcoin {
 namespace system {
@@ -50,19 +53,6 @@ namespace chain {
 
 using namespace bc::system::machine;
 
-#define RETURN_CACHED(name, type, context) \
-    hash_mutex_.lock_upgrade(); \
-    if (!name##_##context##_) \
-    { \
-        hash_mutex_.unlock_upgrade_and_lock(); \
-        name##_##context##_ = std::make_shared<hash_digest>(type##_hash( \
-            script::to_##name(*this))); \
-        hash_mutex_.unlock_and_lock_upgrade(); \
-    } \
-    const auto hash = *name##_##context##_; \
-    hash_mutex_.unlock_upgrade(); \
-    return hash
-
 // HACK: unlinked must match tx slab_map::not_found.
 const uint64_t transaction::validation::unlinked = max_int64;
 
@@ -106,11 +96,14 @@ void write(Sink& sink, const std::vector<Put>& puts, bool wire, bool witness)
 }
 
 // Input list must be pre-populated as it determines witness count.
-inline void read_witnesses(reader& source, input::list& inputs)
+template<class Source>
+void read_witnesses(Source& source, input::list& inputs)
 {
     const auto deserialize = [&](input& input)
     {
-        input.set_witness(witness::factory(source, true));
+        witness value;
+        value.from_data(source, true);
+        input.set_witness(std::move(value));
     };
 
     std::for_each(inputs.begin(), inputs.end(), deserialize);
@@ -145,7 +138,7 @@ transaction::transaction(transaction&& other)
     locktime_(other.locktime_),
     inputs_(std::move(other.inputs_)),
     outputs_(std::move(other.outputs_)),
-    hash_(other.hash_cache()),
+    hash_(other.hash_),
     total_input_value_(other.total_input_value_cache()),
     total_output_value_(other.total_output_value_cache())
 {
@@ -157,7 +150,7 @@ transaction::transaction(const transaction& other)
     locktime_(other.locktime_),
     inputs_(other.inputs_),
     outputs_(other.outputs_),
-    hash_(other.hash_cache()),
+    hash_(other.hash_),
     total_input_value_(other.total_input_value_cache()),
     total_output_value_(other.total_output_value_cache())
 {
@@ -183,13 +176,6 @@ transaction::transaction(uint32_t version, uint32_t locktime,
 {
 }
 
-// Private cache access for copy/move construction.
-transaction::hash_ptr transaction::hash_cache() const
-{
-    shared_lock lock(mutex_);
-    return hash_;
-}
-
 // Private cache access for copy/move construction.
 transaction::optional_value transaction::total_input_value_cache() const
 {
@@ -209,7 +195,14 @@ transaction::optional_value transaction::total_output_value_cache() const
 
 transaction& transaction::operator=(transaction&& other)
 {
-    hash_ = other.hash_cache();
+    // Component hashes and prefixes are not copied, as with construction.
+    hash_ = other.hash_;
+    witness_hash_.reset();
+    outputs_hash_.reset();
+    inpoints_hash_.reset();
+    sequences_hash_.reset();
+    prefixes_.fill(nullptr);
+    segregated_ = boost::none;
     total_input_value_ = other.total_input_value_cache();
     total_output_value_ = other.total_output_value_cache();
     version_ = other.version_;
@@ -223,7 +216,14 @@ transaction& transaction::operator=(transaction&& other)
 // This can be expensive, try to avoid.
 transaction& transaction::operator=(const transaction& other)
 {
-    hash_ = other.hash_cache();
+    // Component hashes and prefixes are not copied, as with construction.
+    hash_ = other.hash_;
+    witness_hash_.reset();
+    outputs_hash_.reset();
+    inpoints_hash_.reset();
+    sequences_hash_.reset();
+    prefixes_.fill(nullptr);
+    segregated_ = boost::none;
     total_input_value_ = other.total_input_value_cache();
     total_output_value_ = other.total_output_value_cache();
     version_ = other.version_;
@@ -296,8 +296,8 @@ transaction transaction::factory(reader& source, const hash_digest& hash,
 
 bool transaction::from_data(const data_chunk& data, bool wire, bool witness)
 {
-    data_source istream(data);
-    return from_data(istream, wire, witness);
+    auto source = make_byte_reader(data);
+    return from_data(source, wire, witness);
 }
 
 bool transaction::from_data(std::istream& stream, bool wire, bool witness)
@@ -307,7 +307,8 @@ bool transaction::from_data(std::istream& stream, bool wire, bool witness)
 }
 
 // Witness is not used by outputs, just for template normalization.
-bool transaction::from_data(reader& source, bool wire, bool witness)
+template <typename Source>
+bool transaction::deserialize(Source& source, bool wire, bool witness)
 {
     reset();
 
@@ -363,13 +364,23 @@ bool transaction::from_data(reader& source, bool wire, bool witness)
     return source;
 }
 
+bool transaction::from_data(reader& source, bool wire, bool witness)
+{
+    return deserialize(source, wire, witness);
+}
+
+bool transaction::from_data(byte_reader& source, bool wire, bool witness)
+{
+    return deserialize(source, wire, witness);
+}
+
 bool transaction::from_data(reader& source, hash_digest&& hash, bool wire,
     bool witness)
 {
     if (!from_data(source, wire, witness))
         return false;
 
-    hash_ = std::make_shared<hash_digest>(std::move(hash));
+    hash_.set(hash);
     return true;
 }
 
@@ -379,7 +390,7 @@ bool transaction::from_data(reader& source, const hash_digest& hash, bool wire,
     if (!from_data(source, wire, witness))
         return false;
 
-    hash_ = std::make_shared<hash_digest>(hash);
+    hash_.set(hash);
     return true;
 }
 
@@ -396,6 +407,7 @@ void transaction::reset()
     outputs_hash_.reset();
     inpoints_hash_.reset();
     sequences_hash_.reset();
+    prefixes_.fill(nullptr);
     segregated_ = boost::none;
     total_input_value_ = boost::none;
     total_output_value_ = boost::none;
@@ -535,6 +547,7 @@ void transaction::set_version(uint32_t value)
 {
     version_ = value;
     invalidate_cache();
+    prefixes_.fill(nullptr);
 }
 
 uint32_t transaction::locktime() const
@@ -564,6 +577,7 @@ void transaction::set_inputs(const input::list& value)
     invalidate_cache();
     inpoints_hash_.reset();
     sequences_hash_.reset();
+    prefixes_.fill(nullptr);
     segregated_ = boost::none;
     total_input_value_ = boost::none;
 }
@@ -572,6 +586,9 @@ void transaction::set_inputs(input::list&& value)
 {
     inputs_ = std::move(value);
     invalidate_cache();
+    inpoints_hash_.reset();
+    sequences_hash_.reset();
+    prefixes_.fill(nullptr);
     segregated_ = boost::none;
     total_input_value_ = boost::none;
 }
@@ -598,6 +615,7 @@ void transaction::set_outputs(output::list&& value)
 {
     outputs_ = std::move(value);
     invalidate_cache();
+    outputs_hash_.reset();
     total_output_value_ = boost::none;
 }
 
@@ -607,80 +625,133 @@ void transaction::set_outputs(output::list&& value)
 // protected
 void transaction::invalidate_cache() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
+    hash_.reset();
+    witness_hash_.reset();
+}
 
-    if (hash_ || witness_hash_)
+hash_digest transaction::hash(bool witness) const
+{
+    // Witness hashing must be disabled for non-segregated txs.
+    if (witness && is_segregated())
     {
-        hash_mutex_.unlock_upgrade_and_lock();
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_.reset();
-        witness_hash_.reset();
-        //---------------------------------------------------------------------
-        hash_mutex_.unlock_and_lock_upgrade();
+        return witness_hash_.get([this]()
+        {
+            // Witness coinbase tx hash is assumed to be null_hash (bip141).
+            return is_coinbase() ? null_hash : bitcoin_hash(to_data(true,
+                true));
+        });
     }
 
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
+    return hash_.get([this]()
+    {
+        return bitcoin_hash(to_data(true));
+    });
 }
 
-hash_digest transaction::hash(bool witness) const
+// static
+hash_list transaction::hashes(const list& transactions, bool witness)
 {
-    // Witness hashing must be disabled for non-segregated txs.
-    witness &= is_segregated();
-
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
+    hash_list out(transactions.size());
+    hash_list firsts;
+    std::vector<size_t> uncached;
 
-    if (witness)
+    for (size_t index = 0; index < transactions.size(); ++index)
     {
-        if (!witness_hash_)
+        const auto& tx = transactions[index];
+
+        // Witness hashing must be disabled for non-segregated txs.
+        // Witness coinbase tx hash is assumed to be null_hash (bip141).
+        const auto segregated = witness && tx.is_segregated();
+        if (segregated && tx.is_coinbase())
         {
-            //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-            hash_mutex_.unlock_upgrade_and_lock();
+            out[index] = null_hash;
+            continue;
+        }
 
-            // Witness coinbase tx hash is assumed to be null_hash (bip141).
-            witness_hash_ = std::make_shared<hash_digest>(
-                is_coinbase() ? null_hash : bitcoin_hash(to_data(true, true)));
+        const auto& cache = segregated ? tx.witness_hash_ : tx.hash_;
+        if (cache.get(out[index]))
+            continue;
 
-            hash_mutex_.unlock_and_lock_upgrade();
-            //-----------------------------------------------------------------
-        }
+        firsts.push_back(sha256_hash(tx.to_data(true, segregated)));
+        uncached.push_back(index);
     }
-    else
+
+    if (uncached.empty())
+        return out;
+
+    // The first round digests are contiguous 32 byte messages.
+    const auto seconds = sha256_hash_batch(
+        { firsts.front().data(), firsts.back().data() + hash_size });
+
+    for (size_t position = 0; position < uncached.size(); ++position)
     {
-        if (!hash_)
-        {
-            //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-            hash_mutex_.unlock_upgrade_and_lock();
-            hash_ = std::make_shared<hash_digest>(bitcoin_hash(to_data(true)));
-            hash_mutex_.unlock_and_lock_upgrade();
-            //-----------------------------------------------------------------
-        }
+        const auto index = uncached[position];
+        const auto& tx = transactions[index];
+        const auto segregated = witness && tx.is_segregated();
+        out[index] = seconds[position];
+        (segregated ? tx.witness_hash_ : tx.hash_).set(seconds[position]);
     }
 
-    const auto hash = witness ? *witness_hash_ : *hash_;
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return hash;
+    return out;
 }
 
 hash_digest transaction::outputs_hash() const
 {
-    RETURN_CACHED(outputs, bitcoin, hash);
+    return outputs_hash_.get([this]()
+    {
+        return bitcoin_hash(script::to_outputs(*this));
+    });
 }
 
 hash_digest transaction::inpoints_hash() const
 {
-    RETURN_CACHED(inpoints, bitcoin, hash);
+    return inpoints_hash_.get([this]()
+    {
+        return bitcoin_hash(script::to_inpoints(*this));
+    });
 }
 
 hash_digest transaction::sequences_hash() const
 {
-    RETURN_CACHED(sequences, bitcoin, hash);
+    return sequences_hash_.get([this]()
+    {
+        return bitcoin_hash(script::to_sequences(*this));
+    });
+}
+
+sha256_context transaction::version_0_prefix(bool inpoints,
+    bool sequences) const
+{
+    auto& prefix = prefixes_[(inpoints ? 2 : 0) + (sequences ? 1 : 0)];
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    prefix_mutex_.lock_shared();
+    const auto cached = prefix;
+    prefix_mutex_.unlock_shared();
+    ///////////////////////////////////////////////////////////////////////////
+
+    if (cached)
+        return *cached;
+
+    // The component hashes are cached independently, compute outside of lock.
+    sha256_context context;
+    sha256_writer sink(context);
+    sink.write_4_bytes_little_endian(version_);
+    sink.write_hash(inpoints ? inpoints_hash() : null_hash);
+    sink.write_hash(sequences ? sequences_hash() : null_hash);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    prefix_mutex_.lock();
+
+    if (!prefix)
+        prefix = std::make_shared<sha256_context>(context);
+
+    prefix_mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    return context;
 }
 
 // Utilities.
@@ -950,17 +1021,22 @@ hash_list transaction::missing_previous_transactions() const
         hashes.push_back(point.hash());
     };
 
+    // Duplicates are removed before sorting, as the result is sorted.
     std::for_each(points.begin(), points.end(), hasher);
-    return distinct(hashes);
+    distinct_unsorted(hashes);
+    std::sort(hashes.begin(), hashes.end());
+    return hashes;
 }
 
 bool transaction::is_internal_double_spend() const
 {
-    auto prevouts = previous_outputs();
-    std::sort(prevouts.begin(), prevouts.end());
-    const auto distinct_end = std::unique(prevouts.begin(), prevouts.end());
-    const auto distinct = (distinct_end == prevouts.end());
-    return !distinct;
+    point_set prevouts(inputs_.size());
+    const auto is_duplicate = [&prevouts](const input& input)
+    {
+        return !prevouts.insert(input.previous_output());
+    };
+
+    return std::any_of(inputs_.begin(), inputs_.end(), is_duplicate);
 }
 
 bool transaction::is_confirmed_double_spend() const
@@ -1027,7 +1103,7 @@ bool transaction::is_segregated() const
 
 // Coinbase transactions return success, to simplify iteration.
 code transaction::connect_input(const chain_state& state,
-    size_t input_index) const
+    size_t input_index, machine::signature_batch* batch) const
 {
     if (input_index >= inputs_.size())
         return error::operation_failed;
@@ -1045,7 +1121,7 @@ code transaction::connect_input(const chain_state& state,
     const auto index32 = static_cast<uint32_t>(input_index);
 
     // Verify the transaction input script against the previous output.
-    return script::verify(*this, index32, forks);
+    return script::verify(*this, index32, forks, batch);
 }
 
 // Validation.
@@ -1158,15 +1234,56 @@ code transaction::connect() const
 code transaction::connect(const chain_state& state) const
 {
     code ec;
+    auto& cache = script_verification_cache();
+    const auto cached = !is_coinbase() && cache.capacity() != 0;
+    const auto forks = state.enabled_forks();
+
+    // Cached scripts are verified, the presence of their prevouts is not.
+    if (cached && cache.contains(hash(true), forks))
+        return is_missing_previous_outputs() ?
+            error::missing_previous_output : error::success;
 
     for (size_t input = 0; input < inputs_.size(); ++input)
         if ((ec = connect_input(state, input)))
             return ec;
 
+    if (cached)
+        cache.store(hash(true), forks);
+
+    return error::success;
+}
+
+code transaction::connect(const chain_state& state, threadpool& pool) const
+{
+    code ec;
+    auto& cache = script_verification_cache();
+    const auto cached = !is_coinbase() && cache.capacity() != 0;
+    const auto forks = state.enabled_forks();
+
+    // Cached scripts are verified, the presence of their prevouts is not.
+    if (cached && cache.contains(hash(true), forks))
+        return is_missing_previous_outputs() ?
+            error::missing_previous_output : error::success;
+
+    const auto connect = [&](size_t input)
+    {
+        return connect_input(state, input);
+    };
+
+    if ((ec = parallel_first_error(pool, inputs_.size(), connect)))
+        return ec;
+
+    if (cached)
+        cache.store(hash(true), forks);
+
     return error::success;
 }
 
-#undef RETURN_CACHED
+script_cache& script_verification_cache()
+{
+    static script_cache cache(0);
+    return cache;
+}
 
 } // namespace chain
 } // namespace system
@@ -143,8 +143,8 @@ witness witness::factory(reader& source, bool prefix)
 
 bool witness::from_data(const data_chunk& encoded, bool prefix)
 {
-    data_source istream(encoded);
-    return from_data(istream, prefix);
+    auto source = make_byte_reader(encoded);
+    return from_data(source, prefix);
 }
 
 bool witness::from_data(std::istream& stream, bool prefix)
@@ -154,12 +154,13 @@ bool witness::from_data(std::istream& stream, bool prefix)
 }
 
 // Prefixed data assumed valid here though caller may confirm with is_valid.
-bool witness::from_data(reader& source, bool prefix)
+template <typename Source>
+bool witness::deserialize(Source& source, bool prefix)
 {
     reset();
     valid_ = true;
 
-    const auto read_element = [](reader& source)
+    const auto read_element = [](Source& source)
     {
         // Tokens encoded as variable integer prefixed byte array (bip144).
         const auto size = source.read_size_little_endian();
@@ -196,6 +197,16 @@ bool witness::from_data(reader& source, bool prefix)
     return source;
 }
 
+bool witness::from_data(reader& source, bool prefix)
+{
+    return deserialize(source, prefix);
+}
+
+bool witness::from_data(byte_reader& source, bool prefix)
+{
+    return deserialize(source, prefix);
+}
+
 // private/static
 size_t witness::serialized_size(const data_stack& stack)
 {
@@ -493,7 +504,8 @@ bool witness::extract_script(script& out_script,
 // The program script is either a prevout script or an embedded script.
 // It validates this witness, from which the witness script is derived.
 code witness::verify(const transaction& tx, uint32_t input_index,
-    uint32_t forks, const script& program_script, uint64_t value) const
+    uint32_t forks, const script& program_script, uint64_t value,
+    machine::signature_batch* batch) const
 {
     code ec;
     script script;
@@ -511,6 +523,9 @@ code witness::verify(const transaction& tx, uint32_t input_index,
             program witness(script, tx, input_index, forks, std::move(stack),
                 value, version);
 
+            if (batch != nullptr)
+                witness.set_batch(*batch, true);
+
             if ((ec = witness.evaluate()))
                 return ec;
 
@@ -0,0 +1,558 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/system/machine/compiled_script.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/system/chain/script.hpp>
+#include <bitcoin/system/constants.hpp>
+#include <bitcoin/system/error.hpp>
+#include <bitcoin/system/machine/interpreter.hpp>
+#include <bitcoin/system/machine/number.hpp>
+#include <bitcoin/system/machine/opcode.hpp>
+#include <bitcoin/system/machine/operation.hpp>
+#include <bitcoin/system/machine/program.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace machine {
+
+compiled_script::compiled_script(const chain::script& script)
+  : script_(script)
+{
+    const auto& ops = script.operations();
+    instructions_.reserve(ops.size());
+
+    for (const auto& op: ops)
+    {
+        auto failure = error::success;
+
+        if (op.is_oversized())
+            failure = error::invalid_push_data_size;
+        else if (op.is_disabled())
+            failure = error::op_disabled;
+
+        const auto size = static_cast<uint32_t>(ops.size());
+        instructions_.push_back({ to_handler(op.code()), &op, failure,
+            op.is_conditional(), size, 0, false });
+    }
+
+    resolve_jumps();
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+const chain::script& compiled_script::script() const
+{
+    return script_;
+}
+
+const compiled_script::list& compiled_script::instructions() const
+{
+    return instructions_;
+}
+
+// private
+//-----------------------------------------------------------------------------
+
+// Each conditional is linked to the next else/endif of its depth, counting
+// the operations and static failures between them. The open conditionals
+// are held by index, and each else/endif closes the link of its predecessor.
+void compiled_script::resolve_jumps()
+{
+    std::vector<size_t> open;
+
+    for (size_t index = 0; index < instructions_.size(); ++index)
+    {
+        auto& instruction = instructions_[index];
+
+        // Count the operation in each open branch, as it would be skipped.
+        for (const auto branch: open)
+        {
+            auto& jump = instructions_[branch];
+            jump.skipped += (instruction.op->is_counted() ? 1 : 0);
+            jump.jumpable &= (instruction.failure == error::success);
+        }
+
+        switch (instruction.op->code())
+        {
+            case opcode::if_:
+            case opcode::notif:
+                break;
+
+            case opcode::else_:
+            case opcode::endif:
+            {
+                if (open.empty())
+                    continue;
+
+                auto& jump = instructions_[open.back()];
+                open.pop_back();
+
+                // The else/endif itself is executed, not skipped.
+                jump.skipped -= (instruction.op->is_counted() ? 1 : 0);
+                jump.next = static_cast<uint32_t>(index);
+
+                if (instruction.op->code() == opcode::endif)
+                    continue;
+
+                break;
+            }
+
+            default:
+                continue;
+        }
+
+        instruction.jumpable = true;
+        open.push_back(index);
+    }
+}
+
+// Handler adapters.
+//-----------------------------------------------------------------------------
+
+template <interpreter::result (*Operation)(program&)>
+interpreter::result compiled_script::run(program& program, const operation&)
+{
+    return Operation(program);
+}
+
+template <uint32_t Limit>
+interpreter::result compiled_script::push_data(program& program,
+    const operation& op)
+{
+    return interpreter::op_push_data(program, op.data(), Limit);
+}
+
+interpreter::result compiled_script::push_negative(program& program,
+    const operation&)
+{
+    return interpreter::op_push_number(program, number::negative_1);
+}
+
+interpreter::result compiled_script::push_positive(program& program,
+    const operation& op)
+{
+    return interpreter::op_push_number(program,
+        operation::opcode_to_positive(op.code()));
+}
+
+interpreter::result compiled_script::nop(program&, const operation& op)
+{
+    return interpreter::op_nop(op.code());
+}
+
+interpreter::result compiled_script::disabled(program&, const operation& op)
+{
+    return interpreter::op_disabled(op.code());
+}
+
+interpreter::result compiled_script::reserved(program&, const operation& op)
+{
+    return interpreter::op_reserved(op.code());
+}
+
+interpreter::result compiled_script::check_sig_verify(program& program,
+    const operation&)
+{
+    return interpreter::op_check_sig_verify(program);
+}
+
+interpreter::result compiled_script::check_multisig_verify(program& program,
+    const operation&)
+{
+    return interpreter::op_check_multisig_verify(program);
+}
+
+// Handlers are resolved as interpreter::run_op dispatches.
+compiled_script::handler compiled_script::to_handler(opcode code)
+{
+    switch (code)
+    {
+        case opcode::push_size_0:
+        case opcode::push_size_1:
+        case opcode::push_size_2:
+        case opcode::push_size_3:
+        case opcode::push_size_4:
+        case opcode::push_size_5:
+        case opcode::push_size_6:
+        case opcode::push_size_7:
+        case opcode::push_size_8:
+        case opcode::push_size_9:
+        case opcode::push_size_10:
+        case opcode::push_size_11:
+        case opcode::push_size_12:
+        case opcode::push_size_13:
+        case opcode::push_size_14:
+        case opcode::push_size_15:
+        case opcode::push_size_16:
+        case opcode::push_size_17:
+        case opcode::push_size_18:
+        case opcode::push_size_19:
+        case opcode::push_size_20:
+        case opcode::push_size_21:
+        case opcode::push_size_22:
+        case opcode::push_size_23:
+        case opcode::push_size_24:
+        case opcode::push_size_25:
+        case opcode::push_size_26:
+        case opcode::push_size_27:
+        case opcode::push_size_28:
+        case opcode::push_size_29:
+        case opcode::push_size_30:
+        case opcode::push_size_31:
+        case opcode::push_size_32:
+        case opcode::push_size_33:
+        case opcode::push_size_34:
+        case opcode::push_size_35:
+        case opcode::push_size_36:
+        case opcode::push_size_37:
+        case opcode::push_size_38:
+        case opcode::push_size_39:
+        case opcode::push_size_40:
+        case opcode::push_size_41:
+        case opcode::push_size_42:
+        case opcode::push_size_43:
+        case opcode::push_size_44:
+        case opcode::push_size_45:
+        case opcode::push_size_46:
+        case opcode::push_size_47:
+        case opcode::push_size_48:
+        case opcode::push_size_49:
+        case opcode::push_size_50:
+        case opcode::push_size_51:
+        case opcode::push_size_52:
+        case opcode::push_size_53:
+        case opcode::push_size_54:
+        case opcode::push_size_55:
+        case opcode::push_size_56:
+        case opcode::push_size_57:
+        case opcode::push_size_58:
+        case opcode::push_size_59:
+        case opcode::push_size_60:
+        case opcode::push_size_61:
+        case opcode::push_size_62:
+        case opcode::push_size_63:
+        case opcode::push_size_64:
+        case opcode::push_size_65:
+        case opcode::push_size_66:
+        case opcode::push_size_67:
+        case opcode::push_size_68:
+        case opcode::push_size_69:
+        case opcode::push_size_70:
+        case opcode::push_size_71:
+        case opcode::push_size_72:
+        case opcode::push_size_73:
+        case opcode::push_size_74:
+        case opcode::push_size_75:
+            return &interpreter::op_push_size;
+        case opcode::push_one_size:
+            return &push_data<max_uint8>;
+        case opcode::push_two_size:
+            return &push_data<max_uint16>;
+        case opcode::push_four_size:
+            return &push_data<max_uint32>;
+        case opcode::push_negative_1:
+            return &push_negative;
+        case opcode::reserved_80:
+            return &reserved;
+        case opcode::push_positive_1:
+            return &push_positive;
+        case opcode::push_positive_2:
+            return &push_positive;
+        case opcode::push_positive_3:
+            return &push_positive;
+        case opcode::push_positive_4:
+            return &push_positive;
+        case opcode::push_positive_5:
+            return &push_positive;
+        case opcode::push_positive_6:
+            return &push_positive;
+        case opcode::push_positive_7:
+            return &push_positive;
+        case opcode::push_positive_8:
+            return &push_positive;
+        case opcode::push_positive_9:
+            return &push_positive;
+        case opcode::push_positive_10:
+            return &push_positive;
+        case opcode::push_positive_11:
+            return &push_positive;
+        case opcode::push_positive_12:
+            return &push_positive;
+        case opcode::push_positive_13:
+            return &push_positive;
+        case opcode::push_positive_14:
+            return &push_positive;
+        case opcode::push_positive_15:
+            return &push_positive;
+        case opcode::push_positive_16:
+            return &push_positive;
+        case opcode::nop:
+            return &nop;
+        case opcode::reserved_98:
+            return &reserved;
+        case opcode::if_:
+            return &run<&interpreter::op_if>;
+        case opcode::notif:
+            return &run<&interpreter::op_notif>;
+        case opcode::disabled_verif:
+            return &disabled;
+        case opcode::disabled_vernotif:
+            return &disabled;
+        case opcode::else_:
+            return &run<&interpreter::op_else>;
+        case opcode::endif:
+            return &run<&interpreter::op_endif>;
+        case opcode::verify:
+            return &run<&interpreter::op_verify>;
+        case opcode::return_:
+            return &run<&interpreter::op_return>;
+        case opcode::toaltstack:
+            return &run<&interpreter::op_to_alt_stack>;
+        case opcode::fromaltstack:
+            return &run<&interpreter::op_from_alt_stack>;
+        case opcode::drop2:
+            return &run<&interpreter::op_drop2>;
+        case opcode::dup2:
+            return &run<&interpreter::op_dup2>;
+        case opcode::dup3:
+            return &run<&interpreter::op_dup3>;
+        case opcode::over2:
+            return &run<&interpreter::op_over2>;
+        case opcode::rot2:
+            return &run<&interpreter::op_rot2>;
+        case opcode::swap2:
+            return &run<&interpreter::op_swap2>;
+        case opcode::ifdup:
+            return &run<&interpreter::op_if_dup>;
+        case opcode::depth:
+            return &run<&interpreter::op_depth>;
+        case opcode::drop:
+            return &run<&interpreter::op_drop>;
+        case opcode::dup:
+            return &run<&interpreter::op_dup>;
+        case opcode::nip:
+            return &run<&interpreter::op_nip>;
+        case opcode::over:
+            return &run<&interpreter::op_over>;
+        case opcode::pick:
+            return &run<&interpreter::op_pick>;
+        case opcode::roll:
+            return &run<&interpreter::op_roll>;
+        case opcode::rot:
+            return &run<&interpreter::op_rot>;
+        case opcode::swap:
+            return &run<&interpreter::op_swap>;
+        case opcode::tuck:
+            return &run<&interpreter::op_tuck>;
+        case opcode::disabled_cat:
+            return &disabled;
+        case opcode::disabled_substr:
+            return &disabled;
+        case opcode::disabled_left:
+            return &disabled;
+        case opcode::disabled_right:
+            return &disabled;
+        case opcode::size:
+            return &run<&interpreter::op_size>;
+        case opcode::disabled_invert:
+            return &disabled;
+        case opcode::disabled_and:
+            return &disabled;
+        case opcode::disabled_or:
+            return &disabled;
+        case opcode::disabled_xor:
+            return &disabled;
+        case opcode::equal:
+            return &run<&interpreter::op_equal>;
+        case opcode::equalverify:
+            return &run<&interpreter::op_equal_verify>;
+        case opcode::reserved_137:
+            return &reserved;
+        case opcode::reserved_138:
+            return &reserved;
+        case opcode::add1:
+            return &run<&interpreter::op_add1>;
+        case opcode::sub1:
+            return &run<&interpreter::op_sub1>;
+        case opcode::disabled_mul2:
+            return &disabled;
+        case opcode::disabled_div2:
+            return &disabled;
+        case opcode::negate:
+            return &run<&interpreter::op_negate>;
+        case opcode::abs:
+            return &run<&interpreter::op_abs>;
+        case opcode::not_:
+            return &run<&interpreter::op_not>;
+        case opcode::nonzero:
+            return &run<&interpreter::op_nonzero>;
+        case opcode::add:
+            return &run<&interpreter::op_add>;
+        case opcode::sub:
+            return &run<&interpreter::op_sub>;
+        case opcode::disabled_mul:
+            return &disabled;
+        case opcode::disabled_div:
+            return &disabled;
+        case opcode::disabled_mod:
+            return &disabled;
+        case opcode::disabled_lshift:
+            return &disabled;
+        case opcode::disabled_rshift:
+            return &disabled;
+        case opcode::booland:
+            return &run<&interpreter::op_bool_and>;
+        case opcode::boolor:
+            return &run<&interpreter::op_bool_or>;
+        case opcode::numequal:
+            return &run<&interpreter::op_num_equal>;
+        case opcode::numequalverify:
+            return &run<&interpreter::op_num_equal_verify>;
+        case opcode::numnotequal:
+            return &run<&interpreter::op_num_not_equal>;
+        case opcode::lessthan:
+            return &run<&interpreter::op_less_than>;
+        case opcode::greaterthan:
+            return &run<&interpreter::op_greater_than>;
+        case opcode::lessthanorequal:
+            return &run<&interpreter::op_less_than_or_equal>;
+        case opcode::greaterthanorequal:
+            return &run<&interpreter::op_greater_than_or_equal>;
+        case opcode::min:
+            return &run<&interpreter::op_min>;
+        case opcode::max:
+            return &run<&interpreter::op_max>;
+        case opcode::within:
+            return &run<&interpreter::op_within>;
+        case opcode::ripemd160:
+            return &run<&interpreter::op_ripemd160>;
+        case opcode::sha1:
+            return &run<&interpreter::op_sha1>;
+        case opcode::sha256:
+            return &run<&interpreter::op_sha256>;
+        case opcode::hash160:
+            return &run<&interpreter::op_hash160>;
+        case opcode::hash256:
+            return &run<&interpreter::op_hash256>;
+        case opcode::codeseparator:
+            return &interpreter::op_codeseparator;
+        case opcode::checksig:
+            return &interpreter::op_check_sig;
+        case opcode::checksigverify:
+            return &check_sig_verify;
+        case opcode::checkmultisig:
+            return &interpreter::op_check_multisig;
+        case opcode::checkmultisigverify:
+            return &check_multisig_verify;
+        case opcode::nop1:
+            return &nop;
+        case opcode::checklocktimeverify:
+            return &run<&interpreter::op_check_locktime_verify>;
+        case opcode::checksequenceverify:
+            return &run<&interpreter::op_check_sequence_verify>;
+        case opcode::nop4:
+        case opcode::nop5:
+        case opcode::nop6:
+        case opcode::nop7:
+        case opcode::nop8:
+        case opcode::nop9:
+        case opcode::nop10:
+            return &nop;
+        case opcode::reserved_186:
+        case opcode::reserved_187:
+        case opcode::reserved_188:
+        case opcode::reserved_189:
+        case opcode::reserved_190:
+        case opcode::reserved_191:
+        case opcode::reserved_192:
+        case opcode::reserved_193:
+        case opcode::reserved_194:
+        case opcode::reserved_195:
+        case opcode::reserved_196:
+        case opcode::reserved_197:
+        case opcode::reserved_198:
+        case opcode::reserved_199:
+        case opcode::reserved_200:
+        case opcode::reserved_201:
+        case opcode::reserved_202:
+        case opcode::reserved_203:
+        case opcode::reserved_204:
+        case opcode::reserved_205:
+        case opcode::reserved_206:
+        case opcode::reserved_207:
+        case opcode::reserved_208:
+        case opcode::reserved_209:
+        case opcode::reserved_210:
+        case opcode::reserved_211:
+        case opcode::reserved_212:
+        case opcode::reserved_213:
+        case opcode::reserved_214:
+        case opcode::reserved_215:
+        case opcode::reserved_216:
+        case opcode::reserved_217:
+        case opcode::reserved_218:
+        case opcode::reserved_219:
+        case opcode::reserved_220:
+        case opcode::reserved_221:
+        case opcode::reserved_222:
+        case opcode::reserved_223:
+        case opcode::reserved_224:
+        case opcode::reserved_225:
+        case opcode::reserved_226:
+        case opcode::reserved_227:
+        case opcode::reserved_228:
+        case opcode::reserved_229:
+        case opcode::reserved_230:
+        case opcode::reserved_231:
+        case opcode::reserved_232:
+        case opcode::reserved_233:
+        case opcode::reserved_234:
+        case opcode::reserved_235:
+        case opcode::reserved_236:
+        case opcode::reserved_237:
+        case opcode::reserved_238:
+        case opcode::reserved_239:
+        case opcode::reserved_240:
+        case opcode::reserved_241:
+        case opcode::reserved_242:
+        case opcode::reserved_243:
+        case opcode::reserved_244:
+        case opcode::reserved_245:
+        case opcode::reserved_246:
+        case opcode::reserved_247:
+        case opcode::reserved_248:
+        case opcode::reserved_249:
+        case opcode::reserved_250:
+        case opcode::reserved_251:
+        case opcode::reserved_252:
+        case opcode::reserved_253:
+        case opcode::reserved_254:
+        case opcode::reserved_255:
+        default:
+            return &reserved;
+    }
+}
+
+} // namespace machine
+} // namespace system
+} // namespace libbitcoin
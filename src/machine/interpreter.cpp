@@ -20,6 +20,7 @@
 
 #include <bitcoin/system/constants.hpp>
 #include <bitcoin/system/error.hpp>
+#include <bitcoin/system/machine/compiled_script.hpp>
 #include <bitcoin/system/machine/operation.hpp>
 #include <bitcoin/system/machine/program.hpp>
 
@@ -58,6 +59,58 @@ code interpreter::run(program& program)
     return program.closed() ? error::success : error::invalid_stack_scope;
 }
 
+// Operations are dispatched through their resolved handlers, and a branch
+// that is not executed is jumped when it has no static failure, accounting
+// for its counted operations. The result is always that of run(program).
+code interpreter::run(const compiled_script& script, program& program)
+{
+    code ec;
+
+    if (program.is_invalid())
+        return error::invalid_script;
+
+    const auto& instructions = script.instructions();
+    const auto end = instructions.size();
+
+    for (size_t index = 0; index < end; ++index)
+    {
+        const auto& instruction = instructions[index];
+
+        if (instruction.failure != error::success)
+            return instruction.failure;
+
+        if (!program.increment_operation_count(*instruction.op))
+            return error::invalid_operation_count;
+
+        if (instruction.conditional)
+        {
+            const auto succeeded = program.succeeded();
+
+            if ((ec = instruction.run(program, *instruction.op)))
+                return ec;
+
+            if (succeeded && !program.succeeded() && instruction.jumpable)
+            {
+                if (!program.skip_operation_count(instruction.skipped))
+                    return error::invalid_operation_count;
+
+                // The next else/endif is executed.
+                index = instruction.next - 1;
+            }
+        }
+        else if (program.succeeded())
+        {
+            if ((ec = instruction.run(program, *instruction.op)))
+                return ec;
+
+            if (program.is_stack_overflow())
+                return error::invalid_stack_size;
+        }
+    }
+
+    return program.closed() ? error::success : error::invalid_stack_scope;
+}
+
 code interpreter::run(const operation& op, program& program)
 {
     return run_op(op, program);
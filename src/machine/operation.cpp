@@ -64,8 +64,8 @@ operation operation::factory(reader& source)
 
 bool operation::from_data(const data_chunk& encoded)
 {
-    data_source istream(encoded);
-    return from_data(istream);
+    auto source = make_byte_reader(encoded);
+    return from_data(source);
 }
 
 bool operation::from_data(std::istream& stream)
@@ -75,7 +75,8 @@ bool operation::from_data(std::istream& stream)
 }
 
 // TODO: optimize for larger data by using a shared byte array.
-bool operation::from_data(reader& source)
+template <typename Source>
+bool operation::deserialize(Source& source)
 {
     ////reset();
     valid_ = true;
@@ -96,6 +97,16 @@ bool operation::from_data(reader& source)
     return valid_;
 }
 
+bool operation::from_data(reader& source)
+{
+    return deserialize(source);
+}
+
+bool operation::from_data(byte_reader& source)
+{
+    return deserialize(source);
+}
+
 inline bool is_push_token(const std::string& token)
 {
     return token.size() > 1 && token.front() == '[' && token.back() == ']';
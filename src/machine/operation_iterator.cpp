@@ -0,0 +1,154 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/system/machine/operation_iterator.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/system/machine/opcode.hpp>
+#include <bitcoin/system/machine/operation.hpp>
+#include <bitcoin/system/utility/data.hpp>
+#include <bitcoin/system/utility/endian.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace machine {
+
+operation_iterator::operation_iterator(const data_slice& script)
+  : position_(script.begin()),
+    end_(script.end()),
+    data_(script.begin()),
+    size_(0),
+    code_(opcode::disabled_xor),
+    valid_(true)
+{
+}
+
+// Operations are decoded as operation::from_data, without copying the data.
+bool operation_iterator::next()
+{
+    if (!valid_ || position_ == end_)
+        return false;
+
+    code_ = static_cast<opcode>(*position_++);
+    const auto remaining = static_cast<size_t>(end_ - position_);
+    BC_CONSTEXPR auto op_75 = static_cast<uint8_t>(opcode::push_size_75);
+
+    switch (code_)
+    {
+        case opcode::push_one_size:
+            if (remaining < sizeof(uint8_t))
+            {
+                invalidate();
+                return true;
+            }
+
+            size_ = *position_;
+            position_ += sizeof(uint8_t);
+            break;
+        case opcode::push_two_size:
+            if (remaining < sizeof(uint16_t))
+            {
+                invalidate();
+                return true;
+            }
+
+            size_ = from_little_endian_unsafe<uint16_t>(position_);
+            position_ += sizeof(uint16_t);
+            break;
+        case opcode::push_four_size:
+            if (remaining < sizeof(uint32_t))
+            {
+                invalidate();
+                return true;
+            }
+
+            size_ = from_little_endian_unsafe<uint32_t>(position_);
+            position_ += sizeof(uint32_t);
+            break;
+        default:
+            const auto byte = static_cast<uint8_t>(code_);
+            size_ = byte <= op_75 ? byte : 0;
+            break;
+    }
+
+    if (size_ > static_cast<size_t>(end_ - position_))
+    {
+        invalidate();
+        return true;
+    }
+
+    data_ = position_;
+    position_ += size_;
+    return true;
+}
+
+opcode operation_iterator::code() const
+{
+    return code_;
+}
+
+data_slice operation_iterator::data() const
+{
+    return { data_, data_ + size_ };
+}
+
+bool operation_iterator::is_valid() const
+{
+    return valid_;
+}
+
+bool operation_iterator::is_last() const
+{
+    return position_ == end_;
+}
+
+bool operation_iterator::is_push() const
+{
+    return operation::is_push(code_);
+}
+
+bool operation_iterator::is_version() const
+{
+    return operation::is_version(code_);
+}
+
+bool operation_iterator::is_relaxed_push() const
+{
+    return operation::is_relaxed_push(code_);
+}
+
+bool operation_iterator::is_minimal_push() const
+{
+    return code_ == operation::minimal_opcode_from_data(data());
+}
+
+// private
+// The invalid operation ends iteration, matching operation::reset.
+void operation_iterator::invalidate()
+{
+    code_ = opcode::disabled_xor;
+    data_ = end_;
+    size_ = 0;
+    position_ = end_;
+    valid_ = false;
+}
+
+} // namespace machine
+} // namespace system
+} // namespace libbitcoin
@@ -25,6 +25,8 @@
 #include <bitcoin/system/chain/transaction.hpp>
 #include <bitcoin/system/machine/interpreter.hpp>
 #include <bitcoin/system/machine/script_version.hpp>
+#include <bitcoin/system/machine/signature_batch.hpp>
+#include <bitcoin/system/math/elliptic_curve.hpp>
 #include <bitcoin/system/utility/data.hpp>
 
 namespace libbitcoin {
@@ -46,33 +48,39 @@ program::program()
     forks_(0),
     value_(0),
     version_(script_version::unversioned),
+    batch_(nullptr),
+    final_(false),
     negative_count_(0),
     operation_count_(0),
     jump_(script_.begin())
 {
 }
 
-program::program(const script& script)
+program::program(const chain::script& script)
   : script_(script),
     transaction_(default_tx_),
     input_index_(0),
     forks_(0),
     value_(0),
     version_(script_version::unversioned),
+    batch_(nullptr),
+    final_(false),
     negative_count_(0),
     operation_count_(0),
     jump_(script_.begin())
 {
 }
 
-program::program(const script& script, const chain::transaction& transaction,
-    uint32_t input_index, uint32_t forks)
+program::program(const chain::script& script,
+    const chain::transaction& transaction, uint32_t input_index, uint32_t forks)
   : script_(script),
     transaction_(transaction),
     input_index_(input_index),
     forks_(forks),
     value_(max_uint64),
     version_(script_version::unversioned),
+    batch_(nullptr),
+    final_(false),
     negative_count_(0),
     operation_count_(0),
     jump_(script_.begin())
@@ -80,15 +88,17 @@ program::program(const script& script, const chain::transaction& transaction,
 }
 
 // Condition, alternate, jump and operation_count are not copied.
-program::program(const script& script, const chain::transaction& transaction,
-    uint32_t input_index, uint32_t forks, data_stack&& stack, uint64_t value,
-    script_version version)
+program::program(const chain::script& script,
+    const chain::transaction& transaction, uint32_t input_index, uint32_t forks,
+    data_stack&& stack, uint64_t value, script_version version)
   : script_(script),
     transaction_(transaction),
     input_index_(input_index),
     forks_(forks),
     value_(value),
     version_(version),
+    batch_(nullptr),
+    final_(false),
     negative_count_(0),
     operation_count_(0),
     jump_(script_.begin()),
@@ -98,13 +108,15 @@ program::program(const script& script, const chain::transaction& transaction,
 
 
 // Condition, alternate, jump and operation_count are not copied.
-program::program(const script& script, const program& other)
+program::program(const chain::script& script, const program& other)
   : script_(script),
     transaction_(other.transaction_),
     input_index_(other.input_index_),
     forks_(other.forks_),
     value_(other.value_),
     version_(script_version::unversioned),
+    batch_(nullptr),
+    final_(false),
     negative_count_(0),
     operation_count_(0),
     jump_(script_.begin()),
@@ -113,13 +125,15 @@ program::program(const script& script, const program& other)
 }
 
 // Condition, alternate, jump and operation_count are not moved.
-program::program(const script& script, program&& other, bool)
+program::program(const chain::script& script, program&& other, bool)
   : script_(script),
     transaction_(other.transaction_),
     input_index_(other.input_index_),
     forks_(other.forks_),
     value_(other.value_),
     version_(script_version::unversioned),
+    batch_(nullptr),
+    final_(false),
     negative_count_(0),
     operation_count_(0),
     jump_(script_.begin()),
@@ -127,6 +141,53 @@ program::program(const script& script, program&& other, bool)
 {
 }
 
+// Signature deferral.
+//-----------------------------------------------------------------------------
+
+// Batch and final are not copied or moved by the program constructors.
+void program::set_batch(signature_batch& batch, bool final_result)
+{
+    batch_ = &batch;
+    final_ = final_result;
+}
+
+bool program::is_deferred() const
+{
+    return batch_ != nullptr;
+}
+
+// The operation is identified by address, as it is iterated from the script.
+bool program::is_deferred(const operation& last) const
+{
+    const auto& ops = script_.operations();
+    return is_deferred() && final_ && !ops.empty() && &ops.back() == &last;
+}
+
+bool program::check_signature(const ec_signature& signature,
+    uint8_t sighash_type, const data_chunk& public_key,
+    const chain::script& script_code, script_version version, bool deferrable)
+{
+    if (!deferrable || !is_deferred())
+        return chain::script::check_signature(signature, sighash_type,
+            public_key, script_code, transaction_, input_index_, version,
+            value_);
+
+    // This matches the empty key failure of script::check_signature.
+    if (public_key.empty())
+        return false;
+
+    // The signature hash is generated here, as the script code is transient.
+    const auto sighash = chain::script::generate_signature_hash(transaction_,
+        input_index_, script_code, sighash_type, version, value_);
+
+    // A previously verified signature is not deferred.
+    if (!signature_verification_cache().contains(public_key, sighash,
+        signature))
+        batch_->push(public_key, sighash, signature);
+
+    return true;
+}
+
 // Instructions.
 //-----------------------------------------------------------------------------
 
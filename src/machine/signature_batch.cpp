@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/system/machine/signature_batch.hpp>
+
+#include <cstddef>
+#include <bitcoin/system/error.hpp>
+#include <bitcoin/system/math/elliptic_curve.hpp>
+#include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/utility/data.hpp>
+#include <bitcoin/system/utility/parallel.hpp>
+#include <bitcoin/system/utility/thread.hpp>
+#include <bitcoin/system/utility/threadpool.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace machine {
+
+signature_batch::signature_batch()
+{
+}
+
+void signature_batch::push(const data_chunk& public_key,
+    const hash_digest& sighash, const ec_signature& signature)
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+    checks_.push_back({ public_key, sighash, signature });
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+size_t signature_batch::size() const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+    return checks_.size();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void signature_batch::clear()
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+    checks_.clear();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// static
+bool signature_batch::verify(const check& check)
+{
+    // Checks are cached only by store, once their block is accepted.
+    return verify_signature_uncached(check.public_key, check.sighash,
+        check.signature);
+}
+
+// Checks are not pushed during verification, so they are not locked here.
+code signature_batch::verify() const
+{
+    for (const auto& check: checks_)
+        if (!verify(check))
+            return error::incorrect_signature;
+
+    return error::success;
+}
+
+code signature_batch::verify(threadpool& pool) const
+{
+    const auto verifier = [this](size_t index)
+    {
+        return verify(checks_[index]) ? error::success :
+            error::incorrect_signature;
+    };
+
+    return parallel_first_error(pool, checks_.size(), verifier);
+}
+
+// Checks are not pushed during storage, so they are not locked here.
+void signature_batch::store() const
+{
+    auto& cache = signature_verification_cache();
+
+    if (cache.capacity() == 0)
+        return;
+
+    for (const auto& check: checks_)
+        cache.store(check.public_key, check.sighash, check.signature);
+}
+
+} // namespace machine
+} // namespace system
+} // namespace libbitcoin
@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/system/machine/view_interpreter.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/system/chain/script.hpp>
+#include <bitcoin/system/constants.hpp>
+#include <bitcoin/system/error.hpp>
+#include <bitcoin/system/machine/opcode.hpp>
+#include <bitcoin/system/machine/operation.hpp>
+#include <bitcoin/system/machine/operation_iterator.hpp>
+#include <bitcoin/system/machine/stack_item.hpp>
+#include <bitcoin/system/machine/view_program.hpp>
+#include <bitcoin/system/utility/data.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace machine {
+
+// Code separators require the subscript, and multisig the endorsements, as
+// operations. These are rare, so such scripts are left to interpreter::run.
+bool view_interpreter::is_supported(const data_slice& script)
+{
+    operation_iterator op(script);
+
+    while (op.next())
+    {
+        switch (op.code())
+        {
+            case opcode::codeseparator:
+            case opcode::checkmultisig:
+            case opcode::checkmultisigverify:
+                return false;
+            default:
+                break;
+        }
+    }
+
+    return true;
+}
+
+code view_interpreter::run(view_program& program)
+{
+    code ec;
+
+    if (program.is_invalid())
+        return error::invalid_script;
+
+    operation_iterator op(program.script().bytes());
+
+    while (op.next())
+    {
+        if (op.data().size() > max_push_data_size)
+            return error::invalid_push_data_size;
+
+        if (operation::is_disabled(op.code()))
+            return error::op_disabled;
+
+        if (!program.increment_operation_count(op.code()))
+            return error::invalid_operation_count;
+
+        if (program.if_(op.code()))
+        {
+            if ((ec = run_op(op, program)))
+                return ec;
+
+            if (program.is_stack_overflow())
+                return error::invalid_stack_size;
+        }
+    }
+
+    return program.closed() ? error::success : error::invalid_stack_scope;
+}
+
+} // namespace machine
+} // namespace system
+} // namespace libbitcoin
@@ -0,0 +1,154 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/system/machine/view_program.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/system/chain/script.hpp>
+#include <bitcoin/system/chain/transaction.hpp>
+#include <bitcoin/system/machine/script_version.hpp>
+#include <bitcoin/system/machine/signature_batch.hpp>
+#include <bitcoin/system/machine/stack_item.hpp>
+#include <bitcoin/system/machine/view_interpreter.hpp>
+#include <bitcoin/system/math/elliptic_curve.hpp>
+#include <bitcoin/system/utility/data.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace machine {
+
+using namespace bc::system::chain;
+
+// Standard scripts do not exceed this depth, so do not reallocate the stack.
+static BC_CONSTEXPR size_t expected_stack_size = 8;
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+view_program::view_program(const chain::script& script,
+    const chain::transaction& transaction, uint32_t input_index,
+    uint32_t forks)
+  : script_(script),
+    transaction_(transaction),
+    input_index_(input_index),
+    forks_(forks),
+    value_(max_uint64),
+    version_(script_version::unversioned),
+    batch_(nullptr),
+    final_(false),
+    negative_count_(0),
+    operation_count_(0)
+{
+    primary_.reserve(expected_stack_size);
+}
+
+// Condition, alternate and operation_count are not copied.
+view_program::view_program(const chain::script& script,
+    const chain::transaction& transaction, uint32_t input_index,
+    uint32_t forks, const data_stack& stack, uint64_t value,
+    script_version version)
+  : script_(script),
+    transaction_(transaction),
+    input_index_(input_index),
+    forks_(forks),
+    value_(value),
+    version_(version),
+    batch_(nullptr),
+    final_(false),
+    negative_count_(0),
+    operation_count_(0)
+{
+    primary_.reserve(std::max(stack.size(), expected_stack_size));
+
+    for (const auto& element: stack)
+        primary_.emplace_back(element);
+}
+
+// Condition, alternate and operation_count are not copied.
+view_program::view_program(const chain::script& script, const view_program& other)
+  : script_(script),
+    transaction_(other.transaction_),
+    input_index_(other.input_index_),
+    forks_(other.forks_),
+    value_(other.value_),
+    version_(script_version::unversioned),
+    batch_(nullptr),
+    final_(false),
+    negative_count_(0),
+    operation_count_(0),
+    primary_(other.primary_)
+{
+}
+
+// Signature deferral.
+//-----------------------------------------------------------------------------
+
+// Batch and final are not copied by the program constructors.
+void view_program::set_batch(signature_batch& batch, bool final_result)
+{
+    batch_ = &batch;
+    final_ = final_result;
+}
+
+bool view_program::is_deferred() const
+{
+    return batch_ != nullptr;
+}
+
+// The last operation of a final program may be deferred.
+bool view_program::is_deferred(bool last) const
+{
+    return is_deferred() && final_ && last;
+}
+
+bool view_program::check_signature(const ec_signature& signature,
+    uint8_t sighash_type, const stack_item& public_key,
+    const chain::script& script_code, script_version version, bool deferrable)
+{
+    // This matches the empty key failure of script::check_signature.
+    if (public_key.empty())
+        return false;
+
+    // This always produces a valid signature hash, including one_hash.
+    const auto sighash = chain::script::generate_signature_hash(transaction_,
+        input_index_, script_code, sighash_type, version, value_);
+
+    if (!deferrable || !is_deferred())
+        return verify_signature(public_key, sighash, signature);
+
+    // A previously verified signature is not deferred.
+    if (!signature_verification_cache().contains(public_key, sighash,
+        signature))
+        batch_->push(public_key.to_chunk(), sighash, signature);
+
+    return true;
+}
+
+// Instructions.
+//-----------------------------------------------------------------------------
+
+code view_program::evaluate()
+{
+    return view_interpreter::run(*this);
+}
+
+} // namespace machine
+} // namespace system
+} // namespace libbitcoin
@@ -25,6 +25,7 @@
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <bitcoin/system/math/hash.hpp>
 #include <bitcoin/system/math/limits.hpp>
+#include <bitcoin/system/math/signature_cache.hpp>
 #include <bitcoin/system/utility/assert.hpp>
 #include <bitcoin/system/utility/data.hpp>
 #include <bitcoin/system/wallet/hd_private.hpp>
@@ -308,7 +309,7 @@ bool parse_endorsement(uint8_t& sighash_type, der_signature& der_signature,
     return true;
 }
 
-bool parse_signature(ec_signature& out, const der_signature& der_signature,
+bool parse_signature(ec_signature& out, const data_slice& der_signature,
     bool strict)
 {
     if (der_signature.empty())
@@ -385,6 +386,21 @@ bool verify_signature(const ec_uncompressed& point, const hash_digest& hash,
 
 bool verify_signature(const data_slice& point, const hash_digest& hash,
     const ec_signature& signature)
+{
+    auto& cache = signature_verification_cache();
+    if (cache.contains(point, hash, signature))
+        return true;
+
+    // The cache is bounded by its capacity, evicting the oldest entry.
+    if (!verify_signature_uncached(point, hash, signature))
+        return false;
+
+    cache.store(point, hash, signature);
+    return true;
+}
+
+bool verify_signature_uncached(const data_slice& point,
+    const hash_digest& hash, const ec_signature& signature)
 {
     // Copy to avoid exposing external types.
     secp256k1_ecdsa_signature parsed;
@@ -405,6 +421,12 @@ bool verify_signature(const data_slice& point, const hash_digest& hash,
         secp256k1_ecdsa_verify(context, &normal, hash.data(), &pubkey) == 1;
 }
 
+signature_cache& signature_verification_cache()
+{
+    static signature_cache cache(0);
+    return cache;
+}
+
 // Recoverable sign/recover
 // ----------------------------------------------------------------------------
 
@@ -0,0 +1,149 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "cpu_features.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef HAVE_X86
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#else
+    #include <cpuid.h>
+#endif
+
+/* cpuid leaf 1 */
+#define ECX_SSSE3   (1u << 9)
+#define ECX_SSE41   (1u << 19)
+#define ECX_OSXSAVE (1u << 27)
+#define ECX_AVX     (1u << 28)
+
+/* cpuid leaf 7, subleaf 0 */
+#define EBX_AVX2    (1u << 5)
+#define EBX_AVX512F (1u << 16)
+#define EBX_SHA     (1u << 29)
+
+/* xgetbv register 0 (xmm, ymm and zmm state enabled by the os) */
+#define XCR0_AVX    (0x06u)
+#define XCR0_AVX512 (0xe6u)
+
+static int cpuid(uint32_t leaf, uint32_t subleaf, uint32_t registers[4])
+{
+#if defined(_MSC_VER)
+    int values[4];
+    __cpuid(values, 0);
+    if ((uint32_t)values[0] < leaf)
+        return 0;
+
+    __cpuidex(values, (int)leaf, (int)subleaf);
+    registers[0] = (uint32_t)values[0];
+    registers[1] = (uint32_t)values[1];
+    registers[2] = (uint32_t)values[2];
+    registers[3] = (uint32_t)values[3];
+    return 1;
+#else
+    if (__get_cpuid_max(0, NULL) < leaf)
+        return 0;
+
+    __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2],
+        registers[3]);
+    return 1;
+#endif
+}
+
+static uint64_t xgetbv(void)
+{
+#if defined(_MSC_VER)
+    return (uint64_t)_xgetbv(0);
+#else
+    uint32_t low, high;
+    __asm__ __volatile__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return ((uint64_t)high << 32) | low;
+#endif
+}
+
+static uint32_t leaf1_ecx(void)
+{
+    uint32_t registers[4];
+    return cpuid(1, 0, registers) ? registers[2] : 0;
+}
+
+static uint32_t leaf7_ebx(void)
+{
+    uint32_t registers[4];
+    return cpuid(7, 0, registers) ? registers[1] : 0;
+}
+
+int have_sse41(void)
+{
+    const uint32_t ecx = leaf1_ecx();
+    return (ecx & ECX_SSSE3) != 0 && (ecx & ECX_SSE41) != 0;
+}
+
+int have_avx2(void)
+{
+    const uint32_t ecx = leaf1_ecx();
+    if ((ecx & ECX_OSXSAVE) == 0 || (ecx & ECX_AVX) == 0)
+        return 0;
+
+    if ((xgetbv() & XCR0_AVX) != XCR0_AVX)
+        return 0;
+
+    return have_sse41() && (leaf7_ebx() & EBX_AVX2) != 0;
+}
+
+int have_avx512(void)
+{
+    if (!have_avx2())
+        return 0;
+
+    if ((xgetbv() & XCR0_AVX512) != XCR0_AVX512)
+        return 0;
+
+    return (leaf7_ebx() & EBX_AVX512F) != 0;
+}
+
+int have_shani(void)
+{
+    return have_sse41() && (leaf7_ebx() & EBX_SHA) != 0;
+}
+
+#else
+
+int have_sse41(void)
+{
+    return 0;
+}
+
+int have_avx2(void)
+{
+    return 0;
+}
+
+int have_avx512(void)
+{
+    return 0;
+}
+
+int have_shani(void)
+{
+    return 0;
+}
+
+#endif
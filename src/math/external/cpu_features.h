@@ -0,0 +1,51 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_CPU_FEATURES_H
+#define LIBBITCOIN_SYSTEM_CPU_FEATURES_H
+
+#if defined(__x86_64__) || defined(__i386__) || \
+    defined(_M_X64) || defined(_M_IX86)
+    #define HAVE_X86
+#endif
+
+/* Function level instruction set targeting, allowing intrinsics to be used */
+/* without compiling the entire translation unit for the instruction set. */
+#if defined(HAVE_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define TARGET(features) __attribute__((target(features)))
+#else
+    #define TARGET(features)
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Each returns nonzero if the processor and operating system support the */
+/* instruction set extension. Results are always zero on non-x86 builds. */
+int have_sse41(void);
+int have_avx2(void);
+int have_avx512(void);
+int have_shani(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
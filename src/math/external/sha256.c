@@ -27,6 +27,7 @@
 
 #include <stdint.h>
 #include <string.h>
+#include "cpu_features.h"
 #include "zeroize.h"
 
 static uint32_t be32dec(const void* pp)
@@ -95,6 +96,96 @@ static unsigned char PAD[SHA256_BLOCK_LENGTH] =
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
 };
 
+const uint32_t SHA256K[64] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/* Second block of a 64 byte message (length 512 bits). */
+static const uint8_t PAD64[SHA256_BLOCK_LENGTH] =
+{
+    0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02, 0x00
+};
+
+/* Message schedule of PAD64 with round constants added. */
+const uint32_t SHA256PAD64[64] =
+{
+    0xc28a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf374,
+    0x649b69c1, 0xf0fe4786, 0x0fe1edc6, 0x240cf254,
+    0x4fe9346f, 0x6cc984be, 0x61b9411e, 0x16f988fa,
+    0xf2c65152, 0xa88e5a6d, 0xb019fc65, 0xb9d99ec7,
+    0x9a1231c3, 0xe70eeaa0, 0xfdb1232b, 0xc7353eb0,
+    0x3069bad5, 0xcb976d5f, 0x5a0f118f, 0xdc1eeefd,
+    0x0a35b689, 0xde0b7a04, 0x58f4ca9d, 0xe15d5b16,
+    0x007f3e86, 0x37088980, 0xa507ea32, 0x6fab9537,
+    0x17406110, 0x0d8cd6f1, 0xcdaa3b6d, 0xc0bbbe37,
+    0x83613bda, 0xdb48a363, 0x0b02e931, 0x6fd15ca7,
+    0x521afaca, 0x31338431, 0x6ed41a95, 0x6d437890,
+    0xc39c91f2, 0x9eccabbd, 0xb5c9a0e6, 0x532fb63c,
+    0xd2c741c6, 0x07237ea3, 0xa4954b68, 0x4c191d76
+};
+
+/* Padding that follows a 32 byte message (length 256 bits). */
+static const uint8_t PAD32[SHA256_DIGEST_LENGTH] =
+{
+    0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0x00
+};
+
+/* Padding that follows the last 16 bytes of an 80 byte message (640 bits). */
+static const uint8_t PAD80[SHA256_BLOCK_LENGTH - 16] =
+{
+    0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02, 0x80
+};
+
+static const uint32_t IV[SHA256_STATE_LENGTH] =
+{
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+    0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+/* The selection is shared by all threads, so it is accessed atomically. */
+/* Concurrent first use may repeat the selection, but all writers agree. */
+#if defined(_MSC_VER)
+    #include <intrin.h>
+    #define ATOMIC_INT volatile long
+    #define LOAD(variable) ((int)_InterlockedOr(&(variable), 0))
+    #define STORE(variable, value) \
+        ((void)_InterlockedExchange(&(variable), (long)(value)))
+#else
+    #define ATOMIC_INT int
+    #define LOAD(variable) __atomic_load_n(&(variable), __ATOMIC_ACQUIRE)
+    #define STORE(variable, value) \
+        __atomic_store_n(&(variable), (int)(value), __ATOMIC_RELEASE)
+#endif
+
+/* The compression backend and the widest parallel kernel (in lanes). */
+static ATOMIC_INT selected = -1;
+static ATOMIC_INT lanes = -1;
+
 void SHA256Pad(SHA256CTX* context);
 void SHA256Transform(uint32_t state[SHA256_STATE_LENGTH],
     const uint8_t block[SHA256_BLOCK_LENGTH]);
@@ -112,20 +203,15 @@ void SHA256Init(SHA256CTX* context)
 {
     context->count[0] = context->count[1] = 0;
 
-    context->state[0] = 0x6A09E667;
-    context->state[1] = 0xBB67AE85;
-    context->state[2] = 0x3C6EF372;
-    context->state[3] = 0xA54FF53A;
-    context->state[4] = 0x510E527F;
-    context->state[5] = 0x9B05688C;
-    context->state[6] = 0x1F83D9AB;
-    context->state[7] = 0x5BE0CD19;
+    memcpy(context->state, IV, sizeof IV);
 }
 
 void SHA256Update(SHA256CTX* context, const uint8_t* input, size_t length)
 {
     uint32_t bitlen[2];
     uint32_t r = (context->count[1] >> 3) & 0x3f;
+    SHA256Transformer transform;
+    size_t blocks;
 
     bitlen[1] = ((uint32_t)length) << 3;
     bitlen[0] = (uint32_t)(length >> 29);
@@ -143,17 +229,19 @@ void SHA256Update(SHA256CTX* context, const uint8_t* input, size_t length)
         return;
     }
 
+    transform = SHA256GetTransform();
     memcpy(&context->buf[r], input, 64 - r);
-    SHA256Transform(context->state, context->buf);
+    transform(context->state, context->buf, 1);
 
     input += 64 - r;
     length -= 64 - r;
 
-    while (length >= 64)
+    if (length >= 64)
     {
-        SHA256Transform(context->state, input);
-        input += 64;
-        length -= 64;
+        blocks = length / 64;
+        transform(context->state, input, blocks);
+        input += blocks * 64;
+        length -= blocks * 64;
     }
 
     memcpy(context->buf, input, length);
@@ -166,6 +254,262 @@ void SHA256Final(SHA256CTX* context, uint8_t digest[SHA256_DIGEST_LENGTH])
     zeroize((void*)context, sizeof *context);
 }
 
+void SHA256TransformScalar(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t* blocks, size_t count)
+{
+    for (; count > 0; --count, blocks += SHA256_BLOCK_LENGTH)
+    {
+        SHA256Transform(state, blocks);
+    }
+}
+
+void SHA256Rounds(uint32_t state[SHA256_STATE_LENGTH],
+    const uint32_t scheduled[64])
+{
+    int i;
+    uint32_t S[8];
+    uint32_t t0, t1;
+
+    memcpy(S, state, 32);
+
+    for (i = 0; i < 64; i += 8)
+    {
+        RND(S[0], S[1], S[2], S[3], S[4], S[5], S[6], S[7], scheduled[i + 0]);
+        RND(S[7], S[0], S[1], S[2], S[3], S[4], S[5], S[6], scheduled[i + 1]);
+        RND(S[6], S[7], S[0], S[1], S[2], S[3], S[4], S[5], scheduled[i + 2]);
+        RND(S[5], S[6], S[7], S[0], S[1], S[2], S[3], S[4], scheduled[i + 3]);
+        RND(S[4], S[5], S[6], S[7], S[0], S[1], S[2], S[3], scheduled[i + 4]);
+        RND(S[3], S[4], S[5], S[6], S[7], S[0], S[1], S[2], scheduled[i + 5]);
+        RND(S[2], S[3], S[4], S[5], S[6], S[7], S[0], S[1], scheduled[i + 6]);
+        RND(S[1], S[2], S[3], S[4], S[5], S[6], S[7], S[0], scheduled[i + 7]);
+    }
+
+    for (i = 0; i < 8; i++)
+    {
+        state[i] += S[i];
+    }
+
+    zeroize((void*)S, sizeof S);
+    zeroize((void*)&t0, sizeof t0);
+    zeroize((void*)&t1, sizeof t1);
+}
+
+int SHA256Available(SHA256Backend backend)
+{
+    switch (backend)
+    {
+        case SHA256_SCALAR:
+            return 1;
+        case SHA256_SSE41:
+            return have_sse41();
+        case SHA256_AVX2:
+            return have_avx2();
+        case SHA256_AVX512:
+            return have_avx512();
+        case SHA256_SHANI:
+            return have_shani();
+        default:
+            return 0;
+    }
+}
+
+/* The parallel kernels are independent of the compression backend, so */
+/* sha-ni uses the widest available. Other backends cap the lane width, */
+/* which allows each kernel to be selected (and scalar to disable all). */
+static int SHA256Lanes(SHA256Backend backend)
+{
+    switch (backend)
+    {
+        case SHA256_SHANI:
+            return have_avx512() ? 16 : have_avx2() ? 8 : have_sse41() ? 4 : 1;
+        case SHA256_AVX512:
+            return 16;
+        case SHA256_AVX2:
+            return 8;
+        case SHA256_SSE41:
+            return 4;
+        case SHA256_SCALAR:
+        default:
+            return 1;
+    }
+}
+
+SHA256Backend SHA256GetBackend(void)
+{
+    int backend = LOAD(selected);
+
+    if (backend < 0)
+    {
+        if (have_shani())
+            backend = SHA256_SHANI;
+        else if (have_avx512())
+            backend = SHA256_AVX512;
+        else if (have_avx2())
+            backend = SHA256_AVX2;
+        else if (have_sse41())
+            backend = SHA256_SSE41;
+        else
+            backend = SHA256_SCALAR;
+
+        STORE(lanes, SHA256Lanes((SHA256Backend)backend));
+        STORE(selected, backend);
+    }
+
+    return (SHA256Backend)backend;
+}
+
+int SHA256SetBackend(SHA256Backend backend)
+{
+    if (!SHA256Available(backend))
+        return 0;
+
+    STORE(lanes, SHA256Lanes(backend));
+    STORE(selected, backend);
+    return 1;
+}
+
+/* Get the widest parallel kernel in use (lanes are stored before the */
+/* backend, so a selected backend implies its lane width is visible). */
+static int SHA256GetLanes(void)
+{
+    int width = LOAD(lanes);
+
+    if (width < 0)
+    {
+        SHA256GetBackend();
+        width = LOAD(lanes);
+    }
+
+    return width;
+}
+
+SHA256Transformer SHA256GetTransform(void)
+{
+    switch (SHA256GetBackend())
+    {
+        case SHA256_SHANI:
+            return SHA256TransformSHANI;
+        case SHA256_AVX512:
+        case SHA256_AVX2:
+            return SHA256TransformAVX2;
+        case SHA256_SSE41:
+            return SHA256TransformSSE41;
+        case SHA256_SCALAR:
+        default:
+            return SHA256TransformScalar;
+    }
+}
+
+/* Single sha256 of a 32 byte message, the padding is constant. */
+static void SHA256S32(uint8_t digest[SHA256_DIGEST_LENGTH],
+    const uint8_t message[SHA256_DIGEST_LENGTH], SHA256Transformer transform)
+{
+    uint32_t state[SHA256_STATE_LENGTH];
+    uint8_t block[SHA256_BLOCK_LENGTH];
+
+    memcpy(state, IV, sizeof IV);
+    memcpy(block, message, SHA256_DIGEST_LENGTH);
+    memcpy(block + SHA256_DIGEST_LENGTH, PAD32, sizeof PAD32);
+    transform(state, block, 1);
+    be32enc_vect(digest, state, SHA256_DIGEST_LENGTH);
+}
+
+void SHA256D64(uint8_t digest[SHA256_DIGEST_LENGTH],
+    const uint8_t message[SHA256_BLOCK_LENGTH])
+{
+    uint32_t state[SHA256_STATE_LENGTH];
+    uint8_t first[SHA256_DIGEST_LENGTH];
+    const SHA256Transformer transform = SHA256GetTransform();
+
+    memcpy(state, IV, sizeof IV);
+    transform(state, message, 1);
+
+    /* The padding block schedule is precomputed, except for sha-ni which */
+    /* computes the schedule in hardware (faster than the scalar rounds). */
+    if (transform == SHA256TransformSHANI)
+        transform(state, PAD64, 1);
+    else
+        SHA256Rounds(state, SHA256PAD64);
+
+    be32enc_vect(first, state, SHA256_DIGEST_LENGTH);
+    SHA256S32(digest, first, transform);
+}
+
+void SHA256D80(uint8_t digest[SHA256_DIGEST_LENGTH],
+    const uint8_t message[80])
+{
+    uint32_t state[SHA256_STATE_LENGTH];
+    uint8_t block[SHA256_BLOCK_LENGTH];
+    uint8_t first[SHA256_DIGEST_LENGTH];
+    const SHA256Transformer transform = SHA256GetTransform();
+
+    memcpy(state, IV, sizeof IV);
+    memcpy(block, message + SHA256_BLOCK_LENGTH, 16);
+    memcpy(block + 16, PAD80, sizeof PAD80);
+    transform(state, message, 1);
+    transform(state, block, 1);
+
+    be32enc_vect(first, state, SHA256_DIGEST_LENGTH);
+    SHA256S32(digest, first, transform);
+}
+
+void SHA256Double64(uint8_t* digests, const uint8_t* blocks, size_t count)
+{
+#ifdef HAVE_X86
+    const int width = SHA256GetLanes();
+
+    if (width >= 16)
+    {
+        for (; count >= 16; count -= 16, digests += 16 * 32, blocks += 16 * 64)
+            SHA256Double64AVX512(digests, blocks);
+    }
+
+    if (width >= 8)
+    {
+        for (; count >= 8; count -= 8, digests += 8 * 32, blocks += 8 * 64)
+            SHA256Double64AVX2(digests, blocks);
+    }
+
+    if (width >= 4)
+    {
+        for (; count >= 4; count -= 4, digests += 4 * 32, blocks += 4 * 64)
+            SHA256Double64SSE41(digests, blocks);
+    }
+#endif
+
+    for (; count > 0; --count, digests += 32, blocks += 64)
+        SHA256D64(digests, blocks);
+}
+
+void SHA256Single32(uint8_t* digests, const uint8_t* messages, size_t count)
+{
+#ifdef HAVE_X86
+    const int width = SHA256GetLanes();
+
+    if (width >= 16)
+    {
+        for (; count >= 16; count -= 16, digests += 16 * 32,
+            messages += 16 * 32)
+            SHA256Single32AVX512(digests, messages);
+    }
+
+    if (width >= 8)
+    {
+        for (; count >= 8; count -= 8, digests += 8 * 32, messages += 8 * 32)
+            SHA256Single32AVX2(digests, messages);
+    }
+
+    if (width >= 4)
+    {
+        for (; count >= 4; count -= 4, digests += 4 * 32, messages += 4 * 32)
+            SHA256Single32SSE41(digests, messages);
+    }
+#endif
+
+    for (; count > 0; --count, digests += 32, messages += 32)
+        SHA256S32(digests, messages, SHA256GetTransform());
+}
+
 /* Local */
 
 void SHA256Pad(SHA256CTX* context)
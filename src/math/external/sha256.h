@@ -46,6 +46,13 @@ typedef struct SHA256CTX
     uint8_t buf[SHA256_BLOCK_LENGTH];
 } SHA256CTX;
 
+/* Round constants. */
+extern const uint32_t SHA256K[64];
+
+/* Compress count consecutive 64 byte blocks into state. */
+typedef void (*SHA256Transformer)(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t* blocks, size_t count);
+
 void SHA256_(const uint8_t* input, size_t length,
     uint8_t digest[SHA256_DIGEST_LENGTH]);
 
@@ -53,6 +60,70 @@ void SHA256Init(SHA256CTX* context);
 void SHA256Update(SHA256CTX* context, const uint8_t* input, size_t length);
 void SHA256Final(SHA256CTX* context, uint8_t digest[SHA256_DIGEST_LENGTH]);
 
+/* Compression function implementations, the scalar form is portable. */
+/* The others may only be called if indicated by cpu_features.h. */
+void SHA256TransformScalar(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t* blocks, size_t count);
+void SHA256TransformSSE41(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t* blocks, size_t count);
+void SHA256TransformAVX2(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t* blocks, size_t count);
+void SHA256TransformSHANI(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t* blocks, size_t count);
+
+/* Multiple lane (4, 8 and 16) kernels, hashing independent messages. */
+/* These may only be called if indicated by cpu_features.h. */
+void SHA256Double64SSE41(uint8_t* digests, const uint8_t* blocks);
+void SHA256Double64AVX2(uint8_t* digests, const uint8_t* blocks);
+void SHA256Double64AVX512(uint8_t* digests, const uint8_t* blocks);
+void SHA256Single32SSE41(uint8_t* digests, const uint8_t* messages);
+void SHA256Single32AVX2(uint8_t* digests, const uint8_t* messages);
+void SHA256Single32AVX512(uint8_t* digests, const uint8_t* messages);
+
+/* Apply 64 rounds given the message schedule with round constants added. */
+void SHA256Rounds(uint32_t state[SHA256_STATE_LENGTH],
+    const uint32_t scheduled[64]);
+
+/* Message schedule of the padding block of a 64 byte message, plus SHA256K. */
+extern const uint32_t SHA256PAD64[64];
+
+/* Double sha256 of a 64 byte message (such as a pair of merkle nodes). */
+/* These are not zeroized, they are intended for public data only. */
+void SHA256D64(uint8_t digest[SHA256_DIGEST_LENGTH],
+    const uint8_t message[SHA256_BLOCK_LENGTH]);
+
+/* Double sha256 of an 80 byte message (such as a block header). */
+void SHA256D80(uint8_t digest[SHA256_DIGEST_LENGTH],
+    const uint8_t message[80]);
+
+/* Double sha256 of count 64 byte blocks into count 32 byte digests. */
+void SHA256Double64(uint8_t* digests, const uint8_t* blocks, size_t count);
+
+/* Single sha256 of count 32 byte messages into count 32 byte digests. */
+void SHA256Single32(uint8_t* digests, const uint8_t* messages, size_t count);
+
+/* Instruction set extensions in order of preference for multiple lanes. */
+typedef enum SHA256Backend
+{
+    SHA256_SCALAR,
+    SHA256_SSE41,
+    SHA256_AVX2,
+    SHA256_AVX512,
+    SHA256_SHANI
+} SHA256Backend;
+
+/* Determine if the backend is supported by the processor and os. */
+int SHA256Available(SHA256Backend backend);
+
+/* Get the backend in use (initially the fastest available). */
+SHA256Backend SHA256GetBackend(void);
+
+/* Set the backend in use if available (intended for test/bench). */
+int SHA256SetBackend(SHA256Backend backend);
+
+/* Get the compression function of the backend in use. */
+SHA256Transformer SHA256GetTransform(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,156 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "sha256.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include "cpu_features.h"
+#include "zeroize.h"
+
+#ifdef HAVE_X86
+
+#include <immintrin.h>
+
+/* The message schedules of two consecutive blocks are computed together, */
+/* one in each 128 bit lane, four words at a time. The lane-local shuffles */
+/* keep the schedules independent. Rounds remain sequential across blocks, */
+/* and scalar. Only the eight lane kernels below (batches of messages) */
+/* vectorize the rounds. */
+
+#define ROTR(x, n) \
+    _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n))
+
+#define s0(x) _mm256_xor_si256(_mm256_xor_si256( \
+    ROTR(x, 7), ROTR(x, 18)), _mm256_srli_epi32(x, 3))
+
+#define s1(x) _mm256_xor_si256(_mm256_xor_si256( \
+    ROTR(x, 17), ROTR(x, 19)), _mm256_srli_epi32(x, 10))
+
+/* w0..w3 hold words i-16..i-1, the result holds words i..i+3. */
+#define SCHEDULE(w0, w1, w2, w3, result) \
+    result = _mm256_add_epi32(_mm256_add_epi32(w0, \
+        s0(_mm256_alignr_epi8(w1, w0, 4))), _mm256_alignr_epi8(w3, w2, 4)); \
+    result = _mm256_add_epi32(result, s1(_mm256_bsrli_epi128(w3, 8))); \
+    result = _mm256_add_epi32(result, s1(_mm256_bslli_epi128(result, 8)))
+
+#define LOAD(blocks, i, mask) _mm256_shuffle_epi8(_mm256_inserti128_si256( \
+    _mm256_castsi128_si256(_mm_loadu_si128( \
+        (const __m128i*)((blocks) + (i) * 16))), \
+    _mm_loadu_si128((const __m128i*)((blocks) + SHA256_BLOCK_LENGTH + \
+        (i) * 16)), 1), mask)
+
+#define STORE(first, second, i, words) \
+    words = _mm256_add_epi32(words, _mm256_broadcastsi128_si256( \
+        _mm_loadu_si128((const __m128i*)(SHA256K + (i) * 4)))); \
+    _mm_storeu_si128((__m128i*)((first) + (i) * 4), \
+        _mm256_castsi256_si128(words)); \
+    _mm_storeu_si128((__m128i*)((second) + (i) * 4), \
+        _mm256_extracti128_si256(words, 1))
+
+TARGET("avx2")
+void SHA256TransformAVX2(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t* blocks, size_t count)
+{
+    int i;
+    uint32_t first[64];
+    uint32_t second[64];
+    __m256i w0, w1, w2, w3, w4, sum;
+    const __m256i mask = _mm256_set_epi64x(
+        0x0c0d0e0f08090a0bull, 0x0405060700010203ull,
+        0x0c0d0e0f08090a0bull, 0x0405060700010203ull);
+    const int paired = count > 1;
+
+    for (; count > 1; count -= 2, blocks += 2 * SHA256_BLOCK_LENGTH)
+    {
+        w0 = LOAD(blocks, 0, mask);
+        w1 = LOAD(blocks, 1, mask);
+        w2 = LOAD(blocks, 2, mask);
+        w3 = LOAD(blocks, 3, mask);
+        sum = w0; STORE(first, second, 0, sum);
+        sum = w1; STORE(first, second, 1, sum);
+        sum = w2; STORE(first, second, 2, sum);
+        sum = w3; STORE(first, second, 3, sum);
+
+        for (i = 4; i < 16; ++i)
+        {
+            SCHEDULE(w0, w1, w2, w3, w4);
+            sum = w4; STORE(first, second, i, sum);
+            w0 = w1;
+            w1 = w2;
+            w2 = w3;
+            w3 = w4;
+        }
+
+        SHA256Rounds(state, first);
+        SHA256Rounds(state, second);
+    }
+
+    /* Avoid the cost of clearing unused buffers for a single block. */
+    if (paired)
+    {
+        zeroize((void*)first, sizeof first);
+        zeroize((void*)second, sizeof second);
+    }
+
+    if (count > 0)
+        SHA256TransformSSE41(state, blocks, count);
+}
+
+#undef ROTR
+#undef s0
+#undef s1
+#undef LOAD
+#undef STORE
+
+#define LANES 8
+#define VECTOR __m256i
+#define LANE_TARGET TARGET("avx2")
+#define LANE_NAME(name) SHA256##name##AVX2
+#define ADD(x, y) _mm256_add_epi32(x, y)
+#define XOR(x, y) _mm256_xor_si256(x, y)
+#define AND(x, y) _mm256_and_si256(x, y)
+#define OR(x, y) _mm256_or_si256(x, y)
+#define SHL(x, n) _mm256_slli_epi32(x, n)
+#define SHR(x, n) _mm256_srli_epi32(x, n)
+#define SET1(x) _mm256_set1_epi32((int)(x))
+
+#define GATHER(in, stride, word) _mm256_set_epi32( \
+    LANE_READ(in, stride, word, 7), LANE_READ(in, stride, word, 6), \
+    LANE_READ(in, stride, word, 5), LANE_READ(in, stride, word, 4), \
+    LANE_READ(in, stride, word, 3), LANE_READ(in, stride, word, 2), \
+    LANE_READ(in, stride, word, 1), LANE_READ(in, stride, word, 0))
+
+#define SCATTER(out, stride, word, vector) \
+    { \
+        uint32_t values_[LANES]; \
+        _mm256_storeu_si256((__m256i*)values_, vector); \
+        LANE_WRITE(out, stride, word, values_) \
+    }
+
+#include "sha256_lanes.h"
+
+#else
+
+void SHA256TransformAVX2(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t* blocks, size_t count)
+{
+    SHA256TransformScalar(state, blocks, count);
+}
+
+#endif
@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "sha256.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include "cpu_features.h"
+
+#ifdef HAVE_X86
+
+#include <immintrin.h>
+
+/* AVX-512 provides no single message benefit over AVX2, only more lanes. */
+
+#define LANES 16
+#define VECTOR __m512i
+#define LANE_TARGET TARGET("avx512f")
+#define LANE_NAME(name) SHA256##name##AVX512
+#define ADD(x, y) _mm512_add_epi32(x, y)
+#define XOR(x, y) _mm512_xor_si512(x, y)
+#define AND(x, y) _mm512_and_si512(x, y)
+#define OR(x, y) _mm512_or_si512(x, y)
+#define SHL(x, n) _mm512_slli_epi32(x, n)
+#define SHR(x, n) _mm512_srli_epi32(x, n)
+#define SET1(x) _mm512_set1_epi32((int)(x))
+
+#define GATHER(in, stride, word) _mm512_set_epi32( \
+    LANE_READ(in, stride, word, 15), LANE_READ(in, stride, word, 14), \
+    LANE_READ(in, stride, word, 13), LANE_READ(in, stride, word, 12), \
+    LANE_READ(in, stride, word, 11), LANE_READ(in, stride, word, 10), \
+    LANE_READ(in, stride, word, 9), LANE_READ(in, stride, word, 8), \
+    LANE_READ(in, stride, word, 7), LANE_READ(in, stride, word, 6), \
+    LANE_READ(in, stride, word, 5), LANE_READ(in, stride, word, 4), \
+    LANE_READ(in, stride, word, 3), LANE_READ(in, stride, word, 2), \
+    LANE_READ(in, stride, word, 1), LANE_READ(in, stride, word, 0))
+
+#define SCATTER(out, stride, word, vector) \
+    { \
+        uint32_t values_[LANES]; \
+        _mm512_storeu_si512((void*)values_, vector); \
+        LANE_WRITE(out, stride, word, values_) \
+    }
+
+#include "sha256_lanes.h"
+
+#endif
@@ -0,0 +1,240 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Multiple lane sha256 kernels, included by each instruction set source. */
+/* The includer defines the lane count, vector type, operations and naming: */
+/* LANES, VECTOR, LANE_TARGET, LANE_NAME(name), ADD(x, y), XOR(x, y), */
+/* AND(x, y), OR(x, y), SHL(x, n), SHR(x, n), SET1(x), GATHER(in, stride, */
+/* word) and SCATTER(out, stride, word, vector), the latter two by way of */
+/* LANE_READ and LANE_WRITE. Each lane is an independent message, so a vector */
+/* holds the same word of each message. */
+
+static uint32_t lane_decode(const uint8_t* p)
+{
+    return ((uint32_t)(p[3]) + ((uint32_t)(p[2]) << 8) +
+        ((uint32_t)(p[1]) << 16) + ((uint32_t)(p[0]) << 24));
+}
+
+static void lane_encode(uint8_t* p, uint32_t x)
+{
+    p[3] = x & 0xff;
+    p[2] = (x >> 8) & 0xff;
+    p[1] = (x >> 16) & 0xff;
+    p[0] = (x >> 24) & 0xff;
+}
+
+/* Read word of lane from messages of stride bytes (big endian). */
+#define LANE_READ(in, stride, word, lane) \
+    (int)lane_decode((in) + (lane) * (stride) + (word) * 4)
+
+/* Write word of each lane to messages of stride bytes (big endian). */
+#define LANE_WRITE(out, stride, word, values) \
+    { \
+        int lane_; \
+        for (lane_ = 0; lane_ < LANES; ++lane_) \
+            lane_encode((out) + lane_ * (stride) + (word) * 4, \
+                values[lane_]); \
+    }
+
+#define LANE_ROTR(x, n) OR(SHR(x, n), SHL(x, 32 - n))
+#define LANE_CH(x, y, z) XOR(AND(x, XOR(y, z)), z)
+#define LANE_MAJ(x, y, z) OR(AND(x, OR(y, z)), AND(y, z))
+#define LANE_S0(x) XOR(XOR(LANE_ROTR(x, 2), LANE_ROTR(x, 13)), LANE_ROTR(x, 22))
+#define LANE_S1(x) XOR(XOR(LANE_ROTR(x, 6), LANE_ROTR(x, 11)), LANE_ROTR(x, 25))
+#define LANE_s0(x) XOR(XOR(LANE_ROTR(x, 7), LANE_ROTR(x, 18)), SHR(x, 3))
+#define LANE_s1(x) XOR(XOR(LANE_ROTR(x, 17), LANE_ROTR(x, 19)), SHR(x, 10))
+
+/* Round given the message word plus round constant. */
+#define LANE_ROUND_K(a, b, c, d, e, f, g, h, scheduled) \
+    t0 = ADD(ADD(h, LANE_S1(e)), ADD(LANE_CH(e, f, g), scheduled)); \
+    t1 = ADD(LANE_S0(a), LANE_MAJ(a, b, c)); \
+    d = ADD(d, t0); \
+    h = ADD(t0, t1)
+
+#define LANE_ROUND(a, b, c, d, e, f, g, h, word, i) \
+    LANE_ROUND_K(a, b, c, d, e, f, g, h, ADD(word, SET1(SHA256K[i])))
+
+#define LANE_EXPAND(w, i) \
+    w[(i) & 15] = ADD(ADD(w[(i) & 15], LANE_s1(w[((i) - 2) & 15])), \
+        ADD(w[((i) - 7) & 15], LANE_s0(w[((i) - 15) & 15])))
+
+#define LANE_ROUNDS(S, w, i) \
+    LANE_ROUND(S[0], S[1], S[2], S[3], S[4], S[5], S[6], S[7], w[0], i + 0); \
+    LANE_ROUND(S[7], S[0], S[1], S[2], S[3], S[4], S[5], S[6], w[1], i + 1); \
+    LANE_ROUND(S[6], S[7], S[0], S[1], S[2], S[3], S[4], S[5], w[2], i + 2); \
+    LANE_ROUND(S[5], S[6], S[7], S[0], S[1], S[2], S[3], S[4], w[3], i + 3); \
+    LANE_ROUND(S[4], S[5], S[6], S[7], S[0], S[1], S[2], S[3], w[4], i + 4); \
+    LANE_ROUND(S[3], S[4], S[5], S[6], S[7], S[0], S[1], S[2], w[5], i + 5); \
+    LANE_ROUND(S[2], S[3], S[4], S[5], S[6], S[7], S[0], S[1], w[6], i + 6); \
+    LANE_ROUND(S[1], S[2], S[3], S[4], S[5], S[6], S[7], S[0], w[7], i + 7); \
+    LANE_ROUND(S[0], S[1], S[2], S[3], S[4], S[5], S[6], S[7], w[8], i + 8); \
+    LANE_ROUND(S[7], S[0], S[1], S[2], S[3], S[4], S[5], S[6], w[9], i + 9); \
+    LANE_ROUND(S[6], S[7], S[0], S[1], S[2], S[3], S[4], S[5], w[10], i + 10); \
+    LANE_ROUND(S[5], S[6], S[7], S[0], S[1], S[2], S[3], S[4], w[11], i + 11); \
+    LANE_ROUND(S[4], S[5], S[6], S[7], S[0], S[1], S[2], S[3], w[12], i + 12); \
+    LANE_ROUND(S[3], S[4], S[5], S[6], S[7], S[0], S[1], S[2], w[13], i + 13); \
+    LANE_ROUND(S[2], S[3], S[4], S[5], S[6], S[7], S[0], S[1], w[14], i + 14); \
+    LANE_ROUND(S[1], S[2], S[3], S[4], S[5], S[6], S[7], S[0], w[15], i + 15)
+
+/* Compress the sixteen message words into state, consuming the words. */
+LANE_TARGET
+static void LANE_NAME(LanesTransform)(VECTOR state[8], VECTOR w[16])
+{
+    int i, j;
+    VECTOR t0, t1;
+    VECTOR S[8];
+
+    for (i = 0; i < 8; ++i)
+        S[i] = state[i];
+
+    LANE_ROUNDS(S, w, 0);
+
+    for (i = 16; i < 64; i += 16)
+    {
+        for (j = 0; j < 16; ++j)
+        {
+            LANE_EXPAND(w, j);
+        }
+
+        LANE_ROUNDS(S, w, i);
+    }
+
+    for (i = 0; i < 8; ++i)
+        state[i] = ADD(state[i], S[i]);
+}
+
+/* Compress the constant padding block of a 64 byte message into state. */
+LANE_TARGET
+static void LANE_NAME(LanesTransformPad64)(VECTOR state[8])
+{
+    int i;
+    VECTOR t0, t1;
+    VECTOR S[8];
+
+    for (i = 0; i < 8; ++i)
+        S[i] = state[i];
+
+    for (i = 0; i < 64; i += 8)
+    {
+        LANE_ROUND_K(S[0], S[1], S[2], S[3], S[4], S[5], S[6], S[7],
+            SET1(SHA256PAD64[i + 0]));
+        LANE_ROUND_K(S[7], S[0], S[1], S[2], S[3], S[4], S[5], S[6],
+            SET1(SHA256PAD64[i + 1]));
+        LANE_ROUND_K(S[6], S[7], S[0], S[1], S[2], S[3], S[4], S[5],
+            SET1(SHA256PAD64[i + 2]));
+        LANE_ROUND_K(S[5], S[6], S[7], S[0], S[1], S[2], S[3], S[4],
+            SET1(SHA256PAD64[i + 3]));
+        LANE_ROUND_K(S[4], S[5], S[6], S[7], S[0], S[1], S[2], S[3],
+            SET1(SHA256PAD64[i + 4]));
+        LANE_ROUND_K(S[3], S[4], S[5], S[6], S[7], S[0], S[1], S[2],
+            SET1(SHA256PAD64[i + 5]));
+        LANE_ROUND_K(S[2], S[3], S[4], S[5], S[6], S[7], S[0], S[1],
+            SET1(SHA256PAD64[i + 6]));
+        LANE_ROUND_K(S[1], S[2], S[3], S[4], S[5], S[6], S[7], S[0],
+            SET1(SHA256PAD64[i + 7]));
+    }
+
+    for (i = 0; i < 8; ++i)
+        state[i] = ADD(state[i], S[i]);
+}
+
+LANE_TARGET
+static void LANE_NAME(LanesInitialize)(VECTOR state[8])
+{
+    state[0] = SET1(0x6a09e667);
+    state[1] = SET1(0xbb67ae85);
+    state[2] = SET1(0x3c6ef372);
+    state[3] = SET1(0xa54ff53a);
+    state[4] = SET1(0x510e527f);
+    state[5] = SET1(0x9b05688c);
+    state[6] = SET1(0x1f83d9ab);
+    state[7] = SET1(0x5be0cd19);
+}
+
+/* Pad a message of eight words (a digest) into sixteen words. */
+LANE_TARGET
+static void LANE_NAME(LanesPadDigest)(VECTOR w[16])
+{
+    int i;
+    w[8] = SET1(0x80000000);
+
+    for (i = 9; i < 15; ++i)
+        w[i] = SET1(0);
+
+    w[15] = SET1(256);
+}
+
+/* Double sha256 of LANES consecutive 64 byte messages. */
+LANE_TARGET
+void LANE_NAME(Double64)(uint8_t* digests, const uint8_t* blocks)
+{
+    int i;
+    VECTOR state[8];
+    VECTOR w[16];
+
+    LANE_NAME(LanesInitialize)(state);
+
+    for (i = 0; i < 16; ++i)
+        w[i] = GATHER(blocks, 64, i);
+
+    LANE_NAME(LanesTransform)(state, w);
+    LANE_NAME(LanesTransformPad64)(state);
+
+    for (i = 0; i < 8; ++i)
+        w[i] = state[i];
+
+    LANE_NAME(LanesPadDigest)(w);
+    LANE_NAME(LanesInitialize)(state);
+    LANE_NAME(LanesTransform)(state, w);
+
+    for (i = 0; i < 8; ++i)
+        SCATTER(digests, 32, i, state[i]);
+}
+
+/* Single sha256 of LANES consecutive 32 byte messages. */
+LANE_TARGET
+void LANE_NAME(Single32)(uint8_t* digests, const uint8_t* messages)
+{
+    int i;
+    VECTOR state[8];
+    VECTOR w[16];
+
+    for (i = 0; i < 8; ++i)
+        w[i] = GATHER(messages, 32, i);
+
+    LANE_NAME(LanesPadDigest)(w);
+    LANE_NAME(LanesInitialize)(state);
+    LANE_NAME(LanesTransform)(state, w);
+
+    for (i = 0; i < 8; ++i)
+        SCATTER(digests, 32, i, state[i]);
+}
+
+#undef LANE_ROTR
+#undef LANE_CH
+#undef LANE_MAJ
+#undef LANE_S0
+#undef LANE_S1
+#undef LANE_s0
+#undef LANE_s1
+#undef LANE_ROUND_K
+#undef LANE_ROUND
+#undef LANE_EXPAND
+#undef LANE_ROUNDS
+#undef LANE_READ
+#undef LANE_WRITE
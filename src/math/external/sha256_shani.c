@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "sha256.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include "cpu_features.h"
+
+#ifdef HAVE_X86
+
+#include <immintrin.h>
+
+/* Based on the public domain intrinsics of Intel (Sean Gulley) and */
+/* Jeffrey Walton. State is held as ABEF/CDGH for sha256rnds2. */
+
+#define KEY(i) _mm_loadu_si128((const __m128i*)(SHA256K + (i) * 4))
+
+/* Four rounds using (and no further scheduling of) the message words. */
+#define ROUNDS(message, i) \
+    value = _mm_add_epi32(message, KEY(i)); \
+    state1 = _mm_sha256rnds2_epu32(state1, state0, value); \
+    value = _mm_shuffle_epi32(value, 0x0e); \
+    state0 = _mm_sha256rnds2_epu32(state0, state1, value)
+
+/* Four rounds, completing the next words and starting those after them. */
+#define SCHEDULED(current, previous, next, after, i) \
+    value = _mm_add_epi32(current, KEY(i)); \
+    state1 = _mm_sha256rnds2_epu32(state1, state0, value); \
+    next = _mm_add_epi32(next, _mm_alignr_epi8(current, previous, 4)); \
+    next = _mm_sha256msg2_epu32(next, current); \
+    value = _mm_shuffle_epi32(value, 0x0e); \
+    state0 = _mm_sha256rnds2_epu32(state0, state1, value); \
+    after = _mm_sha256msg1_epu32(after, current)
+
+#define LOAD(block, i, mask) _mm_shuffle_epi8( \
+    _mm_loadu_si128((const __m128i*)((block) + (i) * 16)), mask)
+
+TARGET("sha,sse4.1")
+void SHA256TransformSHANI(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t* blocks, size_t count)
+{
+    __m128i state0, state1, value, save0, save1, w0, w1, w2, w3;
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bull,
+        0x0405060700010203ull);
+
+    /* Convert ABCD/EFGH to ABEF/CDGH. */
+    value = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[0]),
+        0xb1);
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[4]),
+        0x1b);
+    state0 = _mm_alignr_epi8(value, state1, 8);
+    state1 = _mm_blend_epi16(state1, value, 0xf0);
+
+    for (; count > 0; --count, blocks += SHA256_BLOCK_LENGTH)
+    {
+        save0 = state0;
+        save1 = state1;
+
+        w0 = LOAD(blocks, 0, mask);
+        w1 = LOAD(blocks, 1, mask);
+        w2 = LOAD(blocks, 2, mask);
+        w3 = LOAD(blocks, 3, mask);
+
+        ROUNDS(w0, 0);
+        ROUNDS(w1, 1);
+        w0 = _mm_sha256msg1_epu32(w0, w1);
+        ROUNDS(w2, 2);
+        w1 = _mm_sha256msg1_epu32(w1, w2);
+        SCHEDULED(w3, w2, w0, w2, 3);
+        SCHEDULED(w0, w3, w1, w3, 4);
+        SCHEDULED(w1, w0, w2, w0, 5);
+        SCHEDULED(w2, w1, w3, w1, 6);
+        SCHEDULED(w3, w2, w0, w2, 7);
+        SCHEDULED(w0, w3, w1, w3, 8);
+        SCHEDULED(w1, w0, w2, w0, 9);
+        SCHEDULED(w2, w1, w3, w1, 10);
+        SCHEDULED(w3, w2, w0, w2, 11);
+        SCHEDULED(w0, w3, w1, w3, 12);
+
+        /* Rounds 52-59 need no further message expansion. */
+        value = _mm_add_epi32(w1, KEY(13));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, value);
+        w2 = _mm_add_epi32(w2, _mm_alignr_epi8(w1, w0, 4));
+        w2 = _mm_sha256msg2_epu32(w2, w1);
+        value = _mm_shuffle_epi32(value, 0x0e);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, value);
+
+        value = _mm_add_epi32(w2, KEY(14));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, value);
+        w3 = _mm_add_epi32(w3, _mm_alignr_epi8(w2, w1, 4));
+        w3 = _mm_sha256msg2_epu32(w3, w2);
+        value = _mm_shuffle_epi32(value, 0x0e);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, value);
+
+        ROUNDS(w3, 15);
+
+        state0 = _mm_add_epi32(state0, save0);
+        state1 = _mm_add_epi32(state1, save1);
+    }
+
+    /* Convert ABEF/CDGH to ABCD/EFGH. */
+    value = _mm_shuffle_epi32(state0, 0x1b);
+    state1 = _mm_shuffle_epi32(state1, 0xb1);
+    state0 = _mm_blend_epi16(value, state1, 0xf0);
+    state1 = _mm_alignr_epi8(state1, value, 8);
+
+    _mm_storeu_si128((__m128i*)&state[0], state0);
+    _mm_storeu_si128((__m128i*)&state[4], state1);
+}
+
+#else
+
+void SHA256TransformSHANI(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t* blocks, size_t count)
+{
+    SHA256TransformScalar(state, blocks, count);
+}
+
+#endif
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "sha256.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include "cpu_features.h"
+#include "zeroize.h"
+
+#ifdef HAVE_X86
+
+#include <immintrin.h>
+
+/* The message schedule is computed four words at a time. */
+/* W[i] = s1(W[i-2]) + W[i-7] + s0(W[i-15]) + W[i-16] */
+/* The s1 dependency on W[i-2] requires the upper two words in a second pass. */
+/* The rounds of a message are sequential, so they remain scalar here. Only */
+/* the four lane kernels below (batches of messages) vectorize the rounds. */
+
+#define ROTR(x, n) \
+    _mm_or_si128(_mm_srli_epi32(x, n), _mm_slli_epi32(x, 32 - n))
+
+#define s0(x) _mm_xor_si128(_mm_xor_si128( \
+    ROTR(x, 7), ROTR(x, 18)), _mm_srli_epi32(x, 3))
+
+#define s1(x) _mm_xor_si128(_mm_xor_si128( \
+    ROTR(x, 17), ROTR(x, 19)), _mm_srli_epi32(x, 10))
+
+/* w0..w3 hold words i-16..i-1, the result holds words i..i+3. */
+#define SCHEDULE(w0, w1, w2, w3, result) \
+    result = _mm_add_epi32(_mm_add_epi32(w0, s0(_mm_alignr_epi8(w1, w0, 4))), \
+        _mm_alignr_epi8(w3, w2, 4)); \
+    result = _mm_add_epi32(result, s1(_mm_srli_si128(w3, 8))); \
+    result = _mm_add_epi32(result, s1(_mm_slli_si128(result, 8)))
+
+#define LOAD(block, i, mask) _mm_shuffle_epi8( \
+    _mm_loadu_si128((const __m128i*)((block) + (i) * 16)), mask)
+
+#define STORE(scheduled, i, words) _mm_storeu_si128( \
+    (__m128i*)((scheduled) + (i) * 4), _mm_add_epi32(words, \
+        _mm_loadu_si128((const __m128i*)(SHA256K + (i) * 4))))
+
+TARGET("sse4.1")
+void SHA256TransformSSE41(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t* blocks, size_t count)
+{
+    int i;
+    uint32_t scheduled[64];
+    __m128i w0, w1, w2, w3, w4;
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bull,
+        0x0405060700010203ull);
+
+    for (; count > 0; --count, blocks += SHA256_BLOCK_LENGTH)
+    {
+        w0 = LOAD(blocks, 0, mask);
+        w1 = LOAD(blocks, 1, mask);
+        w2 = LOAD(blocks, 2, mask);
+        w3 = LOAD(blocks, 3, mask);
+        STORE(scheduled, 0, w0);
+        STORE(scheduled, 1, w1);
+        STORE(scheduled, 2, w2);
+        STORE(scheduled, 3, w3);
+
+        for (i = 4; i < 16; ++i)
+        {
+            SCHEDULE(w0, w1, w2, w3, w4);
+            STORE(scheduled, i, w4);
+            w0 = w1;
+            w1 = w2;
+            w2 = w3;
+            w3 = w4;
+        }
+
+        SHA256Rounds(state, scheduled);
+    }
+
+    zeroize((void*)scheduled, sizeof scheduled);
+}
+
+#undef ROTR
+#undef s0
+#undef s1
+#undef LOAD
+#undef STORE
+
+#define LANES 4
+#define VECTOR __m128i
+#define LANE_TARGET TARGET("sse4.1")
+#define LANE_NAME(name) SHA256##name##SSE41
+#define ADD(x, y) _mm_add_epi32(x, y)
+#define XOR(x, y) _mm_xor_si128(x, y)
+#define AND(x, y) _mm_and_si128(x, y)
+#define OR(x, y) _mm_or_si128(x, y)
+#define SHL(x, n) _mm_slli_epi32(x, n)
+#define SHR(x, n) _mm_srli_epi32(x, n)
+#define SET1(x) _mm_set1_epi32((int)(x))
+
+#define GATHER(in, stride, word) _mm_set_epi32( \
+    LANE_READ(in, stride, word, 3), LANE_READ(in, stride, word, 2), \
+    LANE_READ(in, stride, word, 1), LANE_READ(in, stride, word, 0))
+
+#define SCATTER(out, stride, word, vector) \
+    { \
+        uint32_t values_[LANES]; \
+        _mm_storeu_si128((__m128i*)values_, vector); \
+        LANE_WRITE(out, stride, word, values_) \
+    }
+
+#include "sha256_lanes.h"
+
+#else
+
+void SHA256TransformSSE41(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t* blocks, size_t count)
+{
+    SHA256TransformScalar(state, blocks, count);
+}
+
+#endif
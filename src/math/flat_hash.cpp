@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/system/math/flat_hash.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/math/siphash.hpp>
+#include <bitcoin/system/utility/pseudo_random.hpp>
+
+namespace libbitcoin {
+namespace system {
+
+salted_hash::salted_hash()
+  : salted_hash(pseudo_random::next())
+{
+}
+
+salted_hash::salted_hash(uint64_t salt)
+  : salt_(salt)
+{
+}
+
+hash_list& distinct_unsorted(hash_list& list)
+{
+    // List entries may be chosen (such as previous output hashes), so all
+    // bytes are hashed with a random key, unlike the digest_hasher prefix.
+    class keyed_hasher
+    {
+    public:
+        keyed_hasher()
+        {
+            half_hash salt;
+            pseudo_random::fill(salt);
+            key_ = to_siphash_key(salt);
+        }
+
+        size_t operator()(const hash_digest& key) const
+        {
+            return static_cast<size_t>(siphash(key_, key));
+        }
+
+    private:
+        siphash_key key_;
+    };
+
+    flat_set<hash_digest, keyed_hasher> set(list.size());
+    const auto duplicate = [&set](const hash_digest& hash)
+    {
+        return !set.insert(hash);
+    };
+
+    list.erase(std::remove_if(list.begin(), list.end(), duplicate),
+        list.end());
+    list.shrink_to_fit();
+    return list;
+}
+
+} // namespace system
+} // namespace libbitcoin
@@ -42,6 +42,31 @@ hash_digest bitcoin_hash(const data_slice& data)
     return sha256_hash(sha256_hash(data));
 }
 
+hash_list bitcoin_hash_batch(const data_slice& blocks)
+{
+    const auto count = blocks.size() / long_hash_size;
+    hash_list hashes(count);
+
+    if (count != 0)
+        SHA256Double64(hashes.front().data(), blocks.data(), count);
+
+    return hashes;
+}
+
+hash_digest double_sha256_64(const long_hash& data)
+{
+    hash_digest hash;
+    SHA256D64(hash.data(), data.data());
+    return hash;
+}
+
+hash_digest double_sha256_80(const byte_array<80>& data)
+{
+    hash_digest hash;
+    SHA256D80(hash.data(), data.data());
+    return hash;
+}
+
 hash_digest scrypt_hash(const data_slice& data)
 {
     return scrypt<hash_size>(data, data, 1024u, 1u, 1u);
@@ -94,6 +119,161 @@ data_chunk sha256_hash_chunk(const data_slice& data)
     return hash;
 }
 
+hash_list sha256_hash_batch(const data_slice& digests)
+{
+    const auto count = digests.size() / hash_size;
+    hash_list hashes(count);
+
+    if (count != 0)
+        SHA256Single32(hashes.front().data(), digests.data(), count);
+
+    return hashes;
+}
+
+sha256_context::sha256_context()
+  : size_(0)
+{
+    SHA256CTX context;
+    SHA256Init(&context);
+    std::copy_n(context.state, SHA256_STATE_LENGTH, state_);
+}
+
+void sha256_context::write(const data_slice& data)
+{
+    write(data.data(), data.size());
+}
+
+void sha256_context::write(const uint8_t* data, size_t size)
+{
+    const auto used = static_cast<size_t>(size_ % SHA256_BLOCK_LENGTH);
+    size_ += size;
+
+    if (used + size < SHA256_BLOCK_LENGTH)
+    {
+        std::copy_n(data, size, buffer_ + used);
+        return;
+    }
+
+    const auto transform = SHA256GetTransform();
+
+    if (used != 0)
+    {
+        const auto fill = SHA256_BLOCK_LENGTH - used;
+        std::copy_n(data, fill, buffer_ + used);
+        transform(state_, buffer_, 1);
+        data += fill;
+        size -= fill;
+    }
+
+    const auto blocks = size / SHA256_BLOCK_LENGTH;
+
+    if (blocks != 0)
+    {
+        transform(state_, data, blocks);
+        data += blocks * SHA256_BLOCK_LENGTH;
+        size -= blocks * SHA256_BLOCK_LENGTH;
+    }
+
+    std::copy_n(data, size, buffer_);
+}
+
+uint64_t sha256_context::size() const
+{
+    return size_;
+}
+
+hash_digest sha256_context::single_hash() const
+{
+    static BC_CONSTEXPR size_t length_offset = SHA256_BLOCK_LENGTH - 8;
+    const auto transform = SHA256GetTransform();
+    const auto used = static_cast<size_t>(size_ % SHA256_BLOCK_LENGTH);
+
+    uint32_t state[SHA256_STATE_LENGTH];
+    uint8_t block[SHA256_BLOCK_LENGTH];
+    std::copy_n(state_, SHA256_STATE_LENGTH, state);
+    std::copy_n(buffer_, used, block);
+    block[used] = 0x80;
+
+    if (used + 1 > length_offset)
+    {
+        std::fill(block + used + 1, block + SHA256_BLOCK_LENGTH, 0x00);
+        transform(state, block, 1);
+        std::fill(block, block + length_offset, 0x00);
+    }
+    else
+    {
+        std::fill(block + used + 1, block + length_offset, 0x00);
+    }
+
+    const auto bits = to_big_endian(size_ * 8u);
+    std::copy(bits.begin(), bits.end(), block + length_offset);
+    transform(state, block, 1);
+
+    hash_digest hash;
+
+    for (size_t word = 0; word < SHA256_STATE_LENGTH; ++word)
+    {
+        const auto bytes = to_big_endian(state[word]);
+        std::copy(bytes.begin(), bytes.end(), hash.begin() + word * 4);
+    }
+
+    return hash;
+}
+
+hash_digest sha256_context::double_hash() const
+{
+    hash_digest hash;
+    const auto first = single_hash();
+    SHA256Single32(hash.data(), first.data(), 1);
+    return hash;
+}
+
+static SHA256Backend to_backend(sha256_backend backend)
+{
+    switch (backend)
+    {
+        case sha256_backend::sse41:
+            return SHA256_SSE41;
+        case sha256_backend::avx2:
+            return SHA256_AVX2;
+        case sha256_backend::avx512:
+            return SHA256_AVX512;
+        case sha256_backend::shani:
+            return SHA256_SHANI;
+        case sha256_backend::scalar:
+        default:
+            return SHA256_SCALAR;
+    }
+}
+
+bool sha256_available(sha256_backend backend)
+{
+    return SHA256Available(to_backend(backend)) != 0;
+}
+
+sha256_backend sha256_selected()
+{
+    switch (SHA256GetBackend())
+    {
+        case SHA256_SSE41:
+            return sha256_backend::sse41;
+        case SHA256_AVX2:
+            return sha256_backend::avx2;
+        case SHA256_AVX512:
+            return sha256_backend::avx512;
+        case SHA256_SHANI:
+            return sha256_backend::shani;
+        case SHA256_SCALAR:
+        default:
+            return sha256_backend::scalar;
+    }
+}
+
+bool sha256_select(sha256_backend backend)
+{
+    return SHA256SetBackend(to_backend(backend)) != 0;
+}
+
 hash_digest sha256_hash(const data_slice& first, const data_slice& second)
 {
     hash_digest hash;
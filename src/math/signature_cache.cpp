@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/system/math/signature_cache.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/utility/data.hpp>
+#include <bitcoin/system/utility/pseudo_random.hpp>
+#include <bitcoin/system/utility/thread.hpp>
+
+namespace libbitcoin {
+namespace system {
+
+// A full block of salt, so that each key hashes from the salted midstate.
+static constexpr size_t salt_size = 64;
+
+signature_cache::signature_cache(size_t capacity)
+  : capacity_(capacity), next_(0), hits_(0), misses_(0)
+{
+    data_chunk salt(salt_size);
+    pseudo_random::fill(salt);
+    salted_.write(salt);
+}
+
+size_t signature_cache::key_hasher::operator()(const hash_digest& key) const
+{
+    size_t value;
+    std::memcpy(&value, key.data(), sizeof(value));
+    return value;
+}
+
+hash_digest signature_cache::to_key(const data_slice& point,
+    const hash_digest& hash, const data_slice& signature) const
+{
+    // The point is variable length, so it follows the fixed length elements.
+    auto context = salted_;
+    context.write(hash);
+    context.write(signature);
+    context.write(point);
+    return context.single_hash();
+}
+
+bool signature_cache::contains(const data_slice& point,
+    const hash_digest& hash, const data_slice& signature) const
+{
+    if (capacity() == 0)
+        return false;
+
+    const auto key = to_key(point, hash, signature);
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+    const auto found = keys_.find(key) != keys_.end();
+    ///////////////////////////////////////////////////////////////////////////
+
+    ++(found ? hits_ : misses_);
+    return found;
+}
+
+void signature_cache::store(const data_slice& point, const hash_digest& hash,
+    const data_slice& signature)
+{
+    if (capacity() == 0)
+        return;
+
+    const auto key = to_key(point, hash, signature);
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+
+    if (capacity_ == 0 || !keys_.insert(key).second)
+        return;
+
+    // Evict the oldest entry once the capacity has been reached.
+    if (order_.size() < capacity_)
+    {
+        order_.push_back(key);
+        return;
+    }
+
+    keys_.erase(order_[next_]);
+    order_[next_] = key;
+    next_ = (next_ + 1) % capacity_;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void signature_cache::set_capacity(size_t capacity)
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+    capacity_ = capacity;
+    next_ = 0;
+    keys_.clear();
+    order_.clear();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void signature_cache::clear()
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+    next_ = 0;
+    keys_.clear();
+    order_.clear();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+size_t signature_cache::size() const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+    return keys_.size();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+size_t signature_cache::capacity() const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+    return capacity_;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+uint64_t signature_cache::hits() const
+{
+    return hits_.load();
+}
+
+uint64_t signature_cache::misses() const
+{
+    return misses_.load();
+}
+
+} // namespace system
+} // namespace libbitcoin
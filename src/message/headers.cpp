@@ -19,10 +19,16 @@
 #include <bitcoin/system/message/headers.hpp>
 
 #include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 #include <istream>
 #include <utility>
+#include <vector>
+#include <bitcoin/system/chain/median_time_window.hpp>
+#include <bitcoin/system/error.hpp>
+#include <bitcoin/system/math/hash.hpp>
 #include <bitcoin/system/math/limits.hpp>
 #include <bitcoin/system/message/inventory.hpp>
 #include <bitcoin/system/message/inventory_vector.hpp>
@@ -32,6 +38,8 @@
 #include <bitcoin/system/utility/container_source.hpp>
 #include <bitcoin/system/utility/istream_reader.hpp>
 #include <bitcoin/system/utility/ostream_writer.hpp>
+#include <bitcoin/system/utility/parallel.hpp>
+#include <bitcoin/system/utility/threadpool.hpp>
 
 namespace libbitcoin {
 namespace system {
@@ -186,6 +194,70 @@ bool headers::is_sequential() const
     return true;
 }
 
+// Headers are checked in batches, each job checking a header and the linkage
+// of its successor to it, so each header is hashed once (by one thread). The
+// order of checks within and across jobs is the order of sequential checks.
+code headers::check(threadpool& pool, uint32_t timestamp_limit_seconds,
+    uint32_t proof_of_work_limit, bool scrypt) const
+{
+    using namespace std::chrono;
+    static BC_CONSTEXPR size_t batch_size = 1024;
+    typedef std::chrono::system_clock wall_clock;
+
+    const auto count = elements_.size();
+    const auto batches = (count + batch_size - 1) / batch_size;
+    const auto future = wall_clock::now() + seconds(timestamp_limit_seconds);
+
+    const auto check = [&](size_t batch)
+    {
+        const auto first = batch * batch_size;
+        const auto last = std::min(first + batch_size, count);
+
+        for (auto index = first; index < last; ++index)
+        {
+            const auto& element = elements_[index];
+            const auto hash = element.hash();
+
+            // Conditionally use scrypt proof of work (e.g. Litecoin).
+            if (scrypt ? !element.is_valid_proof_of_work(proof_of_work_limit,
+                true) : !header::is_valid_proof_of_work(hash, element.bits(),
+                proof_of_work_limit))
+                return code(error::invalid_proof_of_work);
+
+            if (wall_clock::from_time_t(element.timestamp()) > future)
+                return code(error::futuristic_timestamp);
+
+            if (index + 1 < count &&
+                elements_[index + 1].previous_block_hash() != hash)
+                return code(error::invalid_previous_block);
+        }
+
+        return code(error::success);
+    };
+
+    return parallel_first_error(pool, batches, check);
+}
+
+code headers::accept_timestamps(chain::median_time_window window,
+    std::vector<uint32_t>& out) const
+{
+    out.clear();
+    out.reserve(elements_.size());
+
+    for (const auto& element: elements_)
+    {
+        const auto median = window.median();
+
+        if (element.timestamp() <= median)
+            return error::timestamp_too_early;
+
+        out.push_back(median);
+        window.push(element.timestamp());
+    }
+
+    return error::success;
+}
+
 void headers::to_hashes(hash_list& out) const
 {
     out.clear();
@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/system/message/payload_verifier.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/system/math/hash.hpp>
+#include <bitcoin/system/message/heading.hpp>
+#include <bitcoin/system/utility/data.hpp>
+#include <bitcoin/system/utility/endian.hpp>
+
+namespace libbitcoin {
+namespace system {
+namespace message {
+
+payload_verifier::payload_verifier(const heading& head,
+    size_t maximum_payload_size)
+  : checksum_(head.checksum()),
+    payload_size_(head.payload_size()),
+    valid_size_(head.payload_size() <= maximum_payload_size),
+    overrun_(false)
+{
+}
+
+bool payload_verifier::is_valid_size() const
+{
+    return valid_size_;
+}
+
+size_t payload_verifier::remaining() const
+{
+    return payload_size_ - static_cast<size_t>(context_.size());
+}
+
+bool payload_verifier::write(const data_slice& chunk)
+{
+    return write(chunk.data(), chunk.size());
+}
+
+bool payload_verifier::write(const uint8_t* data, size_t size)
+{
+    if (!valid_size_ || overrun_ || size > remaining())
+    {
+        overrun_ = true;
+        return false;
+    }
+
+    context_.write(data, size);
+    return true;
+}
+
+bool payload_verifier::is_valid() const
+{
+    if (!valid_size_ || overrun_ || remaining() != 0)
+        return false;
+
+    const auto hash = context_.double_hash();
+    return from_little_endian_unsafe<uint32_t>(hash.begin()) == checksum_;
+}
+
+} // namespace message
+} // namespace system
+} // namespace libbitcoin
@@ -81,14 +81,8 @@ bool compute_filter(const chain::block& validated_block, data_chunk& out_filter)
 hash_digest compute_filter_header(const hash_digest& previous_block_hash,
     const data_chunk& filter)
 {
-    data_chunk data;
-    data_sink stream(data);
-    ostream_writer sink(stream);
-    sink.write_hash(bitcoin_hash(filter));
-    sink.write_hash(previous_block_hash);
-    stream.flush();
-
-    return bitcoin_hash(data);
+    return double_sha256_64(splice(bitcoin_hash(filter),
+        previous_block_hash));
 }
 
 bool match_filter(const message::compact_filter& filter,
@@ -0,0 +1,128 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/system/utility/parallel.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <bitcoin/system/error.hpp>
+#include <bitcoin/system/utility/threadpool.hpp>
+
+namespace libbitcoin {
+namespace system {
+
+// Shared by reference with each worker, as workers may start late.
+struct parallel_context
+{
+    parallel_context(size_t count, const indexed_job& job)
+      : count(count), job(job), next(0), failure(count),
+        result(error::success), completed(0)
+    {
+    }
+
+    const size_t count;
+    const indexed_job job;
+    std::atomic<size_t> next;
+    std::atomic<size_t> failure;
+
+    // These are protected by mutex.
+    code result;
+    size_t completed;
+    std::mutex mutex;
+    std::condition_variable done;
+};
+
+typedef std::shared_ptr<parallel_context> parallel_context_ptr;
+
+static void parallel_work(parallel_context_ptr context)
+{
+    size_t index;
+    size_t finished = 0;
+
+    // Indexes are claimed in order, so once an index above a failure is
+    // claimed, all lower indexes have been claimed and will be completed.
+    while ((index = context->next++) < context->count)
+    {
+        ++finished;
+
+        if (index > context->failure.load())
+            continue;
+
+        const auto ec = context->job(index);
+
+        if (!ec)
+            continue;
+
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        std::lock_guard<std::mutex> lock(context->mutex);
+
+        if (index < context->failure.load())
+        {
+            context->failure.store(index);
+            context->result = ec;
+        }
+        ///////////////////////////////////////////////////////////////////////
+    }
+
+    if (finished == 0)
+        return;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    std::lock_guard<std::mutex> lock(context->mutex);
+    context->completed += finished;
+
+    if (context->completed == context->count)
+        context->done.notify_one();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+code parallel_first_error(threadpool& pool, size_t count,
+    const indexed_job& job)
+{
+    if (count == 0)
+        return error::success;
+
+    const auto context = std::make_shared<parallel_context>(count, job);
+    const auto helpers = std::min(pool.size(), count - 1u);
+
+    for (size_t helper = 0; helper < helpers; ++helper)
+        pool.service().post(std::bind(parallel_work, context));
+
+    parallel_work(context);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    std::unique_lock<std::mutex> lock(context->mutex);
+    context->done.wait(lock, [&]()
+    {
+        return context->completed == context->count;
+    });
+
+    return context->result;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+} // namespace system
+} // namespace libbitcoin
@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/system/utility/sha256_buffer_writer.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/system/math/hash.hpp>
+
+namespace libbitcoin {
+namespace system {
+
+// Written bytes are hashed once this many are pending (64 byte blocks).
+static constexpr size_t hash_stride_size = 64 * 64;
+
+sha256_buffer_writer::sha256_buffer_writer(uint8_t* buffer, size_t size,
+    sha256_context& context)
+  : sha256_writer(context),
+    begin_(buffer),
+    end_(buffer + size),
+    position_(buffer),
+    hashed_(buffer),
+    valid_(true)
+{
+}
+
+size_t sha256_buffer_writer::size() const
+{
+    return static_cast<size_t>(position_ - begin_);
+}
+
+void sha256_buffer_writer::flush()
+{
+    context_.write(hashed_, static_cast<size_t>(position_ - hashed_));
+    hashed_ = position_;
+}
+
+// private
+void sha256_buffer_writer::hash_stride()
+{
+    if (static_cast<size_t>(position_ - hashed_) >= hash_stride_size)
+        flush();
+}
+
+// Context.
+//-----------------------------------------------------------------------------
+
+sha256_buffer_writer::operator bool() const
+{
+    return valid_;
+}
+
+bool sha256_buffer_writer::operator!() const
+{
+    return !valid_;
+}
+
+// Bytes.
+//-----------------------------------------------------------------------------
+
+void sha256_buffer_writer::write_bytes(const uint8_t* data, size_t size)
+{
+    if (!valid_ || size > static_cast<size_t>(end_ - position_))
+    {
+        valid_ = false;
+        return;
+    }
+
+    position_ = std::copy_n(data, size, position_);
+    hash_stride();
+}
+
+void sha256_buffer_writer::skip(size_t size)
+{
+    if (!valid_ || size > static_cast<size_t>(end_ - position_))
+    {
+        valid_ = false;
+        return;
+    }
+
+    position_ = std::fill_n(position_, size, 0x00);
+    hash_stride();
+}
+
+} // namespace system
+} // namespace libbitcoin
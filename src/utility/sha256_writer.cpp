@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/system/utility/sha256_writer.hpp>
+
+#include <algorithm>
+#include <bitcoin/system/constants.hpp>
+#include <bitcoin/system/math/limits.hpp>
+#include <bitcoin/system/utility/endian.hpp>
+#include <bitcoin/system/utility/reader.hpp>
+
+namespace libbitcoin {
+namespace system {
+
+sha256_writer::sha256_writer(sha256_context& context)
+  : context_(context)
+{
+}
+
+// Context.
+//-----------------------------------------------------------------------------
+
+sha256_writer::operator bool() const
+{
+    return true;
+}
+
+bool sha256_writer::operator!() const
+{
+    return false;
+}
+
+// Hashes.
+//-----------------------------------------------------------------------------
+
+void sha256_writer::write_hash(const hash_digest& value)
+{
+    write_forward<hash_size>(value);
+}
+
+void sha256_writer::write_short_hash(const short_hash& value)
+{
+    write_forward<short_hash_size>(value);
+}
+
+void sha256_writer::write_mini_hash(const mini_hash& value)
+{
+    write_forward<mini_hash_size>(value);
+}
+
+// Big Endian Integers.
+//-----------------------------------------------------------------------------
+
+void sha256_writer::write_2_bytes_big_endian(uint16_t value)
+{
+    write_big_endian<uint16_t>(value);
+}
+
+void sha256_writer::write_4_bytes_big_endian(uint32_t value)
+{
+    write_big_endian<uint32_t>(value);
+}
+
+void sha256_writer::write_8_bytes_big_endian(uint64_t value)
+{
+    write_big_endian<uint64_t>(value);
+}
+
+void sha256_writer::write_variable_big_endian(uint64_t value)
+{
+    if (value < varint_two_bytes)
+    {
+        write_byte(static_cast<uint8_t>(value));
+    }
+    else if (value <= max_uint16)
+    {
+        write_byte(varint_two_bytes);
+        write_2_bytes_big_endian(static_cast<uint16_t>(value));
+    }
+    else if (value <= max_uint32)
+    {
+        write_byte(varint_four_bytes);
+        write_4_bytes_big_endian(static_cast<uint32_t>(value));
+    }
+    else
+    {
+        write_byte(varint_eight_bytes);
+        write_8_bytes_big_endian(value);
+    }
+}
+
+void sha256_writer::write_size_big_endian(size_t value)
+{
+    write_variable_big_endian(value);
+}
+
+// Little Endian Integers.
+//-----------------------------------------------------------------------------
+
+void sha256_writer::write_2_bytes_little_endian(uint16_t value)
+{
+    write_little_endian<uint16_t>(value);
+}
+
+void sha256_writer::write_4_bytes_little_endian(uint32_t value)
+{
+    write_little_endian<uint32_t>(value);
+}
+
+void sha256_writer::write_8_bytes_little_endian(uint64_t value)
+{
+    write_little_endian<uint64_t>(value);
+}
+
+void sha256_writer::write_variable_little_endian(uint64_t value)
+{
+    if (value < varint_two_bytes)
+    {
+        write_byte(static_cast<uint8_t>(value));
+    }
+    else if (value <= max_uint16)
+    {
+        write_byte(varint_two_bytes);
+        write_2_bytes_little_endian(static_cast<uint16_t>(value));
+    }
+    else if (value <= max_uint32)
+    {
+        write_byte(varint_four_bytes);
+        write_4_bytes_little_endian(static_cast<uint32_t>(value));
+    }
+    else
+    {
+        write_byte(varint_eight_bytes);
+        write_8_bytes_little_endian(value);
+    }
+}
+
+void sha256_writer::write_size_little_endian(size_t value)
+{
+    write_variable_little_endian(value);
+}
+
+// Bytes.
+//-----------------------------------------------------------------------------
+
+void sha256_writer::write(reader& in)
+{
+    while (!in.is_exhausted())
+        write_byte(in.read_byte());
+}
+
+void sha256_writer::write_byte(uint8_t value)
+{
+    write_bytes(&value, 1);
+}
+
+void sha256_writer::write_bytes(const data_slice& data)
+{
+    write_bytes(data.data(), data.size());
+}
+
+void sha256_writer::write_bytes(const uint8_t* data, size_t size)
+{
+    context_.write(data, size);
+}
+
+void sha256_writer::write_string(const std::string& value, size_t size)
+{
+    const auto length = std::min(size, value.size());
+    write_bytes(reinterpret_cast<const uint8_t*>(value.data()), length);
+    skip(floor_subtract(size, length));
+}
+
+void sha256_writer::write_string(const std::string& value)
+{
+    write_variable_little_endian(value.size());
+    write_bytes(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+}
+
+void sha256_writer::skip(size_t size)
+{
+    static const uint8_t zeros[64] = { 0 };
+
+    for (; size > sizeof(zeros); size -= sizeof(zeros))
+        context_.write(zeros, sizeof(zeros));
+
+    context_.write(zeros, size);
+}
+
+} // namespace system
+} // namespace libbitcoin
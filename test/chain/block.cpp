@@ -356,6 +356,36 @@ BOOST_AUTO_TEST_CASE(block__factory_3__genesis_mainnet__success)
     BOOST_REQUIRE(genesis.header().merkle_root() == block.generate_merkle_root());
 }
 
+BOOST_AUTO_TEST_CASE(block__from_data__byte_reader__matches_istream_reader)
+{
+    const chain::block genesis = settings(config::settings::mainnet).genesis_block;
+    const auto raw_block = genesis.to_data();
+
+    data_source stream(raw_block);
+    istream_reader reader(stream);
+    chain::block expected;
+    BOOST_REQUIRE(expected.from_data(reader));
+
+    auto source = make_byte_reader(raw_block);
+    chain::block instance;
+    BOOST_REQUIRE(instance.from_data(source));
+    BOOST_REQUIRE(source.is_exhausted());
+    BOOST_REQUIRE(instance == expected);
+    BOOST_REQUIRE(instance.to_data() == raw_block);
+}
+
+BOOST_AUTO_TEST_CASE(block__from_data__byte_reader_insufficient_bytes__failure)
+{
+    const chain::block genesis = settings(config::settings::mainnet).genesis_block;
+    auto raw_block = genesis.to_data();
+    raw_block.pop_back();
+
+    auto source = make_byte_reader(raw_block);
+    chain::block instance;
+    BOOST_REQUIRE(!instance.from_data(source));
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(block_generate_merkle_root_tests)
@@ -787,4 +817,502 @@ BOOST_AUTO_TEST_CASE(block__is_internal_double_spend__nonunique_prevouts__true)
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_SUITE(block_check_internal_spends_tests)
+
+const auto hash_tx1 = hash_literal(HASH_TX1);
+const auto hash_tx2 = hash_literal(HASH_TX2);
+const auto hash_tx3 = hash_literal(HASH_TX3);
+
+static chain::transaction spend(uint32_t version,
+    const chain::output_point::list& prevouts)
+{
+    chain::transaction tx{ version, 0, {}, {} };
+
+    for (const auto& prevout: prevouts)
+        tx.inputs().emplace_back(prevout, chain::script{}, 0);
+
+    return tx;
+}
+
+// The sequential checks replaced by check_internal_spends.
+static code check_sequential(const chain::block& instance)
+{
+    if (instance.is_forward_reference())
+        return error::forward_reference;
+
+    if (instance.is_internal_double_spend())
+        return error::block_internal_double_spend;
+
+    return error::success;
+}
+
+BOOST_AUTO_TEST_CASE(block__check_internal_spends__no_transactions__success)
+{
+    const chain::block instance;
+    BOOST_REQUIRE_EQUAL(instance.check_internal_spends(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(block__check_internal_spends__backward_references__success)
+{
+    const auto coinbase = spend(1, { { null_hash, chain::point::null_index } });
+    const auto first = spend(2, { { hash_tx1, 0 }, { hash_tx1, 1 } });
+    const auto second = spend(3, { { first.hash(), 0 }, { coinbase.hash(), 0 } });
+    chain::block instance;
+    instance.set_transactions({ coinbase, first, second });
+    BOOST_REQUIRE_EQUAL(instance.check_internal_spends(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(block__check_internal_spends__duplicate_transactions__success)
+{
+    chain::block instance;
+    instance.set_transactions({ { 1, 0, {}, {} }, { 1, 0, {}, {} } });
+    BOOST_REQUIRE_EQUAL(instance.check_internal_spends(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(block__check_internal_spends__forward_reference__forward_reference)
+{
+    const auto after = spend(3, { { hash_tx2, 0 } });
+    const auto before = spend(2, { { after.hash(), 0 } });
+    chain::block instance;
+    instance.set_transactions({ spend(1, {}), before, after });
+    BOOST_REQUIRE_EQUAL(instance.check_internal_spends(), error::forward_reference);
+}
+
+BOOST_AUTO_TEST_CASE(block__check_internal_spends__double_spend__block_internal_double_spend)
+{
+    const auto first = spend(2, { { hash_tx1, 42 }, { hash_tx2, 27 } });
+    const auto second = spend(3, { { hash_tx3, 36 }, { hash_tx2, 27 } });
+    chain::block instance;
+    instance.set_transactions({ spend(1, {}), first, second });
+    BOOST_REQUIRE_EQUAL(instance.check_internal_spends(), error::block_internal_double_spend);
+}
+
+BOOST_AUTO_TEST_CASE(block__check_internal_spends__coinbase_double_spend__success)
+{
+    // The coinbase input is excluded from the double spend test.
+    const auto coinbase = spend(1, { { hash_tx1, 42 } });
+    const auto first = spend(2, { { hash_tx1, 42 } });
+    chain::block instance;
+    instance.set_transactions({ coinbase, first });
+    BOOST_REQUIRE_EQUAL(instance.check_internal_spends(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(block__check_internal_spends__double_spend_then_forward_reference__forward_reference)
+{
+    const auto last = spend(4, { { hash_tx3, 0 } });
+    const auto first = spend(2, { { hash_tx1, 42 } });
+    const auto second = spend(3, { { hash_tx1, 42 }, { last.hash(), 0 } });
+    chain::block instance;
+    instance.set_transactions({ spend(1, {}), first, second, last });
+    BOOST_REQUIRE_EQUAL(instance.check_internal_spends(), error::forward_reference);
+}
+
+BOOST_AUTO_TEST_CASE(block__check_internal_spends__shared_prefix_prevouts__expected)
+{
+    // Prevouts differ only in the last bytes of hash, so a hash of the prefix
+    // would place them all in one slot and probe quadratically.
+    chain::output_point::list prevouts;
+    auto hash = hash_tx1;
+
+    for (uint32_t value = 0; value < 10000; ++value)
+    {
+        const auto suffix = to_little_endian(value);
+        std::copy(suffix.begin(), suffix.end(), hash.end() - suffix.size());
+        prevouts.push_back({ hash, 0 });
+    }
+
+    chain::block instance;
+    instance.set_transactions({ spend(1, {}), spend(2, prevouts) });
+    BOOST_REQUIRE_EQUAL(instance.check_internal_spends(), error::success);
+
+    instance.set_transactions({ spend(1, {}), spend(2, prevouts), spend(3, { { hash, 0 } }) });
+    BOOST_REQUIRE_EQUAL(instance.check_internal_spends(), error::block_internal_double_spend);
+}
+
+BOOST_AUTO_TEST_CASE(block__check_internal_spends__shuffled_spends__same_as_sequential)
+{
+    uint32_t seed = 7;
+    const auto next = [&seed](uint32_t limit)
+    {
+        seed = seed * 1103515245u + 12345u;
+        return (seed >> 16) % limit;
+    };
+
+    for (size_t round = 0; round < 200; ++round)
+    {
+        chain::transaction::list txs{ spend(1, {}) };
+
+        // Spend outputs of earlier transactions, some more than once, and
+        // sometimes swap two transactions to create forward references.
+        for (uint32_t tx = 1; tx < 40; ++tx)
+        {
+            chain::output_point::list prevouts;
+
+            for (uint32_t input = 0; input < 3; ++input)
+            {
+                const auto& source = txs[next(static_cast<uint32_t>(txs.size()))];
+                prevouts.push_back({ source.hash(), next(400) });
+            }
+
+            txs.push_back(spend(tx + 1, prevouts));
+        }
+
+        if (next(4) == 0)
+            std::swap(txs[1 + next(39)], txs[1 + next(39)]);
+
+        chain::block instance;
+        instance.set_transactions(txs);
+        BOOST_REQUIRE_EQUAL(instance.check_internal_spends(), check_sequential(instance));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(block_pooled_validation_tests)
+
+static code check_sequential(const chain::block& instance,
+    const settings& settings)
+{
+    return instance.check(settings.max_money(),
+        settings.timestamp_limit_seconds, settings.proof_of_work_limit);
+}
+
+static code check_pooled(const chain::block& instance,
+    const settings& settings, threadpool& pool)
+{
+    return instance.check(settings.max_money(),
+        settings.timestamp_limit_seconds, settings.proof_of_work_limit, pool);
+}
+
+// The state retains a reference to its checkpoints.
+static const config::checkpoint::list no_checkpoints;
+
+// The genesis block state, with all rules enabled.
+static chain::chain_state genesis_state(const settings& settings)
+{
+    const chain::block genesis = settings.genesis_block;
+    const auto& header = genesis.header();
+    chain::chain_state::data data;
+    data.height = 0;
+    data.hash = header.hash();
+    data.bits.self = header.bits();
+    data.version.self = header.version();
+    data.timestamp.self = header.timestamp();
+    data.timestamp.retarget = header.timestamp();
+    return { std::move(data), no_checkpoints, machine::rule_fork::all_rules, 0,
+        settings };
+}
+
+// Inputs spend prevouts of true scripts, except the input at stack_false,
+// which spends a false script, and that at missing, which has no prevout.
+static chain::transaction connecting_tx(uint32_t version, size_t count,
+    size_t stack_false, size_t missing)
+{
+    const chain::script true_script(machine::operation::list{ { machine::opcode::push_positive_1 } });
+    const chain::script false_script(machine::operation::list{ { machine::opcode::push_size_0 } });
+    chain::transaction tx;
+    tx.set_version(version);
+
+    for (uint32_t index = 0; index < count; ++index)
+    {
+        tx.inputs().emplace_back(chain::output_point{ null_hash, index }, chain::script{}, 0);
+
+        if (index != missing)
+            tx.inputs().back().previous_output().metadata.cache = { 0,
+                index == stack_false ? false_script : true_script };
+    }
+
+    tx.outputs().emplace_back(0, chain::script{});
+    return tx;
+}
+
+// A transaction with one input that spends a pay-key-hash prevout, signed.
+static chain::transaction signed_tx()
+{
+    const ec_secret secret = hash_literal("ce8f4b713ffdd2658900845251890f30371856be201cd1f5b3d970f793634333");
+    ec_compressed point;
+    BOOST_REQUIRE(secret_to_public(point, secret));
+    const chain::script prevout_script(chain::script::to_pay_key_hash_pattern(bitcoin_short_hash(point)));
+
+    chain::transaction tx;
+    tx.set_version(1);
+    tx.inputs().emplace_back(chain::output_point{ null_hash, 0 }, chain::script{}, 0);
+    tx.inputs().back().previous_output().metadata.cache = { 0, prevout_script };
+    tx.outputs().emplace_back(0, chain::script{});
+
+    endorsement out;
+    BOOST_REQUIRE(chain::script::create_endorsement(out, secret, prevout_script, tx, 0, machine::sighash_algorithm::all));
+    tx.inputs().back().set_script(chain::script(machine::operation::list{ { out }, { to_chunk(point) } }));
+    return tx;
+}
+
+BOOST_AUTO_TEST_CASE(block__connect_pooled__failing_inputs__lowest_index_same_as_sequential)
+{
+    threadpool pool(4);
+    const settings settings(config::settings::mainnet);
+    const chain::block genesis = settings.genesis_block;
+    const auto& coinbase = genesis.transactions().front();
+    const auto state = genesis_state(settings);
+    const auto connects = connecting_tx(1, 16, max_size_t, max_size_t);
+    const auto stack_false = connecting_tx(2, 16, 7, max_size_t);
+    const auto missing = connecting_tx(3, 16, max_size_t, 0);
+
+    // Inputs are ordered by transaction, so the earlier transaction fails.
+    chain::block instance = genesis;
+    instance.set_transactions({ coinbase, connects, stack_false, missing });
+    BOOST_REQUIRE_EQUAL(instance.connect(state), error::stack_false);
+    BOOST_REQUIRE_EQUAL(instance.connect(state, pool), error::stack_false);
+
+    instance.set_transactions({ coinbase, connects, missing, stack_false });
+    BOOST_REQUIRE_EQUAL(instance.connect(state), error::missing_previous_output);
+    BOOST_REQUIRE_EQUAL(instance.connect(state, pool), error::missing_previous_output);
+
+    instance.set_transactions({ coinbase, connects });
+    BOOST_REQUIRE_EQUAL(instance.connect(state), error::success);
+    BOOST_REQUIRE_EQUAL(instance.connect(state, pool), error::success);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block__connect_pooled__cached_missing_previous_output__missing_previous_output)
+{
+    threadpool pool(4);
+    const settings settings(config::settings::mainnet);
+    const chain::block genesis = settings.genesis_block;
+    const auto& coinbase = genesis.transactions().front();
+    const auto state = genesis_state(settings);
+    auto& cache = chain::script_verification_cache();
+    cache.set_capacity(10);
+
+    chain::block instance = genesis;
+    const auto connects = connecting_tx(1, 16, max_size_t, max_size_t);
+    instance.set_transactions({ coinbase, connects });
+    BOOST_REQUIRE_EQUAL(instance.connect(state, pool), error::success);
+    BOOST_REQUIRE_EQUAL(cache.size(), 1u);
+
+    // The same transaction, without a previous output, is not connected.
+    const auto missing = connecting_tx(1, 16, max_size_t, 3);
+    instance.set_transactions({ coinbase, missing });
+    BOOST_REQUIRE_EQUAL(instance.connect(state), error::missing_previous_output);
+    BOOST_REQUIRE_EQUAL(instance.connect(state, pool), error::missing_previous_output);
+
+    cache.set_capacity(0);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block__connect_pooled__signatures_connected_in_pool__cache_hits)
+{
+    threadpool pool(4);
+    const settings settings(config::settings::mainnet);
+    const chain::block genesis = settings.genesis_block;
+    const auto state = genesis_state(settings);
+    const auto tx = signed_tx();
+    auto& cache = signature_verification_cache();
+    cache.set_capacity(10);
+
+    // Pool acceptance verifies the signature and caches it.
+    BOOST_REQUIRE_EQUAL(tx.connect(state, pool), error::success);
+    BOOST_REQUIRE_EQUAL(cache.size(), 1u);
+
+    // Block connection then finds the signature without verifying it.
+    const auto hits = cache.hits();
+    const auto misses = cache.misses();
+    chain::block instance = genesis;
+    instance.set_transactions({ genesis.transactions().front(), tx });
+    BOOST_REQUIRE_EQUAL(instance.connect(state, pool), error::success);
+    BOOST_REQUIRE_GT(cache.hits(), hits);
+    BOOST_REQUIRE_EQUAL(cache.misses(), misses);
+
+    // Batched block connection also finds it, deferring no check.
+    machine::signature_batch batch;
+    BOOST_REQUIRE_EQUAL(instance.connect(state, pool, batch), error::success);
+    BOOST_REQUIRE_EQUAL(batch.size(), 0u);
+
+    cache.set_capacity(0);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block__connect_batched__rejected_block__signatures_not_cached)
+{
+    threadpool pool(4);
+    const settings settings(config::settings::mainnet);
+    const chain::block genesis = settings.genesis_block;
+    const auto& coinbase = genesis.transactions().front();
+    const auto state = genesis_state(settings);
+    const auto tx = signed_tx();
+    auto& cache = signature_verification_cache();
+    cache.set_capacity(10);
+
+    // The signature is deferred to the batch, but the block is rejected.
+    machine::signature_batch batch;
+    chain::block instance = genesis;
+    const auto stack_false = connecting_tx(2, 16, 7, max_size_t);
+    instance.set_transactions({ coinbase, tx, stack_false });
+    BOOST_REQUIRE_EQUAL(instance.connect(state, pool, batch), error::stack_false);
+    BOOST_REQUIRE_EQUAL(cache.size(), 0u);
+
+    cache.set_capacity(0);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block__connect_batched__accepted_block__signatures_cached)
+{
+    threadpool pool(4);
+    const settings settings(config::settings::mainnet);
+    const chain::block genesis = settings.genesis_block;
+    const auto state = genesis_state(settings);
+    const auto tx = signed_tx();
+    auto& cache = signature_verification_cache();
+    cache.set_capacity(10);
+
+    // Acceptance of the block caches the signature of its batch.
+    machine::signature_batch batch;
+    chain::block instance = genesis;
+    instance.set_transactions({ genesis.transactions().front(), tx });
+    BOOST_REQUIRE_EQUAL(instance.connect(state, pool, batch), error::success);
+    BOOST_REQUIRE_EQUAL(batch.size(), 1u);
+    BOOST_REQUIRE_EQUAL(cache.size(), 1u);
+
+    // Connection of another block finds the signature without verifying it.
+    const auto hits = cache.hits();
+    const auto misses = cache.misses();
+    machine::signature_batch other;
+    BOOST_REQUIRE_EQUAL(instance.connect(state, pool, other), error::success);
+    BOOST_REQUIRE_EQUAL(other.size(), 0u);
+    BOOST_REQUIRE_GT(cache.hits(), hits);
+    BOOST_REQUIRE_EQUAL(cache.misses(), misses);
+
+    cache.set_capacity(0);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block__check_pooled__genesis__success)
+{
+    threadpool pool(2);
+    const settings settings(config::settings::mainnet);
+    const chain::block genesis = settings.genesis_block;
+    BOOST_REQUIRE_EQUAL(check_sequential(genesis, settings), error::success);
+    BOOST_REQUIRE_EQUAL(check_pooled(genesis, settings, pool), error::success);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block__check_pooled__empty_block__empty_block)
+{
+    threadpool pool(2);
+    const settings settings(config::settings::mainnet);
+    chain::block instance = settings.genesis_block;
+    instance.set_transactions({});
+
+    // The merkle root is also invalid, but that is a later stage.
+    BOOST_REQUIRE_EQUAL(check_pooled(instance, settings, pool), error::empty_block);
+    BOOST_REQUIRE_EQUAL(check_sequential(instance, settings), error::empty_block);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block__check_pooled__failing_stages__same_as_sequential)
+{
+    threadpool pool(4);
+    const settings settings(config::settings::mainnet);
+    const chain::block genesis = settings.genesis_block;
+    const auto& coinbase = genesis.transactions().front();
+    const chain::transaction spend{ 1, 0, { { { coinbase.hash(), 0 }, {}, 0 } },
+        coinbase.outputs() };
+
+    const std::vector<chain::transaction::list> cases
+    {
+        // First not coinbase.
+        { spend, coinbase },
+
+        // Extra coinbases.
+        { coinbase, coinbase },
+
+        // Internal double spend.
+        { coinbase, spend, spend },
+
+        // Forward reference.
+        { coinbase, { 2, 0, { { { spend.hash(), 0 }, {}, 0 } }, {} }, spend },
+
+        // Merkle mismatch (the header commits to the genesis coinbase only).
+        { coinbase, spend },
+
+        // Transaction check failure (no outputs).
+        { coinbase, { 1, 0, { { { coinbase.hash(), 0 }, {}, 0 } }, {} } }
+    };
+
+    for (const auto& txs: cases)
+    {
+        chain::block instance = genesis;
+        instance.set_transactions(txs);
+        const auto expected = check_sequential(instance, settings);
+        BOOST_REQUIRE(expected);
+        BOOST_REQUIRE_EQUAL(check_pooled(instance, settings, pool), expected);
+    }
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block__check_pooled__always__sets_check_duration)
+{
+    threadpool pool(2);
+    const settings settings(config::settings::mainnet);
+    const chain::block genesis = settings.genesis_block;
+    genesis.metadata.check = asio::nanoseconds(0);
+    check_pooled(genesis, settings, pool);
+    BOOST_REQUIRE(genesis.metadata.check > asio::nanoseconds(0));
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block__accept_pooled__genesis__same_as_sequential)
+{
+    threadpool pool(2);
+    const settings settings(config::settings::mainnet);
+    const chain::block genesis = settings.genesis_block;
+    const auto state = genesis_state(settings);
+    genesis.metadata.accept = asio::nanoseconds(0);
+    const auto expected = genesis.accept(state, settings);
+    BOOST_REQUIRE_EQUAL(genesis.accept(state, settings, pool), expected);
+    BOOST_REQUIRE(genesis.metadata.accept > asio::nanoseconds(0));
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block__connect_pooled__genesis__sets_connect_duration)
+{
+    threadpool pool(2);
+    const settings settings(config::settings::mainnet);
+    const chain::block genesis = settings.genesis_block;
+    const auto state = genesis_state(settings);
+    genesis.metadata.connect = asio::nanoseconds(0);
+    BOOST_REQUIRE_EQUAL(genesis.connect(state, pool), error::success);
+    BOOST_REQUIRE(genesis.metadata.connect > asio::nanoseconds(0));
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block__accept_pooled__excess_coinbase_claim__coinbase_value_limit)
+{
+    threadpool pool(2);
+    const settings settings(config::settings::mainnet);
+    chain::block instance = settings.genesis_block;
+    auto coinbase = instance.transactions().front();
+    coinbase.outputs().front().set_value(settings.initial_subsidy() + 1u);
+    instance.set_transactions({ coinbase });
+    const auto state = genesis_state(settings);
+    BOOST_REQUIRE_EQUAL(instance.accept(state, settings, true, false), error::coinbase_value_limit);
+    BOOST_REQUIRE_EQUAL(instance.accept(state, settings, pool, true, false), error::coinbase_value_limit);
+    pool.shutdown();
+    pool.join();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
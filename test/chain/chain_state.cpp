@@ -58,4 +58,281 @@ BOOST_AUTO_TEST_CASE(chain_state__work_required_retarget__overflow_patch_enabled
     BOOST_REQUIRE_EQUAL(work, settings.proof_of_work_limit);
 }
 
+// Header versions step through the bip34/66/65 thresholds with some lagging,
+// and bits alternate between late (easy) limit and timely non-limit values.
+chain::header get_header(const hash_digest& previous, size_t height)
+{
+    const auto version = (height % 7u) == 0u ? 1u :
+        static_cast<uint32_t>(std::min(height / 100u + 1u, size_t(4)));
+    const auto easy = (height % 3u) == 0u;
+    const auto bits = easy ? 0x1d00ffffu :
+        0x1c0ffff0u - static_cast<uint32_t>(height % 5u);
+    const auto timestamp = static_cast<uint32_t>(1231006505u + height * 600u +
+        (easy ? 1300u : (height % 11u) * 17u));
+
+    return { version, previous, null_hash, timestamp, bits, 0 };
+}
+
+settings get_settings()
+{
+    settings settings(config::settings::testnet);
+    settings.retargeting_interval_seconds = 20 * settings.block_spacing_seconds;
+    settings.bip34_freeze = bc::max_size_t;
+    settings.bip66_freeze = bc::max_size_t;
+    settings.bip65_freeze = bc::max_size_t;
+    settings.proof_of_work_limit = 0x1d00ffff;
+    return settings;
+}
+
+chain::chain_state::data get_genesis_values(const chain::header& genesis)
+{
+    chain::chain_state::data values;
+    values.height = 0;
+    values.hash = genesis.hash();
+    values.bits.self = genesis.bits();
+    values.version.self = genesis.version();
+    values.timestamp.self = genesis.timestamp();
+    values.timestamp.retarget = genesis.timestamp();
+    return values;
+}
+
+void require_equal(const chain::chain_state& left,
+    const chain::chain_state& right)
+{
+    BOOST_REQUIRE_EQUAL(left.is_valid(), right.is_valid());
+    BOOST_REQUIRE_EQUAL(left.height(), right.height());
+    BOOST_REQUIRE(left.hash() == right.hash());
+    BOOST_REQUIRE_EQUAL(left.enabled_forks(), right.enabled_forks());
+    BOOST_REQUIRE_EQUAL(left.minimum_block_version(),
+        right.minimum_block_version());
+    BOOST_REQUIRE_EQUAL(left.median_time_past(), right.median_time_past());
+    BOOST_REQUIRE_EQUAL(left.work_required(), right.work_required());
+}
+
+// Derive full and incremental states for a chain of count headers.
+void derive_chain(std::vector<chain::chain_state::ptr>& full,
+    std::vector<chain::chain_state::ptr>& incremental, size_t count,
+    uint32_t forks, const settings& settings)
+{
+    static const chain::chain_state::checkpoints checkpoints;
+    const auto genesis = get_header(null_hash, 0);
+
+    full.push_back(std::make_shared<chain::chain_state>(
+        get_genesis_values(genesis), checkpoints, forks, 0, settings));
+    incremental.push_back(std::make_shared<chain::chain_state>(
+        get_genesis_values(genesis), checkpoints, forks, 0, settings, true));
+
+    for (size_t height = 1; height < count; ++height)
+    {
+        const auto header = get_header(full.back()->hash(), height);
+        full.push_back(std::make_shared<chain::chain_state>(*full.back(),
+            header, settings));
+        incremental.push_back(std::make_shared<chain::chain_state>(
+            *incremental.back(), header, settings));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__incremental__default__false)
+{
+    static const chain::chain_state::checkpoints checkpoints;
+    const settings settings(config::settings::mainnet);
+    auto values = get_values(settings.retargeting_interval());
+    const chain::chain_state state(std::move(values), checkpoints,
+        machine::rule_fork::retarget, 0, settings);
+    BOOST_REQUIRE(!state.is_incremental());
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__incremental__from_mapped_values__same_as_full)
+{
+    static const chain::chain_state::checkpoints checkpoints;
+    const auto forks = machine::rule_fork::retarget |
+        machine::rule_fork::bip34_activations;
+    const auto settings = get_settings();
+    std::vector<chain::chain_state::ptr> full;
+    std::vector<chain::chain_state::ptr> unused;
+    derive_chain(full, unused, 250, forks, settings);
+
+    // Populate values for the top state as a store would, by its map.
+    const auto height = full.size() - 1u;
+    const auto map = chain::chain_state::get_map(height, checkpoints, forks,
+        settings.retargeting_interval(), settings.activation_sample,
+        settings.bip9_bit0_active_checkpoint,
+        settings.bip9_bit1_active_checkpoint);
+
+    std::vector<chain::header> headers{ get_header(null_hash, 0) };
+    for (size_t index = 1; index <= height; ++index)
+        headers.push_back(get_header(headers.back().hash(), index));
+
+    chain::chain_state::data values;
+    values.height = height;
+    values.hash = headers[height].hash();
+    values.bits.self = headers[height].bits();
+    values.version.self = headers[height].version();
+    values.timestamp.self = headers[height].timestamp();
+    values.timestamp.retarget = headers[map.timestamp_retarget].timestamp();
+
+    for (auto index = height - map.bits.count; index < height; ++index)
+        values.bits.ordered.push_back(headers[index].bits());
+    for (auto index = height - map.version.count; index < height; ++index)
+        values.version.ordered.push_back(headers[index].version());
+    for (auto index = height - map.timestamp.count; index < height; ++index)
+        values.timestamp.ordered.push_back(headers[index].timestamp());
+
+    auto state = std::make_shared<chain::chain_state>(std::move(values),
+        checkpoints, forks, 0, settings, true);
+    require_equal(*full.back(), *state);
+
+    for (auto index = height + 1u; index < 500u; ++index)
+    {
+        const auto header = get_header(full.back()->hash(), index);
+        full.push_back(std::make_shared<chain::chain_state>(*full.back(),
+            header, settings));
+        state = std::make_shared<chain::chain_state>(*state, header,
+            settings);
+        require_equal(*full.back(), *state);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__incremental__testnet_headers__same_as_full)
+{
+    const auto forks = machine::rule_fork::retarget |
+        machine::rule_fork::bip34_activations;
+    const auto settings = get_settings();
+    std::vector<chain::chain_state::ptr> full;
+    std::vector<chain::chain_state::ptr> incremental;
+    derive_chain(full, incremental, 500, forks, settings);
+
+    for (size_t height = 0; height < full.size(); ++height)
+    {
+        BOOST_REQUIRE(incremental[height]->is_incremental());
+        require_equal(*full[height], *incremental[height]);
+    }
+
+    // Version activations are exercised by the chain.
+    BOOST_REQUIRE_EQUAL(full[100]->minimum_block_version(),
+        settings.first_version);
+    BOOST_REQUIRE_EQUAL(full.back()->minimum_block_version(),
+        settings.bip65_version);
+    BOOST_REQUIRE(!full[100]->is_enabled(machine::rule_fork::bip65_rule));
+    BOOST_REQUIRE(full.back()->is_enabled(machine::rule_fork::bip65_rule));
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__incremental__mainnet_headers__same_as_full)
+{
+    const auto forks = machine::rule_fork::retarget |
+        machine::rule_fork::difficult | machine::rule_fork::bip34_activations |
+        machine::rule_fork::time_warp_patch;
+    const auto settings = get_settings();
+    std::vector<chain::chain_state::ptr> full;
+    std::vector<chain::chain_state::ptr> incremental;
+    derive_chain(full, incremental, 500, forks, settings);
+
+    for (size_t height = 0; height < full.size(); ++height)
+        require_equal(*full[height], *incremental[height]);
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__incremental__pool_and_block__same_as_full)
+{
+    const auto forks = machine::rule_fork::retarget |
+        machine::rule_fork::bip34_activations;
+    const auto settings = get_settings();
+    std::vector<chain::chain_state::ptr> full;
+    std::vector<chain::chain_state::ptr> incremental;
+    derive_chain(full, incremental, 300, forks, settings);
+
+    const chain::chain_state full_pool(*full.back(), settings);
+    const chain::chain_state incremental_pool(*incremental.back(), settings);
+    require_equal(full_pool, incremental_pool);
+
+    chain::block block;
+    block.set_header(get_header(full.back()->hash(), full.size()));
+    const chain::chain_state full_block(full_pool, block, settings);
+    const chain::chain_state incremental_block(incremental_pool, block,
+        settings);
+    require_equal(full_block, incremental_block);
+
+    // The block state extends the branch as its header state would.
+    const auto next = get_header(block.hash(), full.size() + 1u);
+    require_equal(chain::chain_state(full_block, next, settings),
+        chain::chain_state(incremental_block, next, settings));
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__incremental__block_from_pool_after_ring_wrapped__same_as_full)
+{
+    const auto forks = machine::rule_fork::retarget |
+        machine::rule_fork::bip34_activations;
+    const auto settings = get_settings();
+    std::vector<chain::chain_state::ptr> full;
+    std::vector<chain::chain_state::ptr> incremental;
+    derive_chain(full, incremental, 300, forks, settings);
+
+    const chain::chain_state full_pool(*full.back(), settings);
+    const chain::chain_state incremental_pool(*incremental.back(), settings);
+    chain::block block;
+    block.set_header(get_header(full.back()->hash(), full.size()));
+
+    // Extend the branch until the pool's version sample is overwritten.
+    for (size_t height = 300; height < 800; ++height)
+    {
+        const auto header = get_header(incremental.back()->hash(), height);
+        incremental.push_back(std::make_shared<chain::chain_state>(
+            *incremental.back(), header, settings));
+    }
+
+    const chain::chain_state full_block(full_pool, block, settings);
+    const chain::chain_state incremental_block(incremental_pool, block,
+        settings);
+    BOOST_REQUIRE(incremental_block.is_valid());
+    require_equal(full_block, incremental_block);
+    BOOST_REQUIRE(incremental_block.is_enabled(machine::rule_fork::bip66_rule));
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__incremental__fork__same_as_full)
+{
+    const auto forks = machine::rule_fork::retarget |
+        machine::rule_fork::bip34_activations;
+    const auto settings = get_settings();
+    std::vector<chain::chain_state::ptr> full;
+    std::vector<chain::chain_state::ptr> incremental;
+    derive_chain(full, incremental, 400, forks, settings);
+
+    // Branch from below the top and extend both branches.
+    auto full_fork = full[350];
+    auto incremental_fork = incremental[350];
+
+    for (size_t height = 351; height < 450; ++height)
+    {
+        auto header = get_header(full_fork->hash(), height);
+        header.set_nonce(1);
+        full_fork = std::make_shared<chain::chain_state>(*full_fork, header,
+            settings);
+        incremental_fork = std::make_shared<chain::chain_state>(
+            *incremental_fork, header, settings);
+        require_equal(*full_fork, *incremental_fork);
+
+        const auto top = get_header(full.back()->hash(), full.size());
+        full.push_back(std::make_shared<chain::chain_state>(*full.back(),
+            top, settings));
+        incremental.push_back(std::make_shared<chain::chain_state>(
+            *incremental.back(), top, settings));
+        require_equal(*full.back(), *incremental.back());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__incremental__unretained_parent__invalid)
+{
+    const auto forks = machine::rule_fork::retarget |
+        machine::rule_fork::bip34_activations;
+    const auto settings = get_settings();
+    std::vector<chain::chain_state::ptr> full;
+    std::vector<chain::chain_state::ptr> incremental;
+    derive_chain(full, incremental, 600, forks, settings);
+
+    auto header = get_header(full[200]->hash(), 201);
+    header.set_nonce(1);
+    BOOST_REQUIRE(chain::chain_state(*full[200], header, settings).is_valid());
+    BOOST_REQUIRE(!chain::chain_state(*incremental[200], header,
+        settings).is_valid());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -225,4 +225,81 @@ BOOST_AUTO_TEST_CASE(compact__constructor2__hash__round_trips)
     BOOST_REQUIRE(to_uint256(primes) == compact(to_uint256(primes)));
 }
 
+// constructor3/uint256
+
+BOOST_AUTO_TEST_CASE(compact__constructor3__zero__round_trips)
+{
+    BOOST_REQUIRE(uint256(0) == compact(uint256(0)));
+}
+
+BOOST_AUTO_TEST_CASE(compact__constructor3__big_value__round_trips)
+{
+    BOOST_REQUIRE(uint256(42) == compact(uint256(42)));
+}
+
+BOOST_AUTO_TEST_CASE(compact__constructor3__hash__round_trips)
+{
+    BOOST_REQUIRE(uint256(primes) == compact(uint256(primes)));
+}
+
+BOOST_AUTO_TEST_CASE(compact__constructor3__proof_of_work_limit__normalizes_to_bits)
+{
+    BOOST_REQUIRE_EQUAL(compact(uint256(0xffff) << 208).normal(), 0x1d00ffffu);
+}
+
+BOOST_AUTO_TEST_CASE(compact__constructor3__hash__same_as_constructor2)
+{
+    BOOST_REQUIRE(uint256(primes) == compact(to_uint256(primes)));
+    BOOST_REQUIRE_EQUAL(compact(to_uint256(primes)).normal(), compact(uint256(primes)).normal());
+}
+
+// operator uint256
+
+BOOST_AUTO_TEST_CASE(compact__uint256__proof_of_work_limit__expected)
+{
+    const compact instance(0x1d00ffff);
+    const uint256& big = instance;
+    BOOST_REQUIRE(big == uint256(0xffff) << 208);
+}
+
+// operator uint256_t
+
+BOOST_AUTO_TEST_CASE(compact__uint256_t__proof_of_work_limit__expected)
+{
+    const compact instance(0x1d00ffff);
+    const uint256_t big = instance;
+    BOOST_REQUIRE(big == uint256_t(0xffff) << 208);
+}
+
+// to_target
+
+BOOST_AUTO_TEST_CASE(compact__to_target__proof_of_work_limit__expected)
+{
+    hash_digest target;
+    BOOST_REQUIRE(compact::to_target(target, 0x1d00ffff));
+    BOOST_REQUIRE(target == (uint256(0xffff) << 208).to_hash());
+}
+
+BOOST_AUTO_TEST_CASE(compact__to_target__all_exponents__same_as_construction)
+{
+    static const uint32_t mantissas[] { 0, 0x01, 0xff, 0x0100, 0xffff, 0x010000, 0x7fffff };
+
+    for (int32_t exponent = -3; exponent <= 252; ++exponent)
+    {
+        for (const auto mantissa: mantissas)
+        {
+            for (const auto negative: { false, true })
+            {
+                hash_digest target;
+                const auto value = factory(exponent, negative, mantissa);
+                const compact expected(value);
+                BOOST_REQUIRE_EQUAL(compact::to_target(target, value), !expected.is_overflowed());
+
+                if (!expected.is_overflowed())
+                    BOOST_REQUIRE(target == static_cast<const uint256&>(expected).to_hash());
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -451,11 +451,57 @@ BOOST_AUTO_TEST_CASE(header__is_valid_scrypt_proof_of_work__hash_less_than_bits_
     BOOST_REQUIRE(!instance.is_valid_proof_of_work(settings.proof_of_work_limit, false));
 }
 
+BOOST_AUTO_TEST_CASE(header__is_valid_proof_of_work__hash_bits_limit__same_as_compact)
+{
+    static const uint32_t limit = 0x1d00ffff;
+    static const std::vector<uint32_t> bits
+    {
+        0x00000000, 0x01003456, 0x01123456, 0x02008000, 0x03123456,
+        0x04123456, 0x04923456, 0x05009234, 0x1b0404cb, 0x1d00ffff,
+        0x1d010000, 0x1c7fffff, 0x20123456, 0x21000001, 0x22000001,
+        0xff000000, 0xff123456
+    };
+
+    static const std::vector<hash_digest> hashes
+    {
+        null_hash,
+        hash_literal("0000000000000000000000000000000000000000000000000000000000000001"),
+        hash_literal("00000000000404cb000000000000000000000000000000000000000000000000"),
+        hash_literal("00000000000404cb000000000000000000000000000000000000000000000001"),
+        hash_literal("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f"),
+        hash_literal("00000000ffff0000000000000000000000000000000000000000000000000000"),
+        hash_literal("ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff")
+    };
+
+    // The big number implementation.
+    const auto expected = [](const hash_digest& hash, uint32_t bits)
+    {
+        const chain::compact target_bits(bits);
+        const uint256 pow_limit(chain::compact{ limit });
+
+        if (target_bits.is_overflowed())
+            return false;
+
+        const uint256 target(target_bits);
+        return target >= 1 && target <= pow_limit && uint256(hash) <= target;
+    };
+
+    for (const auto value: bits)
+        for (const auto& hash: hashes)
+            BOOST_REQUIRE_EQUAL(chain::header::is_valid_proof_of_work(hash, value, limit), expected(hash, value));
+}
+
 BOOST_AUTO_TEST_CASE(header__proof1__genesis_mainnet__expected)
 {
     BOOST_REQUIRE_EQUAL(chain::header::proof(0x1d00ffff), 0x0000000100010001);
 }
 
+BOOST_AUTO_TEST_CASE(header__proof1__uint256_t__expected)
+{
+    const uint256_t proof = chain::header::proof(0x1d00ffff);
+    BOOST_REQUIRE(proof == 0x0000000100010001);
+}
+
 BOOST_AUTO_TEST_CASE(header__proof2__genesis_mainnet__expected)
 {
     const chain::block block = settings(config::settings::mainnet)
@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <bitcoin/system.hpp>
+
+using namespace bc::system;
+
+BOOST_AUTO_TEST_SUITE(chain_median_time_window_tests)
+
+// The median of the sorted copy, as computed prior to the window.
+static uint32_t sorted_median(std::deque<uint32_t> times)
+{
+    std::sort(times.begin(), times.end());
+    return times.empty() ? 0 : times[times.size() / 2];
+}
+
+BOOST_AUTO_TEST_CASE(median_time_window__construct__default__empty)
+{
+    const chain::median_time_window instance;
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.median(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(median_time_window__push__even_count__upper_middle)
+{
+    chain::median_time_window instance;
+    instance.push(40);
+    instance.push(10);
+    instance.push(30);
+    instance.push(20);
+    BOOST_REQUIRE_EQUAL(instance.size(), 4u);
+    BOOST_REQUIRE_EQUAL(instance.median(), 30u);
+}
+
+BOOST_AUTO_TEST_CASE(median_time_window__push__full__removes_oldest)
+{
+    chain::median_time_window instance;
+
+    for (uint32_t value = 0; value < bc::median_time_past_interval; ++value)
+        instance.push(100 + value);
+
+    BOOST_REQUIRE_EQUAL(instance.size(), bc::median_time_past_interval);
+    BOOST_REQUIRE_EQUAL(instance.median(), 105u);
+
+    // Replaces 100 and 101 with high values, so the median moves up two.
+    instance.push(200);
+    instance.push(201);
+    BOOST_REQUIRE_EQUAL(instance.size(), bc::median_time_past_interval);
+    BOOST_REQUIRE_EQUAL(instance.median(), 107u);
+}
+
+BOOST_AUTO_TEST_CASE(median_time_window__push__sliding_duplicates__same_as_sorted)
+{
+    chain::median_time_window instance;
+    std::deque<uint32_t> times;
+    uint32_t seed = 42;
+
+    for (size_t index = 0; index < 1000; ++index)
+    {
+        // Small range of values ensures duplicates.
+        seed = seed * 1103515245u + 12345u;
+        const auto timestamp = (seed >> 16) % 16u;
+
+        instance.push(timestamp);
+        times.push_back(timestamp);
+
+        if (times.size() > bc::median_time_past_interval)
+            times.pop_front();
+
+        BOOST_REQUIRE_EQUAL(instance.size(), times.size());
+        BOOST_REQUIRE_EQUAL(instance.median(), sorted_median(times));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
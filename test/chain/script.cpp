@@ -668,6 +668,88 @@ BOOST_AUTO_TEST_CASE(script__generate_signature_hash__all__expected)
     BOOST_REQUIRE_EQUAL(result, expected);
 }
 
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__unversioned_code_separator__expected)
+{
+    data_chunk tx_data;
+    decode_base16(tx_data, "0100000002fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f0000000000eeffffffef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a0100000000ffffffff02202cb206000000001976a9148280b37df378db99f66f85c95a783a76ac7a6d5988ac9093510d000000001976a9143bde42dbee7e4dbe6a21b2d50ce2f0167faa815988ac11000000");
+    transaction tx;
+    BOOST_REQUIRE(tx.from_data(tx_data));
+
+    // The code separator is stripped from the signed script code.
+    script script_code;
+    BOOST_REQUIRE(script_code.from_string("dup hash160 [1d0f172a0ecb48aee1be1f2687d2963ae33f1a13] equalverify codeseparator checksig"));
+
+    const auto any = sighash_algorithm::anyone_can_pay;
+    const std::vector<std::tuple<uint32_t, uint8_t, std::string>> expectations
+    {
+        std::make_tuple(0u, sighash_algorithm::all, "2d1cd59882ef279243b14ef5d17c5feef08b6fd5418d89c8a94e892a3ae87908"),
+        std::make_tuple(0u, sighash_algorithm::none, "2cb5b13ccf00775217502f0c02f32d3f3d8f74ae359f9ae10f73bdd470928a89"),
+        std::make_tuple(0u, sighash_algorithm::single, "6520dd87647c74d8ac3ea56f6fe4547e9e12fa0f4bcddb4257935c462830122a"),
+        std::make_tuple(0u, sighash_algorithm::all | any, "fac687ccb61b24748b86250ec0c441ad860196148160c3a1426034ec4d522cfe"),
+        std::make_tuple(0u, sighash_algorithm::none | any, "e3b73f5573d2a8d62729e090c9c768f458ea44ae9db2464915f4de0426e562c4"),
+        std::make_tuple(0u, sighash_algorithm::single | any, "6b2696db3b328d09dffde1e982182f440acedc0d1fe8fe362802c118dffbb9a8"),
+        std::make_tuple(1u, sighash_algorithm::all, "c5e0d80eb9f183403f2e4d65f8128ac89895ce5626ad27a9b1d75b64e52493e9"),
+        std::make_tuple(1u, sighash_algorithm::none, "2a94ab8e321a213ba5eb32b1acd8550b38881d3858cbc67a1c9e385010bcdffc"),
+        std::make_tuple(1u, sighash_algorithm::single, "b2db78fe7596436f72ee12c619d3c475cbda999397efdce48284018d98ef7167"),
+        std::make_tuple(1u, sighash_algorithm::all | any, "d777f3cd1ee9a54fcef9436b5189ce4794986cfe13e8270dd7531ca9f3a0ea5d"),
+        std::make_tuple(1u, sighash_algorithm::none | any, "86b348b0eda3831d784d61a0f75bd5a5b2bcba2dbac211741b7c94ff0d9d56ef"),
+        std::make_tuple(1u, sighash_algorithm::single | any, "c808bb2462487bb35fc89dd9b3a12ee5672c45e58fd5c6a1fe630c3c0f34f5bc")
+    };
+
+    for (const auto& expectation: expectations)
+    {
+        const auto sighash = script::generate_signature_hash(tx, std::get<0>(expectation), script_code, std::get<1>(expectation));
+        BOOST_REQUIRE_EQUAL(encode_base16(sighash), std::get<2>(expectation));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__single_index_overflow__one_hash)
+{
+    data_chunk tx_data;
+    decode_base16(tx_data, "0100000002fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f0000000000eeffffffef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a0100000000ffffffff0000000000");
+    transaction tx;
+    BOOST_REQUIRE(tx.from_data(tx_data));
+    static const auto hash_one = hash_literal("0000000000000000000000000000000000000000000000000000000000000001");
+    const auto sighash = script::generate_signature_hash(tx, 1, script{}, sighash_algorithm::single);
+    BOOST_REQUIRE(sighash == hash_one);
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__version_0_cached_prefix__expected)
+{
+    data_chunk tx_data;
+    decode_base16(tx_data, "0100000002fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f0000000000eeffffffef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a0100000000ffffffff02202cb206000000001976a9148280b37df378db99f66f85c95a783a76ac7a6d5988ac9093510d000000001976a9143bde42dbee7e4dbe6a21b2d50ce2f0167faa815988ac11000000");
+    transaction tx;
+    BOOST_REQUIRE(tx.from_data(tx_data));
+
+    script script_code;
+    BOOST_REQUIRE(script_code.from_string("dup hash160 [1d0f172a0ecb48aee1be1f2687d2963ae33f1a13] equalverify checksig"));
+
+    const auto index = 1u;
+    const uint64_t value = 600000000;
+    const auto version = script_version::zero;
+    const auto any = sighash_algorithm::anyone_can_pay;
+
+    const std::vector<std::pair<uint8_t, std::string>> expectations
+    {
+        { sighash_algorithm::all, "da72511e8056af650e453b2113c4cfb811e2415b3e234706da8d693e01a4f15b" },
+        { sighash_algorithm::none, "574d86f1747d160de501cae25a1e5e4918eb8e718254c953fa5f23fb197ee394" },
+        { sighash_algorithm::single, "0079dd1358f80f729b4b69eb4103115883e10fbeaf1cb254e22be2860aa8ce2d" },
+        { sighash_algorithm::all | any, "64a34f05f1cdba0d74ec00ca4bb29cc728307e8accbf8bbb32081af034146b9c" },
+        { sighash_algorithm::none | any, "2a8feba92b7b5b2c32e64da26fd8806e3bdda37284a074978c5ec8c3029d4b41" },
+        { sighash_algorithm::single | any, "2892375d8fcab361316c8e402daf8d8256a946f6151e2306dd6ab6290a049ac8" }
+    };
+
+    // The second pass is computed from the cached prefix midstates.
+    for (size_t pass = 0; pass < 2; ++pass)
+    {
+        for (const auto& expectation: expectations)
+        {
+            const auto sighash = script::generate_signature_hash(tx, index, script_code, expectation.first, version, value);
+            BOOST_REQUIRE_EQUAL(encode_base16(sighash), expectation.second);
+        }
+    }
+}
+
 // Ad-hoc test cases.
 //-----------------------------------------------------------------------------
 
@@ -711,6 +793,34 @@ BOOST_AUTO_TEST_CASE(script__verify__testnet_block_23428_multisig_tx__valid)
     BOOST_REQUIRE_EQUAL(result.value(), error::success);
 }
 
+BOOST_AUTO_TEST_CASE(script__verify__testnet_block_23428_multisig_tx_deferred__not_deferred)
+{
+    static const auto index = 1u;
+    static const auto forks = static_cast<rule_fork>(1073742031);
+    static const auto encoded_script = "a9144aba54e2541475f91659ccdbb13ce0b490778c7f87";
+    static const auto encoded_tx = "0100000002c0cd5346700d18a937575424eb84888bdc277bdbfade39b3bb9a4ce31fd4455101000000fdf60100483045022100f681bb660ef85bb191e337450f2ba3493c37b90a8622864d932cec5b40a74428022007cab269d846b7e63899b8e7082bdea94375d4b1c197b7c50365823c9ffd935e01483045022100b4d3be95b088c8ef176b25c9cee0b16ac7f91c10ccf645ab7421ad3de1d8aba802205c6b3bd9df0b19271abefc47997ce7bd113a6f069674003c821c01440d49a48b0148304502207fad219634211fb614cef1654bdb956a9ed751a352e47c2b64d4ac8459e05ec2022100bd4ae53e76f266938f2ec09d1b2d515eaf5e21b990e5c7df0779ca61f24a10de014830450221009f2dd7fa5eafdf9f660e764750aabffd86628bb19501d49007551151f6409266022019fad776d46c6896a849bf7fcacefa73da6d5db22680c7bacdd055d8d8547858014ccf542102d7dafdc7f5d63bc1e5210a93a93c57e96acfb123df06ca02318be689791fa634210204affb8e9fd6228d370aed6b8fff2fc33bbe9603e2933ae3b92b11a67d7e7d3d210269fa9a07b38c01440ecabc74481fdd2ede1591e293a1108ba1ac511d85e40ca62102f24bda0faab218a98c5975cb7eb035b37020ec3758e454d95f382e1f274da2112102795716e51a5539961872b559f2e938a29862565c1d0c70ed6a748adb8541c82b2103828209539e87cc72694e0d397a00ae1c1b3aa3aa7931df3bb72c71172758ed7756aeffffffffca1ea035fedd045da687f8219f6d76982b47fd3edab01212d3def0dc917d321801000000fdf40100473044022050cf9d0bf024af1780af7ce91a8cac62fd54a3df96cc1eb27889a58aaf82f09e02205f85c010faa5978963f569cfa6bd7202363841ad82bab0a6044c1092140ba49001483045022100f3f5076e1f233acf3fd2bb1188da82f3259224ee29a50af287b707c71503543f02202e82db849e59f8eb836ec6c55dab6a3d61b6511e9d25e550901d5534276432320148304502210094ff0cd6c74dd756a07334c2b76373dd4fb8f5ef7c1da7e09a168d54cf79a7770220114337de0ac0edd7871c079b796ad422d2d5e50d350d3b9f7371b0f1bd66fe7a01473044022022bc92872b6c680da40aa6388e28ef396c7ffa410317ae574c1f31836c85b28602203b43a7d2cdcc2ba1afaf53c1a0c0b474933581b0e359aed788ad7ad819260dfb014ccf542102d7dafdc7f5d63bc1e5210a93a93c57e96acfb123df06ca02318be689791fa634210204affb8e9fd6228d370aed6b8fff2fc33bbe9603e2933ae3b92b11a67d7e7d3d210269fa9a07b38c01440ecabc74481fdd2ede1591e293a1108ba1ac511d85e40ca62102f24bda0faab218a98c5975cb7eb035b37020ec3758e454d95f382e1f274da2112102795716e51a5539961872b559f2e938a29862565c1d0c70ed6a748adb8541c82b2103828209539e87cc72694e0d397a00ae1c1b3aa3aa7931df3bb72c71172758ed7756aeffffffff02605af405000000001976a914bb6754a948265de730c60fbd745aeb5868ea921e88ac00e1f5050000000017a9144aba54e2541475f91659ccdbb13ce0b490778c7f8700000000";
+
+    data_chunk decoded_tx;
+    BOOST_REQUIRE(decode_base16(decoded_tx, encoded_tx));
+
+    data_chunk decoded_script;
+    BOOST_REQUIRE(decode_base16(decoded_script, encoded_script));
+
+    transaction tx;
+    BOOST_REQUIRE(tx.from_data(decoded_tx));
+    BOOST_REQUIRE_GT(tx.inputs().size(), index);
+
+    const auto& input = tx.inputs()[index];
+    auto& prevout = input.previous_output().metadata.cache;
+    prevout.set_script(script::factory(decoded_script, false));
+
+    // A 4 of 6 multisig depends upon failed checks, so is checked inline.
+    signature_batch batch;
+    const auto result = script::verify(tx, index, forks, &batch);
+    BOOST_REQUIRE_EQUAL(result.value(), error::success);
+    BOOST_REQUIRE_EQUAL(batch.size(), 0u);
+}
+
 BOOST_AUTO_TEST_CASE(script__verify__block_290329_tx__valid)
 {
     //// DEBUG [blockchain] Verify failed [290329] : stack false (find and delete).
@@ -909,6 +1019,41 @@ BOOST_AUTO_TEST_CASE(script__verify__bip143_native_p2wpkh_tx__valid)
     BOOST_REQUIRE_EQUAL(result1.value(), error::unexpected_witness);
 }
 
+BOOST_AUTO_TEST_CASE(script__verify__bip143_native_p2wpkh_tx_deferred__batch_verifies)
+{
+    transaction tx;
+    data_chunk decoded_tx;
+    data_chunk decoded_script;
+    BOOST_REQUIRE(decode_base16(decoded_tx, "01000000000102fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f00000000494830450221008b9d1dc26ba6a9cb62127b02742fa9d754cd3bebf337f7a55d114c8e5cdd30be022040529b194ba3f9281a99f2b1c0a19c0489bc22ede944ccf4ecbab4cc618ef3ed01eeffffffef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a0100000000ffffffff02202cb206000000001976a9148280b37df378db99f66f85c95a783a76ac7a6d5988ac9093510d000000001976a9143bde42dbee7e4dbe6a21b2d50ce2f0167faa815988ac000247304402203609e17b84f6a7d30c80bfa610b5b4542f32a8a0d5447a12fb1366d7f01cc44a0220573a954c4518331561406f90300e8f3358f51928d43c212a8caed02de67eebee0121025476c2e83188368da1ff3e292e7acafcdb3566bb0ad253f62fc70f07aeee635711000000"));
+    BOOST_REQUIRE(tx.from_data(decoded_tx, true, true));
+    BOOST_REQUIRE_EQUAL(tx.inputs().size(), 2u);
+
+    auto& prevout0 = tx.inputs()[0].previous_output().metadata.cache;
+    BOOST_REQUIRE(decode_base16(decoded_script, "2103c9f4836b9a4f77fc0d81f7bcb01b7f1b35916864b9476c241ce9fc198bd25432ac"));
+    prevout0.set_script(script::factory(decoded_script, false));
+    prevout0.set_value(625000000);
+
+    auto& prevout1 = tx.inputs()[1].previous_output().metadata.cache;
+    BOOST_REQUIRE(decode_base16(decoded_script, "00141d0f172a0ecb48aee1be1f2687d2963ae33f71a1"));
+    prevout1.set_script(script::factory(decoded_script, false));
+    prevout1.set_value(600000000);
+
+    const auto forks = rule_fork::bip141_rule | rule_fork::bip143_rule;
+
+    // The final checksig of P2PK and of the P2WPKH witness are deferred.
+    signature_batch batch;
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 0, forks, &batch).value(), error::success);
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 1, forks, &batch).value(), error::success);
+    BOOST_REQUIRE_EQUAL(batch.size(), 2u);
+    BOOST_REQUIRE_EQUAL(batch.verify().value(), error::success);
+
+    // missing bip143 (invalid sighash), inline stack false, deferred failure.
+    signature_batch invalid;
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 1, rule_fork::bip141_rule, &invalid).value(), error::success);
+    BOOST_REQUIRE_EQUAL(invalid.size(), 1u);
+    BOOST_REQUIRE_EQUAL(invalid.verify().value(), error::incorrect_signature);
+}
+
 BOOST_AUTO_TEST_CASE(script__verify__bip143_p2sh_p2wpkh_tx__valid)
 {
     transaction tx;
@@ -1093,6 +1238,21 @@ BOOST_AUTO_TEST_CASE(script__verify__bip143_p2sh_p2wsh_tx__valid)
     BOOST_REQUIRE_EQUAL(result0.value(), error::stack_false);
 }
 
+BOOST_AUTO_TEST_CASE(script__is_found__pushed_endorsement__true)
+{
+    const data_chunk endorsement(72, 0x42);
+    const script instance(operation::list{ { endorsement }, { opcode::checksig } });
+    BOOST_REQUIRE(instance.is_found(endorsement));
+}
+
+BOOST_AUTO_TEST_CASE(script__is_found__other_endorsement__false)
+{
+    const data_chunk endorsement(72, 0x42);
+    const data_chunk other(72, 0x24);
+    const script instance(operation::list{ { endorsement }, { opcode::checksig } });
+    BOOST_REQUIRE(!instance.is_found(other));
+}
+
 BOOST_AUTO_TEST_CASE(script__verify__bip143_no_find_and_delete_tx__valid)
 {
     transaction tx;
@@ -1121,4 +1281,336 @@ BOOST_AUTO_TEST_CASE(script__verify__bip143_no_find_and_delete_tx__valid)
     BOOST_REQUIRE_EQUAL(result0.value(), error::incorrect_signature);
 }
 
+// Engine differential tests.
+//------------------------------------------------------------------------------
+
+static const uint32_t differential_forks[]
+{
+    rule_fork::no_rules,
+    rule_fork::bip16_rule,
+    rule_fork::bip16_rule | rule_fork::bip65_rule | rule_fork::bip66_rule,
+    rule_fork::bip16_rule | rule_fork::bip112_rule,
+    rule_fork::bip16_rule | rule_fork::bip141_rule,
+    rule_fork::bip141_rule | rule_fork::bip143_rule,
+    rule_fork::all_rules
+};
+
+// The view engine must return the code of interpreter::run for each input.
+static void require_views_equivalence(const transaction& tx,
+    const std::string& name)
+{
+    const auto inputs = static_cast<uint32_t>(tx.inputs().size());
+
+    for (uint32_t index = 0; index < inputs; ++index)
+    {
+        for (const auto forks: differential_forks)
+        {
+            const auto expected = script::verify(tx, index, forks);
+            const auto result = script::verify(tx, index, forks, nullptr, true);
+            BOOST_CHECK_MESSAGE(result == expected, name << " [" << index
+                << ", " << forks << "] " << result.message() << " != "
+                << expected.message());
+        }
+    }
+}
+
+static void require_views_equivalence(const script_test_list& tests)
+{
+    for (const auto& test: tests)
+    {
+        const auto tx = new_tx(test);
+        const auto name = test_name(test);
+        BOOST_REQUIRE_MESSAGE(tx.is_valid(), name);
+        require_views_equivalence(tx, name);
+    }
+}
+
+static transaction new_spend(const script& prevout_script, uint64_t value,
+    const script& input_script, const witness& witness)
+{
+    output_point outpoint{ null_hash, 0 };
+    outpoint.metadata.cache.set_script(script(prevout_script));
+    outpoint.metadata.cache.set_value(value);
+
+    return transaction
+    {
+        1,
+        0,
+        input::list
+        {
+            input{ outpoint, input_script, witness, bc::max_input_sequence }
+        },
+        output::list
+        {
+            output{ value / 2, script{} }
+        }
+    };
+}
+
+static const ec_secret differential_secret = hash_literal("ce8f4b713ffdd2658900845251890f30371856be201cd1f5b3d970f793634333");
+static const ec_secret differential_other = hash_literal("0000000000000000000000000000000000000000000000000000000000000001");
+static const uint64_t differential_value = 600000000;
+
+static data_chunk differential_point(const ec_secret& secret)
+{
+    ec_compressed point;
+    BOOST_REQUIRE(secret_to_public(point, secret));
+    return to_chunk(point);
+}
+
+// Sign the prevout of a one input spend, which is independent of the spend.
+static endorsement differential_sign(const ec_secret& secret,
+    const script& prevout_script, const script& script_code,
+    script_version version, uint64_t value)
+{
+    endorsement out;
+    const auto tx = new_spend(prevout_script, differential_value, {}, {});
+    BOOST_REQUIRE(script::create_endorsement(out, secret, script_code, tx, 0,
+        sighash_algorithm::all, version, value));
+    return out;
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__views_corpus__same_as_interpreter)
+{
+    require_views_equivalence(valid_bip16_scripts);
+    require_views_equivalence(invalidated_bip16_scripts);
+    require_views_equivalence(valid_bip65_scripts);
+    require_views_equivalence(invalid_bip65_scripts);
+    require_views_equivalence(invalidated_bip65_scripts);
+    require_views_equivalence(valid_multisig_scripts);
+    require_views_equivalence(invalid_multisig_scripts);
+    require_views_equivalence(valid_context_free_scripts);
+    require_views_equivalence(invalid_context_free_scripts);
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__views_signed_p2pkh__same_as_interpreter)
+{
+    const auto point = differential_point(differential_secret);
+    const script prevout_script(script::to_pay_key_hash_pattern(bitcoin_short_hash(point)));
+
+    const auto spend = [&](const ec_secret& secret)
+    {
+        const auto signature = differential_sign(secret, prevout_script, prevout_script, script_version::unversioned, bc::max_uint64);
+        const script input_script(operation::list{ { signature }, { point } });
+        return new_spend(prevout_script, differential_value, input_script, {});
+    };
+
+    const auto valid = spend(differential_secret);
+    BOOST_REQUIRE_EQUAL(script::verify(valid, 0, rule_fork::all_rules, nullptr, true).value(), error::success);
+    require_views_equivalence(valid, "p2pkh");
+
+    const auto invalid = spend(differential_other);
+    BOOST_REQUIRE_EQUAL(script::verify(invalid, 0, rule_fork::all_rules, nullptr, true).value(), error::stack_false);
+    require_views_equivalence(invalid, "p2pkh other key");
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__views_signed_find_and_delete__same_as_interpreter)
+{
+    const auto point = differential_point(differential_secret);
+
+    // The endorsement is removed from the unversioned script code.
+    const script script_code(operation::list{ { opcode::drop }, { point }, { opcode::checksig } });
+    const auto signature = differential_sign(differential_secret, script_code, script_code, script_version::unversioned, bc::max_uint64);
+    const script prevout_script(operation::list{ { signature }, { opcode::drop }, { point }, { opcode::checksig } });
+    const script input_script(operation::list{ { signature } });
+
+    const auto tx = new_spend(prevout_script, differential_value, input_script, {});
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 0, rule_fork::all_rules, nullptr, true).value(), error::success);
+    require_views_equivalence(tx, "find and delete");
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__views_signed_p2wpkh__same_as_interpreter)
+{
+    const auto point = differential_point(differential_secret);
+    const auto hash = bitcoin_short_hash(point);
+    const script prevout_script(script::to_pay_witness_key_hash_pattern(hash));
+    const script script_code(script::to_pay_key_hash_pattern(hash));
+
+    const auto spend = [&](uint64_t value)
+    {
+        const auto signature = differential_sign(differential_secret, prevout_script, script_code, script_version::zero, value);
+        return new_spend(prevout_script, differential_value, {}, witness{ data_stack{ signature, point } });
+    };
+
+    const auto valid = spend(differential_value);
+    BOOST_REQUIRE_EQUAL(script::verify(valid, 0, rule_fork::all_rules, nullptr, true).value(), error::success);
+    require_views_equivalence(valid, "p2wpkh");
+
+    const auto invalid = spend(differential_value + 1);
+    BOOST_REQUIRE_EQUAL(script::verify(invalid, 0, rule_fork::all_rules, nullptr, true).value(), error::stack_false);
+    require_views_equivalence(invalid, "p2wpkh other value");
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__views_signed_p2wsh__same_as_interpreter)
+{
+    const auto point = differential_point(differential_secret);
+    const script witness_script(script::to_pay_public_key_pattern(point));
+    const auto program = witness_script.to_data(false);
+    const script prevout_script(script::to_pay_witness_script_hash_pattern(sha256_hash(program)));
+
+    const auto spend = [&](const ec_secret& secret)
+    {
+        const auto signature = differential_sign(secret, prevout_script, witness_script, script_version::zero, differential_value);
+        return new_spend(prevout_script, differential_value, {}, witness{ data_stack{ signature, program } });
+    };
+
+    const auto valid = spend(differential_secret);
+    BOOST_REQUIRE_EQUAL(script::verify(valid, 0, rule_fork::all_rules, nullptr, true).value(), error::success);
+    require_views_equivalence(valid, "p2wsh");
+
+    const auto invalid = spend(differential_other);
+    BOOST_REQUIRE_EQUAL(script::verify(invalid, 0, rule_fork::all_rules, nullptr, true).value(), error::stack_false);
+    require_views_equivalence(invalid, "p2wsh other key");
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__views_bip143_vectors__same_as_interpreter)
+{
+    transaction tx;
+    data_chunk decoded_tx;
+    data_chunk decoded_script;
+
+    // bip143 native p2wpkh, spending p2pk and p2wpkh.
+    BOOST_REQUIRE(decode_base16(decoded_tx, "01000000000102fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f00000000494830450221008b9d1dc26ba6a9cb62127b02742fa9d754cd3bebf337f7a55d114c8e5cdd30be022040529b194ba3f9281a99f2b1c0a19c0489bc22ede944ccf4ecbab4cc618ef3ed01eeffffffef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a0100000000ffffffff02202cb206000000001976a9148280b37df378db99f66f85c95a783a76ac7a6d5988ac9093510d000000001976a9143bde42dbee7e4dbe6a21b2d50ce2f0167faa815988ac000247304402203609e17b84f6a7d30c80bfa610b5b4542f32a8a0d5447a12fb1366d7f01cc44a0220573a954c4518331561406f90300e8f3358f51928d43c212a8caed02de67eebee0121025476c2e83188368da1ff3e292e7acafcdb3566bb0ad253f62fc70f07aeee635711000000"));
+    BOOST_REQUIRE(tx.from_data(decoded_tx, true, true));
+    BOOST_REQUIRE_EQUAL(tx.inputs().size(), 2u);
+
+    auto& prevout0 = tx.inputs()[0].previous_output().metadata.cache;
+    BOOST_REQUIRE(decode_base16(decoded_script, "2103c9f4836b9a4f77fc0d81f7bcb01b7f1b35916864b9476c241ce9fc198bd25432ac"));
+    prevout0.set_script(script::factory(decoded_script, false));
+    prevout0.set_value(625000000);
+
+    auto& prevout1 = tx.inputs()[1].previous_output().metadata.cache;
+    BOOST_REQUIRE(decode_base16(decoded_script, "00141d0f172a0ecb48aee1be1f2687d2963ae33f71a1"));
+    prevout1.set_script(script::factory(decoded_script, false));
+    prevout1.set_value(600000000);
+
+    require_views_equivalence(tx, "bip143 native p2wpkh");
+
+    // bip143 no find and delete (p2wsh).
+    BOOST_REQUIRE(decode_base16(decoded_tx, "0100000000010169c12106097dc2e0526493ef67f21269fe888ef05c7a3a5dacab38e1ac8387f14c1d000000ffffffff01010000000000000000034830450220487fb382c4974de3f7d834c1b617fe15860828c7f96454490edd6d891556dcc9022100baf95feb48f845d5bfc9882eb6aeefa1bc3790e39f59eaa46ff7f15ae626c53e012102a9781d66b61fb5a7ef00ac5ad5bc6ffc78be7b44a566e3c87870e1079368df4c4aad4830450220487fb382c4974de3f7d834c1b617fe15860828c7f96454490edd6d891556dcc9022100baf95feb48f845d5bfc9882eb6aeefa1bc3790e39f59eaa46ff7f15ae626c53e0100000000"));
+    BOOST_REQUIRE(tx.from_data(decoded_tx, true, true));
+    BOOST_REQUIRE_EQUAL(tx.inputs().size(), 1u);
+
+    auto& prevout = tx.inputs()[0].previous_output().metadata.cache;
+    BOOST_REQUIRE(decode_base16(decoded_script, "00209e1be07558ea5cc8e02ed1d80c0911048afad949affa36d5c3951e3159dbea19"));
+    prevout.set_script(script::factory(decoded_script, false));
+    prevout.set_value(200000);
+
+    require_views_equivalence(tx, "bip143 no find and delete");
+}
+
+// Undecoded pattern matching tests.
+//------------------------------------------------------------------------------
+
+static script undecoded(const std::string& mnemonic)
+{
+    script decoded;
+    BOOST_REQUIRE(decoded.from_string(mnemonic));
+    return script::factory(decoded.to_data(false), false);
+}
+
+static void require_undecoded_equivalence(const script& decoded)
+{
+    const auto instance = script::factory(decoded.to_data(false), false);
+    BOOST_REQUIRE(instance.output_pattern() == decoded.output_pattern());
+    BOOST_REQUIRE(instance.input_pattern() == decoded.input_pattern());
+    BOOST_REQUIRE(instance.version() == decoded.version());
+    BOOST_REQUIRE_EQUAL(instance.sigops(true), decoded.sigops(true));
+    BOOST_REQUIRE_EQUAL(instance.sigops(false), decoded.sigops(false));
+    BOOST_REQUIRE_EQUAL(instance.is_unspendable(), decoded.is_unspendable());
+}
+
+BOOST_AUTO_TEST_CASE(script__pattern__undecoded_pay_multisig__pay_multisig)
+{
+    const auto instance = undecoded(SCRIPT_16_OF_16_MULTISIG);
+    BOOST_REQUIRE(instance.output_pattern() == machine::script_pattern::pay_multisig);
+    BOOST_REQUIRE(instance.input_pattern() == machine::script_pattern::non_standard);
+    BOOST_REQUIRE_EQUAL(instance.sigops(true), 16u);
+    BOOST_REQUIRE_EQUAL(instance.sigops(false), bc::multisig_default_sigops);
+}
+
+BOOST_AUTO_TEST_CASE(script__pattern__undecoded_pay_null_data__null_data)
+{
+    const auto instance = undecoded(SCRIPT_RETURN_80);
+    BOOST_REQUIRE(instance.output_pattern() == machine::script_pattern::pay_null_data);
+    BOOST_REQUIRE(instance.is_unspendable());
+}
+
+BOOST_AUTO_TEST_CASE(script__pattern__undecoded_truncated_push__non_standard)
+{
+    // push_size_2 with one byte of data, which decodes as one invalid op.
+    const auto instance = script::factory(to_chunk(base16_literal("0201")), false);
+    BOOST_REQUIRE(instance.output_pattern() == machine::script_pattern::non_standard);
+    BOOST_REQUIRE(instance.input_pattern() == machine::script_pattern::non_standard);
+    BOOST_REQUIRE(!instance.is_valid_operations());
+}
+
+BOOST_AUTO_TEST_CASE(script__pattern__undecoded__matches_decoded)
+{
+    const std::vector<std::string> mnemonics
+    {
+        SCRIPT_RETURN,
+        SCRIPT_RETURN_EMPTY,
+        SCRIPT_RETURN_80,
+        SCRIPT_RETURN_81,
+        SCRIPT_0_OF_3_MULTISIG,
+        SCRIPT_1_OF_3_MULTISIG,
+        SCRIPT_2_OF_3_MULTISIG,
+        SCRIPT_3_OF_3_MULTISIG,
+        SCRIPT_4_OF_3_MULTISIG,
+        SCRIPT_16_OF_16_MULTISIG,
+        SCRIPT_17_OF_17_MULTISIG,
+        "dup hash160 [0000000000000000000000000000000000000000] equalverify checksig",
+        "hash160 [0000000000000000000000000000000000000000] equal",
+        "[03dcfd9e580de35d8c2060d76dbf9e5561fe20febd2e64380e860a4d59f15ac864] checksig",
+        "0 [0000000000000000000000000000000000000000000000000000000000000000]",
+        "16 [0000]",
+        "0 [3044022000000000000000000000000000000000000000000000000000000000000000000220000000000000000000000000000000000000000000000000000000000000000001]",
+        "[3044022000000000000000000000000000000000000000000000000000000000000000000220000000000000000000000000000000000000000000000000000000000000000001] [03dcfd9e580de35d8c2060d76dbf9e5561fe20febd2e64380e860a4d59f15ac864]",
+        "[3044022000000000000000000000000000000000000000000000000000000000000000000220000000000000000000000000000000000000000000000000000000000000000001]",
+        "[00] [01] checksigverify 2 checkmultisig"
+    };
+
+    for (const auto& mnemonic: mnemonics)
+    {
+        script decoded;
+        BOOST_REQUIRE(decoded.from_string(mnemonic));
+        require_undecoded_equivalence(decoded);
+    }
+
+    // Truncated scripts, matched after decoding the invalid last operation.
+    for (const auto& encoded: { "0201", "4c", "4d01", "4e010000", "6a4c" })
+    {
+        data_chunk bytes;
+        BOOST_REQUIRE(decode_base16(bytes, encoded));
+        const auto decoded = script::factory(bytes, false);
+        decoded.is_valid_operations();
+        require_undecoded_equivalence(decoded);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(script__is_stripped__no_code_separator__true)
+{
+    BOOST_REQUIRE(undecoded("dup hash160 [0000000000000000000000000000000000000000] equalverify checksig").is_stripped());
+    BOOST_REQUIRE(script(data_chunk{}, false).is_stripped());
+}
+
+BOOST_AUTO_TEST_CASE(script__is_stripped__code_separator__false)
+{
+    BOOST_REQUIRE(!undecoded("1 codeseparator checksig").is_stripped());
+}
+
+BOOST_AUTO_TEST_CASE(script__is_stripped__truncated_push__false)
+{
+    BOOST_REQUIRE(!script(to_chunk(base16_literal("0201")), false).is_stripped());
+}
+
+BOOST_AUTO_TEST_CASE(script__is_stripped__reassigned__recomputed)
+{
+    auto instance = undecoded("[0102] codeseparator 1");
+    BOOST_REQUIRE(!instance.is_stripped());
+    BOOST_REQUIRE(instance.from_string("[0102] 1"));
+    BOOST_REQUIRE(instance.is_stripped());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/system.hpp>
+
+using namespace bc::system;
+using namespace bc::system::chain;
+
+BOOST_AUTO_TEST_SUITE(script_cache_tests)
+
+static const hash_digest hash1{ { 0x01 } };
+static const hash_digest hash2{ { 0x02 } };
+static const hash_digest hash3{ { 0x03 } };
+static const uint32_t forks1 = machine::rule_fork::bip16_rule;
+static const uint32_t forks2 = machine::rule_fork::all_rules;
+
+BOOST_AUTO_TEST_CASE(script_cache__contains__empty__false_miss)
+{
+    script_cache cache(10);
+    BOOST_REQUIRE(!cache.contains(hash1, forks1));
+    BOOST_REQUIRE_EQUAL(cache.hits(), 0u);
+    BOOST_REQUIRE_EQUAL(cache.misses(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(script_cache__contains__stored__true_hit)
+{
+    script_cache cache(10);
+    cache.store(hash1, forks1);
+    BOOST_REQUIRE_EQUAL(cache.size(), 1u);
+    BOOST_REQUIRE(cache.contains(hash1, forks1));
+    BOOST_REQUIRE(!cache.contains(hash2, forks1));
+    BOOST_REQUIRE_EQUAL(cache.hits(), 1u);
+    BOOST_REQUIRE_EQUAL(cache.misses(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(script_cache__contains__other_forks__false)
+{
+    script_cache cache(10);
+    cache.store(hash1, forks1);
+    BOOST_REQUIRE(!cache.contains(hash1, forks2));
+}
+
+BOOST_AUTO_TEST_CASE(script_cache__store__other_forks__retained)
+{
+    script_cache cache(10);
+    cache.store(hash1, forks1);
+    cache.store(hash2, forks1);
+    cache.store(hash3, forks2);
+    BOOST_REQUIRE_EQUAL(cache.size(), 3u);
+    BOOST_REQUIRE(cache.contains(hash1, forks1));
+    BOOST_REQUIRE(!cache.contains(hash1, forks2));
+    BOOST_REQUIRE(cache.contains(hash3, forks2));
+}
+
+BOOST_AUTO_TEST_CASE(script_cache__store__both_forks__distinct_entries)
+{
+    script_cache cache(10);
+    cache.store(hash1, forks1);
+    cache.store(hash1, forks2);
+    BOOST_REQUIRE_EQUAL(cache.size(), 2u);
+    BOOST_REQUIRE(cache.contains(hash1, forks1));
+    BOOST_REQUIRE(cache.contains(hash1, forks2));
+}
+
+BOOST_AUTO_TEST_CASE(script_cache__store__zero_capacity__disabled)
+{
+    script_cache cache(0);
+    cache.store(hash1, forks1);
+    BOOST_REQUIRE_EQUAL(cache.size(), 0u);
+    BOOST_REQUIRE(!cache.contains(hash1, forks1));
+}
+
+BOOST_AUTO_TEST_CASE(script_cache__store__full__oldest_evicted)
+{
+    script_cache cache(2);
+    cache.store(hash1, forks1);
+    cache.store(hash2, forks1);
+    cache.store(hash3, forks1);
+    BOOST_REQUIRE_EQUAL(cache.size(), 2u);
+    BOOST_REQUIRE(!cache.contains(hash1, forks1));
+    BOOST_REQUIRE(cache.contains(hash2, forks1));
+    BOOST_REQUIRE(cache.contains(hash3, forks1));
+}
+
+BOOST_AUTO_TEST_CASE(script_cache__set_capacity__stored__cleared)
+{
+    script_cache cache(2);
+    cache.store(hash1, forks1);
+    cache.set_capacity(1);
+    BOOST_REQUIRE_EQUAL(cache.capacity(), 1u);
+    BOOST_REQUIRE_EQUAL(cache.size(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
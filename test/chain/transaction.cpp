@@ -581,6 +581,32 @@ BOOST_AUTO_TEST_CASE(transaction__factory_data_3__case_2__success)
     BOOST_REQUIRE(resave == raw_tx);
 }
 
+BOOST_AUTO_TEST_CASE(transaction__from_data__byte_reader_witness__matches_istream_reader)
+{
+    static const auto raw_tx = to_chunk(base16_literal(
+        "01000000000101db6b1b20aa0fd7b23880be2ecbd4a98130974cf4748fb66092ac4d3c"
+        "eb1a5477010000001716001479091972186c449eb1ded22b78e40d009bdf0089feffff"
+        "ff02b8b4eb0b000000001976a914a457b684d7f0d539a46a45bbc043f35b59d0d96388"
+        "ac0008af2f000000001976a914fd270b1ee6abcaea97fea7ad0402e8bd8ad6d77c88ac"
+        "02473044022047ac8e878352d3ebbde1c94ce3a10d057c24175747116f8288e5d794d1"
+        "2d482f0220217f36a485cae903c713331d877c1f64677e3622ad4010726870540656fe"
+        "9dcb012103ad1d8e89212f0b92c74d23bb710c00662ad1470198ac48c43f7d6f93a2a2"
+        "687392040000"));
+
+    data_source stream(raw_tx);
+    istream_reader reader(stream);
+    chain::transaction expected;
+    BOOST_REQUIRE(expected.from_data(reader, true, true));
+
+    auto source = make_byte_reader(raw_tx);
+    chain::transaction instance;
+    BOOST_REQUIRE(instance.from_data(source, true, true));
+    BOOST_REQUIRE(source.is_exhausted());
+    BOOST_REQUIRE(instance.is_segregated());
+    BOOST_REQUIRE(instance == expected);
+    BOOST_REQUIRE(instance.to_data(true, true) == raw_tx);
+}
+
 BOOST_AUTO_TEST_CASE(transaction__version__roundtrip__success)
 {
     uint32_t version = 1254u;
@@ -851,6 +877,20 @@ BOOST_AUTO_TEST_CASE(transaction__is_missing_previous_outputs__inputs_with_cache
 ////    BOOST_REQUIRE_EQUAL(instance.missing_previous_outputs().size(), 0u);
 ////}
 
+BOOST_AUTO_TEST_CASE(transaction__missing_previous_transactions__duplicates__sorted_distinct)
+{
+    const hash_digest low{ { 1 } };
+    const hash_digest high{ { 2 } };
+    chain::transaction instance;
+    instance.inputs().emplace_back(chain::output_point{ high, 0 }, chain::script{}, 0);
+    instance.inputs().emplace_back(chain::output_point{ low, 0 }, chain::script{}, 0);
+    instance.inputs().emplace_back(chain::output_point{ high, 1 }, chain::script{}, 0);
+    const auto result = instance.missing_previous_transactions();
+    BOOST_REQUIRE_EQUAL(result.size(), 2u);
+    BOOST_REQUIRE(result.front() == low);
+    BOOST_REQUIRE(result.back() == high);
+}
+
 BOOST_AUTO_TEST_CASE(transaction__is_confirmed_double_spend__empty_inputs__returns_false)
 {
     chain::transaction instance;
@@ -1002,6 +1042,43 @@ BOOST_AUTO_TEST_CASE(transaction__operator_assign_equals_2__always__matches_equi
     BOOST_REQUIRE(instance == expected);
 }
 
+// Signing populates the component hashes and version 0 prefix midstates.
+static hash_digest sign_version_0(const chain::transaction& tx)
+{
+    static const auto script_code = chain::script::factory(
+        to_chunk(base16_literal("76a9141d0f172a0ecb48aee1be1f2687d2963ae33f1a1388ac")),
+        false);
+
+    return chain::script::generate_signature_hash(tx, 0, script_code,
+        machine::sighash_algorithm::all, machine::script_version::zero, 42);
+}
+
+BOOST_AUTO_TEST_CASE(transaction__operator_assign_equals_1__after_signing__signs_as_equivalent)
+{
+    static const auto raw_tx = to_chunk(base16_literal(TX4));
+    chain::transaction expected;
+    BOOST_REQUIRE(expected.from_data(raw_tx));
+    chain::transaction instance;
+    BOOST_REQUIRE(instance.from_data(to_chunk(base16_literal(TX1))));
+    BOOST_REQUIRE(sign_version_0(instance) != sign_version_0(expected));
+    instance = chain::transaction::factory(raw_tx);
+    BOOST_REQUIRE(sign_version_0(instance) == sign_version_0(expected));
+    BOOST_REQUIRE(instance.hash(true) == expected.hash(true));
+}
+
+BOOST_AUTO_TEST_CASE(transaction__operator_assign_equals_2__after_signing__signs_as_equivalent)
+{
+    static const auto raw_tx = to_chunk(base16_literal(TX4));
+    chain::transaction expected;
+    BOOST_REQUIRE(expected.from_data(raw_tx));
+    chain::transaction instance;
+    BOOST_REQUIRE(instance.from_data(to_chunk(base16_literal(TX1))));
+    BOOST_REQUIRE(sign_version_0(instance) != sign_version_0(expected));
+    instance = expected;
+    BOOST_REQUIRE(sign_version_0(instance) == sign_version_0(expected));
+    BOOST_REQUIRE(instance.hash(true) == expected.hash(true));
+}
+
 BOOST_AUTO_TEST_CASE(transaction__operator_boolean_equals__duplicates__returns_true)
 {
     static const auto raw_tx = to_chunk(base16_literal(TX4));
@@ -1051,6 +1128,41 @@ BOOST_AUTO_TEST_CASE(transaction__hash__block320670__success)
     BOOST_REQUIRE(data == instance.to_data());
 }
 
+BOOST_AUTO_TEST_CASE(transaction__hashes__empty__empty)
+{
+    BOOST_REQUIRE(chain::transaction::hashes({}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(transaction__hashes__uncached_and_cached__expected_in_order)
+{
+    chain::transaction::list instances(9);
+    const data_chunk datas[] =
+    {
+        to_chunk(base16_literal(TX1)),
+        to_chunk(base16_literal(TX4)),
+        to_chunk(base16_literal(TX7))
+    };
+
+    for (size_t index = 0; index < instances.size(); ++index)
+        BOOST_REQUIRE(instances[index].from_data(datas[index % 3]));
+
+    // Populate the cache of a subset of the transactions.
+    BOOST_REQUIRE(instances[4].hash() == hash_literal(TX4_HASH));
+
+    const auto hashes = chain::transaction::hashes(instances);
+    BOOST_REQUIRE_EQUAL(hashes.size(), instances.size());
+
+    for (size_t index = 0; index < instances.size(); index += 3)
+    {
+        BOOST_REQUIRE(hashes[index + 0] == hash_literal(TX1_HASH));
+        BOOST_REQUIRE(hashes[index + 1] == hash_literal(TX4_HASH));
+        BOOST_REQUIRE(hashes[index + 2] == hash_literal(TX7_HASH));
+        BOOST_REQUIRE(instances[index + 0].hash() == hash_literal(TX1_HASH));
+        BOOST_REQUIRE(instances[index + 1].hash() == hash_literal(TX4_HASH));
+        BOOST_REQUIRE(instances[index + 2].hash() == hash_literal(TX7_HASH));
+    }
+}
+
 BOOST_AUTO_TEST_CASE(transaction__is_internal_double_spend__empty_prevouts__false)
 {
     chain::transaction instance;
@@ -1082,4 +1194,119 @@ BOOST_AUTO_TEST_CASE(transaction__is_internal_double_spend__nonunique_prevouts__
     BOOST_REQUIRE_EQUAL(instance.is_internal_double_spend(), true);
 }
 
+BOOST_AUTO_TEST_CASE(transaction__is_internal_double_spend__shared_prefix_prevouts__expected)
+{
+    // Prevouts differ only in the last bytes of hash, so a hash of the prefix
+    // would place them all in one slot and probe quadratically.
+    chain::transaction instance;
+    auto hash = hash_literal(TX1_HASH);
+
+    for (uint32_t value = 0; value < 10000; ++value)
+    {
+        const auto suffix = to_little_endian(value);
+        std::copy(suffix.begin(), suffix.end(), hash.end() - suffix.size());
+        instance.inputs().emplace_back(chain::output_point{ hash, 0 }, chain::script{}, 0);
+    }
+
+    BOOST_REQUIRE_EQUAL(instance.is_internal_double_spend(), false);
+    instance.inputs().emplace_back(chain::output_point{ hash, 0 }, chain::script{}, 0);
+    BOOST_REQUIRE_EQUAL(instance.is_internal_double_spend(), true);
+}
+
+// The state retains a reference to its checkpoints.
+static const config::checkpoint::list no_checkpoints;
+
+// The genesis block state, with all rules enabled.
+static chain::chain_state genesis_state(const settings& settings)
+{
+    const chain::block genesis = settings.genesis_block;
+    const auto& header = genesis.header();
+    chain::chain_state::data data;
+    data.height = 0;
+    data.hash = header.hash();
+    data.bits.self = header.bits();
+    data.version.self = header.version();
+    data.timestamp.self = header.timestamp();
+    data.timestamp.retarget = header.timestamp();
+    return { std::move(data), no_checkpoints, machine::rule_fork::all_rules, 0,
+        settings };
+}
+
+// Inputs spend prevouts of true scripts, except the input at stack_false,
+// which spends a false script, and that at missing, which has no prevout.
+static chain::transaction connecting_tx(size_t count, size_t stack_false,
+    size_t missing)
+{
+    const chain::script true_script(machine::operation::list{ { machine::opcode::push_positive_1 } });
+    const chain::script false_script(machine::operation::list{ { machine::opcode::push_size_0 } });
+    const auto hash = hash_literal(TX1_HASH);
+    chain::transaction tx;
+
+    for (uint32_t index = 0; index < count; ++index)
+    {
+        tx.inputs().emplace_back(chain::output_point{ hash, index }, chain::script{}, 0);
+
+        if (index != missing)
+            tx.inputs().back().previous_output().metadata.cache = { 0,
+                index == stack_false ? false_script : true_script };
+    }
+
+    tx.outputs().emplace_back(0, chain::script{});
+    return tx;
+}
+
+BOOST_AUTO_TEST_CASE(transaction__connect_pooled__all_inputs_connect__success)
+{
+    threadpool pool(4);
+    const settings settings(config::settings::mainnet);
+    const auto state = genesis_state(settings);
+    const auto instance = connecting_tx(64, max_size_t, max_size_t);
+    BOOST_REQUIRE_EQUAL(instance.connect(state), error::success);
+    BOOST_REQUIRE_EQUAL(instance.connect(state, pool), error::success);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(transaction__connect_pooled__failing_inputs__lowest_index_same_as_sequential)
+{
+    threadpool pool(4);
+    const settings settings(config::settings::mainnet);
+    const auto state = genesis_state(settings);
+
+    const auto false_first = connecting_tx(64, 5, 40);
+    BOOST_REQUIRE_EQUAL(false_first.connect(state), error::stack_false);
+    BOOST_REQUIRE_EQUAL(false_first.connect(state, pool), error::stack_false);
+
+    const auto missing_first = connecting_tx(64, 40, 5);
+    BOOST_REQUIRE_EQUAL(missing_first.connect(state), error::missing_previous_output);
+    BOOST_REQUIRE_EQUAL(missing_first.connect(state, pool), error::missing_previous_output);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(transaction__connect__cached_missing_previous_output__missing_previous_output)
+{
+    threadpool pool(4);
+    const settings settings(config::settings::mainnet);
+    const auto state = genesis_state(settings);
+    auto& cache = chain::script_verification_cache();
+    cache.set_capacity(10);
+
+    const auto instance = connecting_tx(4, max_size_t, max_size_t);
+    BOOST_REQUIRE_EQUAL(instance.connect(state), error::success);
+    BOOST_REQUIRE_EQUAL(cache.size(), 1u);
+
+    // The same transaction, without a previous output, is not connected.
+    const auto missing = connecting_tx(4, max_size_t, 2);
+    BOOST_REQUIRE(missing.hash(true) == instance.hash(true));
+    BOOST_REQUIRE_EQUAL(missing.connect(state), error::missing_previous_output);
+    BOOST_REQUIRE_EQUAL(missing.connect(state, pool), error::missing_previous_output);
+    BOOST_REQUIRE_GT(cache.hits(), 0u);
+
+    cache.set_capacity(0);
+    pool.shutdown();
+    pool.join();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
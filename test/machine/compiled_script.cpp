@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/system.hpp>
+
+using namespace bc::system;
+using namespace bc::system::chain;
+using namespace bc::system::machine;
+
+BOOST_AUTO_TEST_SUITE(compiled_script_tests)
+
+static script from_mnemonic(const std::string& mnemonic)
+{
+    script out;
+    BOOST_REQUIRE(out.from_string(mnemonic));
+    return out;
+}
+
+static std::string repeat(const std::string& mnemonic, size_t count)
+{
+    std::string out;
+
+    for (size_t index = 0; index < count; ++index)
+        out += " " + mnemonic;
+
+    return out;
+}
+
+static void require_run_equivalence(const std::string& mnemonic)
+{
+    const auto instance = from_mnemonic(mnemonic);
+    const compiled_script compiled(instance);
+    program expected(instance);
+    program actual(instance);
+
+    const auto expected_ec = interpreter::run(expected);
+    const auto actual_ec = interpreter::run(compiled, actual);
+    BOOST_REQUIRE_MESSAGE(expected_ec == actual_ec, mnemonic);
+
+    // A jumped branch is counted as a whole, so the count at failure varies.
+    if (expected_ec)
+        return;
+
+    BOOST_REQUIRE_EQUAL(expected.operation_count(), actual.operation_count());
+    BOOST_REQUIRE_EQUAL(expected.size(), actual.size());
+
+    if (!expected.empty())
+        BOOST_REQUIRE(expected.item(0) == actual.item(0));
+}
+
+BOOST_AUTO_TEST_CASE(compiled_script__construct__empty__empty)
+{
+    const script instance;
+    const compiled_script compiled(instance);
+    BOOST_REQUIRE(compiled.instructions().empty());
+    BOOST_REQUIRE(&compiled.script() == &instance);
+}
+
+BOOST_AUTO_TEST_CASE(compiled_script__construct__if_else_endif__resolved_jumps)
+{
+    const auto instance = from_mnemonic("1 if 2 dup drop else 3 add endif");
+    const compiled_script compiled(instance);
+    const auto& instructions = compiled.instructions();
+    BOOST_REQUIRE_EQUAL(instructions.size(), 9u);
+
+    // if -> else, skipping dup and drop.
+    BOOST_REQUIRE(instructions[1].conditional);
+    BOOST_REQUIRE(instructions[1].jumpable);
+    BOOST_REQUIRE_EQUAL(instructions[1].next, 5u);
+    BOOST_REQUIRE_EQUAL(instructions[1].skipped, 2u);
+
+    // else -> endif, skipping add.
+    BOOST_REQUIRE(instructions[5].jumpable);
+    BOOST_REQUIRE_EQUAL(instructions[5].next, 8u);
+    BOOST_REQUIRE_EQUAL(instructions[5].skipped, 1u);
+    BOOST_REQUIRE(instructions[8].conditional);
+    BOOST_REQUIRE(!instructions[8].jumpable);
+}
+
+BOOST_AUTO_TEST_CASE(compiled_script__construct__nested__skips_nested_conditionals)
+{
+    const auto instance = from_mnemonic("0 if 1 if nop endif endif");
+    const compiled_script compiled(instance);
+    const auto& instructions = compiled.instructions();
+    BOOST_REQUIRE_EQUAL(instructions[1].next, 6u);
+    BOOST_REQUIRE_EQUAL(instructions[1].skipped, 3u);
+    BOOST_REQUIRE_EQUAL(instructions[3].next, 5u);
+    BOOST_REQUIRE_EQUAL(instructions[3].skipped, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(compiled_script__construct__disabled_in_branch__not_jumpable)
+{
+    const auto instance = from_mnemonic("0 if cat endif");
+    const compiled_script compiled(instance);
+    const auto& instructions = compiled.instructions();
+    BOOST_REQUIRE(!instructions[1].jumpable);
+    BOOST_REQUIRE(instructions[2].failure == error::op_disabled);
+}
+
+BOOST_AUTO_TEST_CASE(compiled_script__construct__unclosed__next_is_end)
+{
+    const auto instance = from_mnemonic("0 if nop");
+    const compiled_script compiled(instance);
+    BOOST_REQUIRE_EQUAL(compiled.instructions()[1].next, 3u);
+    BOOST_REQUIRE_EQUAL(compiled.instructions()[1].skipped, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(compiled_script__run__scripts__same_as_interpreter)
+{
+    static const std::vector<std::string> scripts
+    {
+        "",
+        "1",
+        "1 2 add 3 equal",
+        "1 if 2 else 3 endif",
+        "0 if 2 else 3 endif",
+        "0 if 2 else 3 else 4 endif",
+        "1 if 2 else 3 else 4 endif",
+        "0 notif 2 endif",
+        "1 if 0 if 2 else 3 endif else 4 endif",
+        "0 if 0 if 2 else 3 endif else 4 endif",
+        "0 if cat endif",
+        "0 if 1 else cat endif",
+        "0 if",
+        "1 if",
+        "else",
+        "endif",
+        "1 endif endif",
+        "if 1 endif",
+        "1 return",
+        "0 if return endif 1",
+        "[0102] size 2 equal",
+        "1 dup toaltstack fromaltstack equal",
+        "0 if" + repeat("nop", 201) + " endif 1",
+        "0 if" + repeat("nop", 200) + " endif 1",
+        "0 if" + repeat("nop", 100) + " else" + repeat("nop", 101) + " endif",
+        "1 if" + repeat("nop", 100) + " else" + repeat("nop", 101) + " endif",
+        "1" + repeat("dup", 1000),
+        "0 if" + repeat("dup", 1000) + " endif 1"
+    };
+
+    for (const auto& mnemonic: scripts)
+        require_run_equivalence(mnemonic);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
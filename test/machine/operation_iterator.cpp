@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/system.hpp>
+
+using namespace bc::system;
+using namespace bc::system::machine;
+
+BOOST_AUTO_TEST_SUITE(operation_iterator_tests)
+
+BOOST_AUTO_TEST_CASE(operation_iterator__next__empty__false)
+{
+    const data_chunk script;
+    operation_iterator instance(script);
+    BOOST_REQUIRE(!instance.next());
+}
+
+BOOST_AUTO_TEST_CASE(operation_iterator__next__pay_key_hash__expected)
+{
+    const auto script = to_chunk(base16_literal("76a914000102030405060708090a0b0c0d0e0f1011121388ac"));
+    operation_iterator instance(script);
+
+    BOOST_REQUIRE(instance.next());
+    BOOST_REQUIRE(instance.code() == opcode::dup);
+    BOOST_REQUIRE(instance.data().empty());
+    BOOST_REQUIRE(instance.next());
+    BOOST_REQUIRE(instance.code() == opcode::hash160);
+    BOOST_REQUIRE(instance.next());
+    BOOST_REQUIRE(instance.code() == opcode::push_size_20);
+    BOOST_REQUIRE(instance.is_push());
+    BOOST_REQUIRE(instance.is_minimal_push());
+    BOOST_REQUIRE_EQUAL(instance.data().size(), 20u);
+    BOOST_REQUIRE_EQUAL(instance.data().data()[19], 0x13u);
+    BOOST_REQUIRE(instance.next());
+    BOOST_REQUIRE(instance.code() == opcode::equalverify);
+    BOOST_REQUIRE(instance.next());
+    BOOST_REQUIRE(instance.code() == opcode::checksig);
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(!instance.next());
+}
+
+BOOST_AUTO_TEST_CASE(operation_iterator__next__prefixed_pushes__expected)
+{
+    const auto script = to_chunk(base16_literal("4c01aa4d0200bbcc4e01000000dd"));
+    operation_iterator instance(script);
+
+    BOOST_REQUIRE(instance.next());
+    BOOST_REQUIRE(instance.code() == opcode::push_one_size);
+    BOOST_REQUIRE(!instance.is_minimal_push());
+    BOOST_REQUIRE(to_chunk(instance.data()) == data_chunk{ 0xaa });
+    BOOST_REQUIRE(instance.next());
+    BOOST_REQUIRE(instance.code() == opcode::push_two_size);
+    BOOST_REQUIRE((to_chunk(instance.data()) == data_chunk{ 0xbb, 0xcc }));
+    BOOST_REQUIRE(instance.next());
+    BOOST_REQUIRE(instance.code() == opcode::push_four_size);
+    BOOST_REQUIRE(to_chunk(instance.data()) == data_chunk{ 0xdd });
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(!instance.next());
+}
+
+BOOST_AUTO_TEST_CASE(operation_iterator__next__truncated_data__invalid_last)
+{
+    const auto script = to_chunk(base16_literal("510301"));
+    operation_iterator instance(script);
+
+    BOOST_REQUIRE(instance.next());
+    BOOST_REQUIRE(instance.code() == opcode::push_positive_1);
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(instance.next());
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE(instance.code() == opcode::disabled_xor);
+    BOOST_REQUIRE(instance.data().empty());
+    BOOST_REQUIRE(!instance.next());
+}
+
+BOOST_AUTO_TEST_CASE(operation_iterator__next__truncated_prefix__invalid_last)
+{
+    const auto script = to_chunk(base16_literal("4d01"));
+    operation_iterator instance(script);
+
+    BOOST_REQUIRE(instance.next());
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE(instance.code() == opcode::disabled_xor);
+    BOOST_REQUIRE(!instance.next());
+}
+
+BOOST_AUTO_TEST_CASE(operation_iterator__next__script__matches_operations)
+{
+    const auto encoded = to_chunk(base16_literal("0003aabbcc4c02ffffac0201"));
+    const auto instance = chain::script::factory(encoded, false);
+    const auto& ops = instance.operations();
+    operation_iterator it(encoded);
+
+    for (const auto& op: ops)
+    {
+        BOOST_REQUIRE(it.next());
+        BOOST_REQUIRE(it.code() == op.code());
+        BOOST_REQUIRE(to_chunk(it.data()) == op.data());
+        BOOST_REQUIRE_EQUAL(it.is_valid(), op.is_valid());
+    }
+
+    BOOST_REQUIRE(!it.next());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,225 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/system.hpp>
+
+using namespace bc::system;
+using namespace bc::system::chain;
+using namespace bc::system::machine;
+
+BOOST_AUTO_TEST_SUITE(view_interpreter_tests)
+
+static script from_mnemonic(const std::string& mnemonic)
+{
+    script out;
+    BOOST_REQUIRE(out.from_string(mnemonic));
+    return out;
+}
+
+static bool view_run(const script& input_script, const script& output_script)
+{
+    static const transaction tx;
+    view_program input(input_script, tx, 0, rule_fork::all_rules);
+
+    if (input.evaluate())
+        return false;
+
+    view_program output(output_script, input);
+    return !output.evaluate() && output.stack_result(false);
+}
+
+static bool run(const script& input_script, const script& output_script)
+{
+    static const transaction tx;
+    program input(input_script, tx, 0, rule_fork::all_rules);
+
+    if (input.evaluate())
+        return false;
+
+    program output(output_script, input);
+    return !output.evaluate() && output.stack_result(false);
+}
+
+// stack_item
+
+BOOST_AUTO_TEST_CASE(stack_item__construct__default__empty)
+{
+    const stack_item instance;
+    BOOST_REQUIRE(instance.empty());
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(stack_item__construct__view__same_data)
+{
+    const auto data = to_chunk(base16_literal("0102030405"));
+    const stack_item instance(data);
+    BOOST_REQUIRE(instance.data() == data.data());
+    BOOST_REQUIRE(instance.to_chunk() == data);
+}
+
+BOOST_AUTO_TEST_CASE(stack_item__construct__value__copied)
+{
+    const stack_item instance(bitcoin_hash(data_chunk{ 42 }));
+    BOOST_REQUIRE_EQUAL(instance.size(), hash_size);
+    BOOST_REQUIRE(instance.to_chunk() == to_chunk(bitcoin_hash(data_chunk{ 42 })));
+}
+
+BOOST_AUTO_TEST_CASE(stack_item__construct__number__number_data)
+{
+    const number value(-1234567);
+    const stack_item instance(value);
+    BOOST_REQUIRE(instance.to_chunk() == value.data());
+}
+
+BOOST_AUTO_TEST_CASE(stack_item__to_number__number__within_size_limit)
+{
+    number out;
+    const stack_item instance(number(0x80000000ll));
+    BOOST_REQUIRE(!instance.to_number(out, 4));
+    BOOST_REQUIRE(instance.to_number(out, 5));
+    BOOST_REQUIRE_EQUAL(out.int64(), 0x80000000ll);
+}
+
+BOOST_AUTO_TEST_CASE(stack_item__equality__number_and_view__equal)
+{
+    const auto data = number(-255).data();
+    BOOST_REQUIRE(stack_item(number(-255)) == stack_item(data));
+    BOOST_REQUIRE(stack_item(data) == stack_item(number(-255)));
+    BOOST_REQUIRE(stack_item(number(255)) != stack_item(data));
+}
+
+BOOST_AUTO_TEST_CASE(stack_item__is_true__negative_zero__false)
+{
+    const data_chunk negative_zero{ 0x00, 0x00, 0x80 };
+    BOOST_REQUIRE(!stack_item(negative_zero).is_true());
+    BOOST_REQUIRE(!stack_item(number(0)).is_true());
+    BOOST_REQUIRE(stack_item(number(-1)).is_true());
+}
+
+BOOST_AUTO_TEST_CASE(stack_item__end__unencoded_number__end_of_data)
+{
+    const stack_item instance(number(16));
+    BOOST_REQUIRE_EQUAL(std::distance(instance.begin(), instance.end()), 1);
+    BOOST_REQUIRE_EQUAL(*std::prev(stack_item(number(16)).end()), 16u);
+}
+
+BOOST_AUTO_TEST_CASE(stack_item__from_bool__true_false__one_empty)
+{
+    BOOST_REQUIRE(stack_item::from_bool(true).to_chunk() == data_chunk{ 1 });
+    BOOST_REQUIRE(stack_item::from_bool(false).empty());
+}
+
+BOOST_AUTO_TEST_CASE(stack_item__equality__view_and_value__equal)
+{
+    const auto hash = sha256_hash(data_chunk{ 42 });
+    const auto data = to_chunk(hash);
+    BOOST_REQUIRE(stack_item(data) == stack_item(hash));
+    BOOST_REQUIRE(stack_item(data) != stack_item());
+}
+
+// number
+
+BOOST_AUTO_TEST_CASE(number__to_data__values__data_of_data_size)
+{
+    uint8_t buffer[number::max_data_size];
+
+    for (const auto value: { 0ll, 1ll, -1ll, 127ll, 128ll, -128ll, 255ll,
+        -32768ll, 2147483647ll, -2147483647ll, 9223372036854775807ll })
+    {
+        const number instance(value);
+        const auto size = instance.to_data(buffer);
+        BOOST_REQUIRE(data_chunk(buffer, buffer + size) == instance.data());
+        BOOST_REQUIRE_EQUAL(instance.data_size(), size);
+    }
+}
+
+// is_supported
+
+BOOST_AUTO_TEST_CASE(view_interpreter__is_supported__standard__true)
+{
+    BOOST_REQUIRE(view_interpreter::is_supported(from_mnemonic("dup hash160 [0000000000000000000000000000000000000000] equalverify checksig").to_data(false)));
+    BOOST_REQUIRE(view_interpreter::is_supported(from_mnemonic("hash160 [0000000000000000000000000000000000000000] equal").to_data(false)));
+    BOOST_REQUIRE(view_interpreter::is_supported(data_chunk{}));
+}
+
+BOOST_AUTO_TEST_CASE(view_interpreter__is_supported__multisig__false)
+{
+    BOOST_REQUIRE(!view_interpreter::is_supported(from_mnemonic("1 [02ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff] 1 checkmultisig").to_data(false)));
+    BOOST_REQUIRE(!view_interpreter::is_supported(from_mnemonic("0 0 0 checkmultisigverify").to_data(false)));
+}
+
+BOOST_AUTO_TEST_CASE(view_interpreter__is_supported__codeseparator__false)
+{
+    BOOST_REQUIRE(!view_interpreter::is_supported(from_mnemonic("codeseparator 1").to_data(false)));
+}
+
+// run
+
+BOOST_AUTO_TEST_CASE(view_interpreter__run__scripts__same_as_interpreter)
+{
+    static const std::vector<std::pair<std::string, std::string>> scripts
+    {
+        { "1", "" },
+        { "0", "" },
+        { "1 2", "add 3 equal" },
+        { "[0102]", "size 2 equalverify 1" },
+        { "[68656c6c6f]", "sha256 [2cf24dba5fb0a30e26e83b2ac5b9e29e1b161e5c1fa7425e73043362938b9824] equal" },
+        { "[68656c6c6f]", "hash160 [b6a9c8c230722b7c748331a8b450f05566dc7d0f] equal" },
+        { "[68656c6c6f]", "hash256 dup equal" },
+        { "1", "if 2 else 0 endif" },
+        { "0", "if 2 else 0 endif" },
+        { "1 0", "notif 1 endif" },
+        { "1", "if" },
+        { "5", "dup toaltstack fromaltstack 5 numequal" },
+        { "1 2 3", "rot 1 numequalverify 2drop 1" },
+        { "[ffffffff7f]", "1add" },
+        { "2147483647", "1add 2147483648 equal" },
+        { "-1", "abs 1 numequal" },
+        { "1", "return" },
+        { "1 2 3 4", "2swap 2over 4 pick 3 roll depth 7 numequal" },
+        { "[0000000000000000000000000000000000000000000000000000000000000000000000000000000000]", "0 equal" }
+    };
+
+    for (const auto& pair: scripts)
+    {
+        const auto input = from_mnemonic(pair.first);
+        const auto output = from_mnemonic(pair.second);
+        BOOST_REQUIRE_MESSAGE(view_run(input, output) == run(input, output),
+            pair.first + " : " + pair.second);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(view_interpreter__run__small_number_signature__same_as_interpreter)
+{
+    static const std::vector<std::string> signatures
+    {
+        "1", "16", "-1"
+    };
+
+    const auto output = from_mnemonic("[02ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff] checksig not");
+
+    for (const auto& signature: signatures)
+    {
+        const auto input = from_mnemonic(signature);
+        BOOST_REQUIRE_MESSAGE(view_run(input, output) == run(input, output),
+            signature);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
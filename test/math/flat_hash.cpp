@@ -0,0 +1,270 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <bitcoin/system.hpp>
+
+using namespace bc::system;
+
+BOOST_AUTO_TEST_SUITE(flat_hash_tests)
+
+static const hash_digest hash1{ { 0x01 } };
+static const hash_digest hash2{ { 0x02 } };
+
+static hash_digest counted_hash(uint32_t value)
+{
+    return sha256_hash(to_chunk(to_little_endian(value)));
+}
+
+// digest_hasher
+
+BOOST_AUTO_TEST_CASE(flat_hash__digest_hasher__same_salt__same_hash)
+{
+    const digest_hasher<hash_digest> first(42);
+    const digest_hasher<hash_digest> second(42);
+    BOOST_REQUIRE_EQUAL(first(hash1), second(hash1));
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash__digest_hasher__distinct_salts__distinct_hashes)
+{
+    const digest_hasher<hash_digest> first(42);
+    const digest_hasher<hash_digest> second(24);
+    BOOST_REQUIRE_NE(first(hash1), second(hash1));
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash__digest_hasher__short_hash__distinct_hashes)
+{
+    const digest_hasher<short_hash> hasher(42);
+    BOOST_REQUIRE_NE(hasher(short_hash{ { 0x01 } }), hasher(short_hash{ { 0x02 } }));
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash__digest_hasher__point_distinct_indexes__distinct_hashes)
+{
+    const digest_hasher<chain::point> hasher(42);
+    BOOST_REQUIRE_NE(hasher({ hash1, 0 }), hasher({ hash1, 1 }));
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash__digest_hasher__point_distinct_hash_suffixes__distinct_hashes)
+{
+    const digest_hasher<chain::point> hasher(42);
+    auto suffix = hash1;
+    suffix.back() = 0x01;
+    BOOST_REQUIRE_NE(hasher({ hash1, 0 }), hasher({ suffix, 0 }));
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash__flat_set__shared_prefix_points__distinct_slots)
+{
+    // Points chosen by a spender may share all but the last bytes of hash.
+    static const size_t count = 4096;
+    const digest_hasher<chain::point> hasher(42);
+    std::set<size_t> slots;
+    auto hash = hash1;
+
+    for (uint32_t value = 0; value < count; ++value)
+    {
+        const auto suffix = to_little_endian(value);
+        std::copy(suffix.begin(), suffix.end(), hash.end() - suffix.size());
+        slots.insert(hasher({ hash, 0 }) & (2u * count - 1u));
+    }
+
+    // A hash of only the prefix places every point in the same slot.
+    BOOST_REQUIRE_GT(slots.size(), count / 2u);
+}
+
+// flat_set
+
+BOOST_AUTO_TEST_CASE(flat_hash__flat_set__default__empty)
+{
+    const hash_digest_set set;
+    BOOST_REQUIRE(set.empty());
+    BOOST_REQUIRE_EQUAL(set.size(), 0u);
+    BOOST_REQUIRE(!set.contains(hash1));
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash__flat_set__reserved__capacity)
+{
+    const hash_digest_set set(100);
+    BOOST_REQUIRE_GE(set.capacity(), 100u);
+    BOOST_REQUIRE(set.empty());
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash__flat_set__insert__contains)
+{
+    hash_digest_set set;
+    BOOST_REQUIRE(set.insert(hash1));
+    BOOST_REQUIRE(!set.insert(hash1));
+    BOOST_REQUIRE_EQUAL(set.size(), 1u);
+    BOOST_REQUIRE(set.contains(hash1));
+    BOOST_REQUIRE(!set.contains(hash2));
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash__flat_set__insert_beyond_capacity__grows)
+{
+    hash_digest_set set(2);
+
+    for (uint32_t value = 0; value < 1000; ++value)
+        BOOST_REQUIRE(set.insert(counted_hash(value)));
+
+    BOOST_REQUIRE_EQUAL(set.size(), 1000u);
+    BOOST_REQUIRE_GE(set.capacity(), 1000u);
+
+    for (uint32_t value = 0; value < 1000; ++value)
+        BOOST_REQUIRE(set.contains(counted_hash(value)));
+
+    BOOST_REQUIRE(!set.contains(counted_hash(1000)));
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash__flat_set__clear__empty_same_capacity)
+{
+    hash_digest_set set(10);
+    set.insert(hash1);
+    const auto capacity = set.capacity();
+    set.clear();
+    BOOST_REQUIRE(set.empty());
+    BOOST_REQUIRE(!set.contains(hash1));
+    BOOST_REQUIRE_EQUAL(set.capacity(), capacity);
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash__flat_set__erase__removed)
+{
+    hash_digest_set set;
+    set.insert(hash1);
+    BOOST_REQUIRE(!set.erase(hash2));
+    BOOST_REQUIRE(set.erase(hash1));
+    BOOST_REQUIRE(!set.erase(hash1));
+    BOOST_REQUIRE(set.empty());
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash__flat_set__colliding_erase__same_as_std_set)
+{
+    // A small table with a constant salt forces long probe sequences.
+    flat_set<chain::point> set(0, digest_hasher<chain::point>(0));
+    std::set<chain::point> expected;
+    uint32_t seed = 7;
+    const auto next = [&seed]()
+    {
+        seed = seed * 1103515245u + 12345u;
+        return (seed >> 16) % 64u;
+    };
+
+    for (size_t round = 0; round < 5000; ++round)
+    {
+        const chain::point point{ counted_hash(next() % 8u), next() };
+
+        if (next() % 3u == 0)
+            BOOST_REQUIRE_EQUAL(set.erase(point), expected.erase(point) != 0);
+        else
+            BOOST_REQUIRE_EQUAL(set.insert(point), expected.insert(point).second);
+
+        BOOST_REQUIRE_EQUAL(set.size(), expected.size());
+    }
+
+    for (uint32_t hash = 0; hash < 8u; ++hash)
+        for (uint32_t index = 0; index < 64u; ++index)
+            BOOST_REQUIRE_EQUAL(set.contains({ counted_hash(hash), index }),
+                expected.count({ counted_hash(hash), index }) != 0);
+}
+
+// flat_map
+
+BOOST_AUTO_TEST_CASE(flat_hash__flat_map__find_missing__nullptr)
+{
+    flat_map<hash_digest, size_t> map;
+    BOOST_REQUIRE(map.find(hash1) == nullptr);
+    map.emplace(hash2, 42);
+    BOOST_REQUIRE(map.find(hash1) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash__flat_map__emplace__first_value_retained)
+{
+    flat_map<hash_digest, size_t> map;
+    const auto first = map.emplace(hash1, 42);
+    const auto second = map.emplace(hash1, 24);
+    BOOST_REQUIRE(first.second);
+    BOOST_REQUIRE(!second.second);
+    BOOST_REQUIRE_EQUAL(*second.first, 42u);
+    BOOST_REQUIRE_EQUAL(*map.find(hash1), 42u);
+    BOOST_REQUIRE_EQUAL(map.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash__flat_map__subscript__assigned)
+{
+    flat_map<hash_digest, size_t> map;
+    BOOST_REQUIRE_EQUAL(map[hash1], 0u);
+    map[hash1] = 42;
+    BOOST_REQUIRE_EQUAL(*map.find(hash1), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash__flat_map__erase_grown__values_retained)
+{
+    flat_map<hash_digest, uint32_t> map;
+
+    for (uint32_t value = 0; value < 100; ++value)
+        map[counted_hash(value)] = value;
+
+    for (uint32_t value = 0; value < 100; value += 2)
+        BOOST_REQUIRE(map.erase(counted_hash(value)));
+
+    BOOST_REQUIRE_EQUAL(map.size(), 50u);
+
+    for (uint32_t value = 0; value < 100; ++value)
+    {
+        const auto found = map.find(counted_hash(value));
+
+        if (value % 2 == 0)
+            BOOST_REQUIRE(found == nullptr);
+        else
+            BOOST_REQUIRE_EQUAL(*found, value);
+    }
+}
+
+// distinct_unsorted
+
+BOOST_AUTO_TEST_CASE(flat_hash__distinct_unsorted__duplicates__first_of_each_in_order)
+{
+    hash_list list{ hash2, hash1, hash2, hash2, hash1 };
+    const auto& result = distinct_unsorted(list);
+    BOOST_REQUIRE(&result == &list);
+    BOOST_REQUIRE_EQUAL(list.size(), 2u);
+    BOOST_REQUIRE(list[0] == hash2);
+    BOOST_REQUIRE(list[1] == hash1);
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash__distinct_unsorted__shared_prefix__first_of_each_in_order)
+{
+    hash_list list;
+
+    for (size_t index = 0; index < 2000; ++index)
+    {
+        auto hash = null_hash;
+        hash.back() = static_cast<uint8_t>(index % 1000);
+        hash[hash_size - 2] = static_cast<uint8_t>((index % 1000) >> 8);
+        list.push_back(hash);
+    }
+
+    distinct_unsorted(list);
+    BOOST_REQUIRE_EQUAL(list.size(), 1000u);
+    BOOST_REQUIRE(list.front() == null_hash);
+    BOOST_REQUIRE_EQUAL(list.back().back(), static_cast<uint8_t>(999 % 256));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
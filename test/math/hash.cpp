@@ -58,6 +58,173 @@ BOOST_AUTO_TEST_CASE(sha256_hash_test)
     BOOST_REQUIRE_EQUAL(encode_base16(hash), "3a6eb0790f39ac87c94f3856b2dd2c5d110e6811602261a9a923d3bb23adc8b7");
 }
 
+BOOST_AUTO_TEST_CASE(sha256_hash_vectors_test)
+{
+    for (const auto& result: sha256_tests)
+    {
+        data_chunk data;
+        BOOST_REQUIRE(decode_base16(data, result.input));
+        BOOST_REQUIRE_EQUAL(encode_base16(sha256_hash(data)), result.result);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sha256_hash_backends_test)
+{
+    const auto selected = sha256_selected();
+    const data_chunk million(1000000, 'a');
+    const auto blocks = base16_literal(
+        "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+        "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+        "404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+        "606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+        "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f");
+
+    for (const auto backend:
+    {
+        sha256_backend::scalar,
+        sha256_backend::sse41,
+        sha256_backend::avx2,
+        sha256_backend::avx512,
+        sha256_backend::shani
+    })
+    {
+        if (!sha256_available(backend))
+        {
+            BOOST_REQUIRE(!sha256_select(backend));
+            continue;
+        }
+
+        BOOST_REQUIRE(sha256_select(backend));
+        BOOST_REQUIRE(sha256_selected() == backend);
+
+        for (const auto& result: sha256_tests)
+        {
+            data_chunk data;
+            BOOST_REQUIRE(decode_base16(data, result.input));
+            BOOST_REQUIRE_EQUAL(encode_base16(sha256_hash(data)), result.result);
+        }
+
+        BOOST_REQUIRE_EQUAL(encode_base16(sha256_hash(million)), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+        BOOST_REQUIRE_EQUAL(encode_base16(sha256_hash(blocks)), "448ebbc9e1a31220a2f3830c18eef61b9bd070e5084b7fa2a359fe729184c719");
+        BOOST_REQUIRE_EQUAL(encode_base16(bitcoin_hash(blocks)), "41c59d33e3147d38f1ce1092ee9608ca45a623c181a763a3d28c4ce3905fb3ab");
+    }
+
+    BOOST_REQUIRE(sha256_select(selected));
+}
+
+BOOST_AUTO_TEST_CASE(bitcoin_hash_batch_test)
+{
+    const auto selected = sha256_selected();
+    data_chunk blocks(37 * long_hash_size);
+
+    for (size_t index = 0; index < blocks.size(); ++index)
+        blocks[index] = static_cast<uint8_t>(index * 7 + 3);
+
+    for (const auto backend:
+    {
+        sha256_backend::scalar,
+        sha256_backend::sse41,
+        sha256_backend::avx2,
+        sha256_backend::avx512,
+        sha256_backend::shani
+    })
+    {
+        if (!sha256_select(backend))
+            continue;
+
+        // Every count exercises each lane width and remainder combination.
+        for (size_t count = 0; count <= 37; ++count)
+        {
+            const auto end = blocks.data() + count * long_hash_size;
+            const auto doubles = bitcoin_hash_batch({ blocks.data(), end });
+            const auto singles = sha256_hash_batch({ blocks.data(),
+                blocks.data() + count * hash_size });
+
+            BOOST_REQUIRE_EQUAL(doubles.size(), count);
+            BOOST_REQUIRE_EQUAL(singles.size(), count);
+
+            for (size_t index = 0; index < count; ++index)
+            {
+                const auto block = blocks.data() + index * long_hash_size;
+                const auto digest = blocks.data() + index * hash_size;
+                BOOST_REQUIRE(doubles[index] == bitcoin_hash({ block, block + long_hash_size }));
+                BOOST_REQUIRE(singles[index] == sha256_hash({ digest, digest + hash_size }));
+            }
+        }
+    }
+
+    BOOST_REQUIRE(sha256_select(selected));
+}
+
+BOOST_AUTO_TEST_CASE(bitcoin_hash_batch_partial_block_test)
+{
+    const data_chunk data(long_hash_size + 1, 0x42);
+    const auto hashes = bitcoin_hash_batch(data);
+    BOOST_REQUIRE_EQUAL(hashes.size(), 1u);
+    BOOST_REQUIRE(hashes.front() == bitcoin_hash({ data.data(), data.data() + long_hash_size }));
+}
+
+BOOST_AUTO_TEST_CASE(double_sha256_fixed_test)
+{
+    const auto selected = sha256_selected();
+    long_hash pair;
+    byte_array<80> header;
+
+    for (size_t index = 0; index < pair.size(); ++index)
+        pair[index] = static_cast<uint8_t>(index * 5 + 1);
+
+    for (size_t index = 0; index < header.size(); ++index)
+        header[index] = static_cast<uint8_t>(index * 11 + 2);
+
+    for (const auto backend:
+    {
+        sha256_backend::scalar,
+        sha256_backend::sse41,
+        sha256_backend::avx2,
+        sha256_backend::avx512,
+        sha256_backend::shani
+    })
+    {
+        if (!sha256_select(backend))
+            continue;
+
+        BOOST_REQUIRE(double_sha256_64(pair) == bitcoin_hash(pair));
+        BOOST_REQUIRE(double_sha256_64(null_long_hash) == bitcoin_hash(null_long_hash));
+        BOOST_REQUIRE(double_sha256_80(header) == bitcoin_hash(header));
+    }
+
+    BOOST_REQUIRE(sha256_select(selected));
+}
+
+BOOST_AUTO_TEST_CASE(sha256_context_test)
+{
+    data_chunk data(300);
+
+    for (size_t index = 0; index < data.size(); ++index)
+        data[index] = static_cast<uint8_t>(index * 13 + 5);
+
+    // Each split exercises buffered, block aligned and padding boundaries.
+    for (const auto split: { 0, 1, 31, 55, 56, 63, 64, 65, 128, 200 })
+    {
+        for (const auto size: { 0, 32, 55, 56, 64, 119, 120, 300 })
+        {
+            const auto first = std::min<size_t>(split, size);
+            sha256_context context;
+            context.write({ data.data(), data.data() + first });
+            const auto midstate = context;
+            context.write({ data.data() + first, data.data() + size });
+
+            const data_slice slice(data.data(), data.data() + size);
+            BOOST_REQUIRE_EQUAL(context.size(), size);
+            BOOST_REQUIRE(context.single_hash() == sha256_hash(slice));
+            BOOST_REQUIRE(context.double_hash() == bitcoin_hash(slice));
+
+            // A copied midstate is unaffected by subsequent writes.
+            BOOST_REQUIRE(midstate.single_hash() == sha256_hash({ data.data(), data.data() + first }));
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(sha512_hash_test)
 {
     const data_chunk chunk{ 'd', 'a', 't', 'a' };
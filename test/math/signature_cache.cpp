@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/system.hpp>
+
+using namespace bc::system;
+
+BOOST_AUTO_TEST_SUITE(signature_cache_tests)
+
+static const data_chunk point1{ 0x02, 0x01, 0x02, 0x03 };
+static const data_chunk point2{ 0x03, 0x01, 0x02, 0x03 };
+static const hash_digest hash1{ { 0x01 } };
+static const hash_digest hash2{ { 0x02 } };
+static const ec_signature signature1{ { 0x0a } };
+static const ec_signature signature2{ { 0x0b } };
+
+BOOST_AUTO_TEST_CASE(signature_cache__contains__empty__false_miss)
+{
+    signature_cache cache(10);
+    BOOST_REQUIRE(!cache.contains(point1, hash1, signature1));
+    BOOST_REQUIRE_EQUAL(cache.hits(), 0u);
+    BOOST_REQUIRE_EQUAL(cache.misses(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__contains__stored__true_hit)
+{
+    signature_cache cache(10);
+    cache.store(point1, hash1, signature1);
+    BOOST_REQUIRE_EQUAL(cache.size(), 1u);
+    BOOST_REQUIRE(cache.contains(point1, hash1, signature1));
+    BOOST_REQUIRE_EQUAL(cache.hits(), 1u);
+    BOOST_REQUIRE_EQUAL(cache.misses(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__contains__distinct_elements__false)
+{
+    signature_cache cache(10);
+    cache.store(point1, hash1, signature1);
+    BOOST_REQUIRE(!cache.contains(point2, hash1, signature1));
+    BOOST_REQUIRE(!cache.contains(point1, hash2, signature1));
+    BOOST_REQUIRE(!cache.contains(point1, hash1, signature2));
+    BOOST_REQUIRE_EQUAL(cache.misses(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__store__zero_capacity__disabled)
+{
+    signature_cache cache(0);
+    cache.store(point1, hash1, signature1);
+    BOOST_REQUIRE_EQUAL(cache.size(), 0u);
+    BOOST_REQUIRE(!cache.contains(point1, hash1, signature1));
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__store__duplicate__stored_once)
+{
+    signature_cache cache(10);
+    cache.store(point1, hash1, signature1);
+    cache.store(point1, hash1, signature1);
+    BOOST_REQUIRE_EQUAL(cache.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__store__full__oldest_evicted)
+{
+    signature_cache cache(2);
+    cache.store(point1, hash1, signature1);
+    cache.store(point1, hash1, signature2);
+    cache.store(point1, hash2, signature1);
+    BOOST_REQUIRE_EQUAL(cache.size(), 2u);
+    BOOST_REQUIRE(!cache.contains(point1, hash1, signature1));
+    BOOST_REQUIRE(cache.contains(point1, hash1, signature2));
+    BOOST_REQUIRE(cache.contains(point1, hash2, signature1));
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__set_capacity__stored__cleared)
+{
+    signature_cache cache(2);
+    cache.store(point1, hash1, signature1);
+    cache.set_capacity(1);
+    BOOST_REQUIRE_EQUAL(cache.capacity(), 1u);
+    BOOST_REQUIRE_EQUAL(cache.size(), 0u);
+    cache.store(point1, hash1, signature1);
+    cache.store(point2, hash1, signature1);
+    BOOST_REQUIRE_EQUAL(cache.size(), 1u);
+    BOOST_REQUIRE(cache.contains(point2, hash1, signature1));
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__distinct_instances__distinct_salts)
+{
+    signature_cache cache1(10);
+    signature_cache cache2(10);
+    cache1.store(point1, hash1, signature1);
+    BOOST_REQUIRE(!cache2.contains(point1, hash1, signature1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -20,6 +20,7 @@
 
 #include <sstream>
 #include <string>
+#include <vector>
 #include <bitcoin/system.hpp>
 
 using namespace bc::system;
@@ -774,4 +775,145 @@ BOOST_AUTO_TEST_CASE(uint256__assign_divide__max_hash_by_256__shifts_right_8_bit
     BOOST_REQUIRE_EQUAL(quotient, uint256_t("0x00ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"));
 }
 
+// fixed width
+//-----------------------------------------------------------------------------
+
+// The boost value as a little-endian hash.
+static hash_digest to_hash(const uint256_t& value)
+{
+    hash_digest out;
+
+    for (size_t byte = 0; byte < hash_size; ++byte)
+        out[byte] = static_cast<uint8_t>(value >> (8 * byte));
+
+    return out;
+}
+
+static const std::vector<hash_digest> fixed_operands
+{
+    null_hash,
+    to_hash(unit_hash),
+    to_hash(max_hash),
+    to_hash(negative_zero_hash),
+    to_hash(most_hash),
+    to_hash(odd_hash),
+    to_hash(half_hash),
+    to_hash(quarter_hash),
+    to_hash(ones_hash),
+    to_hash(fives_hash),
+    to_hash(0xff),
+    to_hash(0x127500),
+    to_hash(uint256_t("0x00000000ffff0000000000000000000000000000000000000000000000000000"))
+};
+
+// The fixed width value as the boost value.
+static uint256_t to_boost(const uint256& value)
+{
+    return to_uint256(value.to_hash());
+}
+
+BOOST_AUTO_TEST_CASE(uint256__fixed_constexpr__shift_add_compare__expected)
+{
+    static BC_CONSTEXPR uint256 high = uint256(1) << 255;
+    static BC_CONSTEXPR uint256 sum = high + uint256(42);
+    static BC_CONSTEXPR auto less = high < sum;
+    BOOST_REQUIRE(less);
+    BOOST_REQUIRE_EQUAL(sum - high, 42u);
+    BOOST_REQUIRE_EQUAL(high.bit_length(), 256u);
+    BOOST_REQUIRE_EQUAL(sum.word(3), 0x8000000000000000);
+    BOOST_REQUIRE_EQUAL(sum.word(0), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(uint256__fixed_hash__round_trip__unchanged)
+{
+    for (const auto& hash: fixed_operands)
+    {
+        BOOST_REQUIRE_EQUAL(encode_base16(uint256(hash).to_hash()), encode_base16(hash));
+        BOOST_REQUIRE(to_boost(uint256(hash)) == to_uint256(hash));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(uint256__fixed_bit_length__operands__boost_msb)
+{
+    BOOST_REQUIRE_EQUAL(uint256().bit_length(), 0u);
+
+    for (const auto& hash: fixed_operands)
+        if (hash != null_hash)
+            BOOST_REQUIRE_EQUAL(uint256(hash).bit_length(), boost::multiprecision::msb(to_uint256(hash)) + 1u);
+}
+
+BOOST_AUTO_TEST_CASE(uint256__fixed_operators__operands__same_as_boost)
+{
+    for (const auto& left_hash: fixed_operands)
+    {
+        const uint256 left(left_hash);
+        const auto boost_left = to_uint256(left_hash);
+        BOOST_REQUIRE(to_boost(~left) == uint256_t(~boost_left));
+
+        for (size_t shift = 0; shift <= 256; shift += 7)
+        {
+            BOOST_REQUIRE(to_boost(left << shift) == uint256_t(boost_left << shift));
+            BOOST_REQUIRE(to_boost(left >> shift) == uint256_t(boost_left >> shift));
+        }
+
+        for (const auto& right_hash: fixed_operands)
+        {
+            const uint256 right(right_hash);
+            const auto boost_right = to_uint256(right_hash);
+            BOOST_REQUIRE_EQUAL(left == right, boost_left == boost_right);
+            BOOST_REQUIRE_EQUAL(left != right, boost_left != boost_right);
+            BOOST_REQUIRE_EQUAL(left < right, boost_left < boost_right);
+            BOOST_REQUIRE_EQUAL(left <= right, boost_left <= boost_right);
+            BOOST_REQUIRE_EQUAL(left > right, boost_left > boost_right);
+            BOOST_REQUIRE_EQUAL(left >= right, boost_left >= boost_right);
+            BOOST_REQUIRE(to_boost(left + right) == uint256_t(boost_left + boost_right));
+            BOOST_REQUIRE(to_boost(left - right) == uint256_t(boost_left - boost_right));
+            BOOST_REQUIRE(to_boost(left * right) == uint256_t(boost_left * boost_right));
+
+            if (right != 0)
+            {
+                BOOST_REQUIRE(to_boost(left / right) == uint256_t(boost_left / boost_right));
+                BOOST_REQUIRE(to_boost(left % right) == uint256_t(boost_left % boost_right));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(uint256__fixed_divide__zero__throws_overflow_error)
+{
+    BOOST_REQUIRE_THROW(uint256(1) / uint256(0), std::overflow_error);
+}
+
+BOOST_AUTO_TEST_CASE(uint256__fixed_divide__max_by_3__fives_hash)
+{
+    BOOST_REQUIRE(uint256(~uint256()) / 3 == uint256(to_hash(fives_hash)));
+}
+
+BOOST_AUTO_TEST_CASE(uint256__fixed_increment__max__0)
+{
+    auto value = ~uint256();
+    BOOST_REQUIRE_EQUAL(++value, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(uint256__fixed_uint256_t__operands__same_as_boost)
+{
+    for (const auto& hash: fixed_operands)
+    {
+        const uint256_t big = uint256(hash);
+        BOOST_REQUIRE(big == to_uint256(hash));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(uint256__fixed_stream__operands__same_as_boost)
+{
+    for (const auto& hash: fixed_operands)
+    {
+        std::ostringstream fixed;
+        std::ostringstream boosted;
+        fixed << uint256(hash);
+        boosted << to_uint256(hash);
+        BOOST_REQUIRE_EQUAL(fixed.str(), boosted.str());
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
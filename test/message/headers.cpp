@@ -742,4 +742,144 @@ BOOST_AUTO_TEST_CASE(headers__is_sequential__disordered__false)
     BOOST_REQUIRE(!instance.is_sequential());
 }
 
+// Mainnet blocks 1 and 2, which follow the genesis block.
+static const auto block1_header = base16_literal(
+    "010000006fe28c0ab6f1b372c1a6a246ae63f74f931e8365e15a089c68d61900000000"
+    "00982051fd1e4ba744bbbe680e1fee14677ba1a3c3540bf7b1cdb606e857233e0e61bc"
+    "6649ffff001d01e36299");
+static const auto block2_header = base16_literal(
+    "010000004860eb18bf1b1620e37e9490fc8a427514416fd75159ab86688e9a83000000"
+    "00d5fdcc541e25de1c7a5addedf24858b8bb665c9f36ef744ee42c316022c90f9bb0bc"
+    "6649ffff001d08d2bd61");
+
+static header::list mainnet_headers()
+{
+    const settings mainnet(config::settings::mainnet);
+    const chain::block& genesis = mainnet.genesis_block;
+    return
+    {
+        header(genesis.header()),
+        header(chain::header::factory(to_chunk(block1_header))),
+        header(chain::header::factory(to_chunk(block2_header)))
+    };
+}
+
+BOOST_AUTO_TEST_CASE(headers__check__empty__success)
+{
+    threadpool pool(2);
+    const headers instance;
+    BOOST_REQUIRE_EQUAL(instance.check(pool, 7200, 0x1d00ffff), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(headers__check__mainnet__success)
+{
+    threadpool pool(2);
+    const headers instance(mainnet_headers());
+    BOOST_REQUIRE_EQUAL(instance.check(pool, 7200, 0x1d00ffff), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(headers__check__disordered__invalid_previous_block)
+{
+    threadpool pool(2);
+    auto elements = mainnet_headers();
+    std::swap(elements[1], elements[2]);
+    const headers instance(elements);
+    BOOST_REQUIRE_EQUAL(instance.check(pool, 7200, 0x1d00ffff), error::invalid_previous_block);
+}
+
+BOOST_AUTO_TEST_CASE(headers__check__insufficient_work__invalid_proof_of_work)
+{
+    threadpool pool(2);
+    auto elements = mainnet_headers();
+
+    // The limit precludes the work of all headers.
+    const headers instance(elements);
+    BOOST_REQUIRE_EQUAL(instance.check(pool, 7200, 0x1c00ffff), error::invalid_proof_of_work);
+}
+
+BOOST_AUTO_TEST_CASE(headers__check__first_error__lowest_header)
+{
+    threadpool pool(2);
+    auto elements = mainnet_headers();
+
+    // The third header is futuristic, after the broken link to the second.
+    elements[1].set_nonce(0);
+    elements[2].set_timestamp(bc::max_uint32);
+    const headers instance(elements);
+    BOOST_REQUIRE_EQUAL(instance.check(pool, 7200, 0x1d00ffff), error::invalid_proof_of_work);
+}
+
+BOOST_AUTO_TEST_CASE(headers__accept_timestamps__empty__success)
+{
+    std::vector<uint32_t> medians{ 42 };
+    const headers instance;
+    BOOST_REQUIRE_EQUAL(instance.accept_timestamps({}, medians), error::success);
+    BOOST_REQUIRE(medians.empty());
+}
+
+BOOST_AUTO_TEST_CASE(headers__accept_timestamps__mainnet__medians)
+{
+    std::vector<uint32_t> medians;
+    const auto elements = mainnet_headers();
+    const headers instance(elements);
+    BOOST_REQUIRE_EQUAL(instance.accept_timestamps({}, medians), error::success);
+    BOOST_REQUIRE_EQUAL(medians.size(), 3u);
+    BOOST_REQUIRE_EQUAL(medians[0], 0u);
+    BOOST_REQUIRE_EQUAL(medians[1], elements[0].timestamp());
+    BOOST_REQUIRE_EQUAL(medians[2], elements[1].timestamp());
+}
+
+BOOST_AUTO_TEST_CASE(headers__accept_timestamps__window__same_as_chain_state)
+{
+    const settings settings(config::settings::mainnet);
+    const auto forks = machine::rule_fork::retarget | machine::rule_fork::difficult;
+    const chain::chain_state::checkpoints checkpoints;
+    header::list elements;
+    hash_digest previous = null_hash;
+
+    // Timestamps rise and fall so that the median lags the latest.
+    for (uint32_t index = 0; index < 30; ++index)
+    {
+        const auto timestamp = 1000u + index * 10u + (index % 3u) * 7u;
+        elements.emplace_back(1u, previous, null_hash, timestamp, 0x1d00ffffu, 0u);
+        previous = elements.back().hash();
+    }
+
+    chain::chain_state::data values;
+    values.height = 0;
+    values.hash = elements[0].hash();
+    values.bits.self = elements[0].bits();
+    values.version.self = elements[0].version();
+    values.timestamp.self = elements[0].timestamp();
+    values.timestamp.retarget = elements[0].timestamp();
+    auto state = std::make_shared<chain::chain_state>(std::move(values),
+        checkpoints, forks, 0, settings);
+
+    // The window of the genesis state seeds the headers that follow it.
+    const auto window = state->child_median_window();
+    const headers instance(header::list{ elements.begin() + 1, elements.end() });
+    std::vector<uint32_t> medians;
+    BOOST_REQUIRE_EQUAL(instance.accept_timestamps(window, medians), error::success);
+    BOOST_REQUIRE_EQUAL(medians.size(), elements.size() - 1u);
+
+    for (size_t index = 1; index < elements.size(); ++index)
+    {
+        state = std::make_shared<chain::chain_state>(*state, elements[index],
+            settings);
+        BOOST_REQUIRE_EQUAL(medians[index - 1], state->median_time_past());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(headers__accept_timestamps__early__timestamp_too_early)
+{
+    std::vector<uint32_t> medians;
+    auto elements = mainnet_headers();
+
+    // The third header is not later than the median of the first two.
+    elements[2].set_timestamp(elements[1].timestamp());
+    const headers instance(elements);
+    BOOST_REQUIRE_EQUAL(instance.accept_timestamps({}, medians), error::timestamp_too_early);
+    BOOST_REQUIRE_EQUAL(medians.size(), 2u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -48,4 +48,56 @@ BOOST_AUTO_TEST_CASE(messages__variable_uint_size__eight_byte__expected)
     BOOST_REQUIRE_EQUAL(variable_uint_size(value), 9u);
 }
 
+// The previous serialization, with the heading built after the payload.
+template <typename Message>
+static data_chunk expected_serialization(uint32_t version,
+    const Message& packet, uint32_t magic)
+{
+    const auto payload = packet.to_data(version);
+    const heading head(magic, Message::command,
+        static_cast<uint32_t>(payload.size()), bitcoin_checksum(payload));
+    return build_chunk({ head.to_data(), payload });
+}
+
+// A transaction of more than one hash stride of the buffer writer.
+static transaction large_transaction()
+{
+    chain::output::list outputs
+    {
+        { 42, chain::script(data_chunk(10000, 0x42), false) }
+    };
+
+    return { chain::transaction(1, 0, {}, std::move(outputs)) };
+}
+
+BOOST_AUTO_TEST_CASE(messages__serialize__ping__expected)
+{
+    const ping instance(42);
+    const auto version = version::level::maximum;
+    const auto magic = 0xd9b4bef9;
+    BOOST_REQUIRE_EQUAL(serialize(version, instance, magic), expected_serialization(version, instance, magic));
+}
+
+BOOST_AUTO_TEST_CASE(messages__serialize__large_transaction__expected)
+{
+    const auto instance = large_transaction();
+    const auto version = version::level::maximum;
+    const auto magic = 0xd9b4bef9;
+    const auto message = serialize(version, instance, magic);
+    BOOST_REQUIRE_GT(message.size(), 10000u);
+    BOOST_REQUIRE_EQUAL(message, expected_serialization(version, instance, magic));
+}
+
+BOOST_AUTO_TEST_CASE(messages__serialize__reused_buffer__expected_retains_capacity)
+{
+    const ping instance(42);
+    const auto version = version::level::maximum;
+    const auto magic = 0xd9b4bef9;
+    data_chunk buffer(1000, 0xff);
+    const auto capacity = buffer.capacity();
+    serialize(buffer, version, instance, magic);
+    BOOST_REQUIRE_EQUAL(buffer, expected_serialization(version, instance, magic));
+    BOOST_REQUIRE_EQUAL(buffer.capacity(), capacity);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
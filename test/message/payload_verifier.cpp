@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <bitcoin/system.hpp>
+
+using namespace bc::system;
+using namespace bc::system::message;
+
+BOOST_AUTO_TEST_SUITE(payload_verifier_tests)
+
+static const auto payload = to_chunk(base16_literal("0102030405060708090a"));
+static const auto checksum = bitcoin_checksum(payload);
+
+BOOST_AUTO_TEST_CASE(payload_verifier__is_valid__whole_payload__true)
+{
+    payload_verifier instance({ 0, "ping", 10, checksum }, 10);
+    BOOST_REQUIRE(instance.is_valid_size());
+    BOOST_REQUIRE(instance.write(payload));
+    BOOST_REQUIRE_EQUAL(instance.remaining(), 0u);
+    BOOST_REQUIRE(instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(payload_verifier__is_valid__chunked_payload__true)
+{
+    payload_verifier instance({ 0, "ping", 10, checksum }, 10);
+    BOOST_REQUIRE(instance.write(payload.data(), 3));
+    BOOST_REQUIRE_EQUAL(instance.remaining(), 7u);
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE(instance.write(payload.data() + 3, 7));
+    BOOST_REQUIRE(instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(payload_verifier__is_valid__empty_payload__true)
+{
+    payload_verifier instance({ 0, "verack", 0, bitcoin_checksum(data_chunk{}) }, 0);
+    BOOST_REQUIRE(instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(payload_verifier__is_valid__bad_checksum__false)
+{
+    payload_verifier instance({ 0, "ping", 10, checksum + 1 }, 10);
+    BOOST_REQUIRE(instance.write(payload));
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(payload_verifier__write__overrun__false_invalid)
+{
+    payload_verifier instance({ 0, "ping", 9, checksum }, 10);
+    BOOST_REQUIRE(!instance.write(payload));
+    BOOST_REQUIRE(!instance.write(payload.data(), 9));
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(payload_verifier__is_valid_size__above_maximum__false)
+{
+    payload_verifier instance({ 0, "ping", 10, checksum }, 9);
+    BOOST_REQUIRE(!instance.is_valid_size());
+    BOOST_REQUIRE(!instance.write(payload));
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(payload_verifier__is_valid__serialized_message__true)
+{
+    const auto message = serialize(version::level::maximum, ping(42), 0xd9b4bef9);
+    const auto head = heading::factory(message);
+    const auto maximum = heading::maximum_payload_size(version::level::maximum, true);
+    payload_verifier instance(head, maximum);
+    const data_chunk body(message.begin() + heading::satoshi_fixed_size(), message.end());
+    BOOST_REQUIRE(instance.write(body));
+    BOOST_REQUIRE(instance.is_valid());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
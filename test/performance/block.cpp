@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ratio>
+#include <string>
+#include <bitcoin/system.hpp>
+#include "performance.hpp"
+
+using namespace bc::system;
+using namespace bc::system::chain;
+
+// Disabled by default, run with:
+// --run_test=block_performance_tests --log_level=message [-- <block files>]
+// Each block file holds one raw (wire, witness) mainnet block, such as a
+// recent full block exported with bitcoin-cli getblock <hash> 0 and decoded
+// from base16, so that the fused check is also measured on real traffic.
+BOOST_AUTO_TEST_SUITE(block_performance_tests, * boost::unit_test::disabled())
+
+static const size_t checks = 1000;
+
+// Mainnet block 100,000.
+static const auto block100000 = base16_literal(
+    "010000007f110631052deeee06f0754a3629ad7663e56359fd5f3aa7b3e30a0000000"
+    "0005f55996827d9712147a8eb6d7bae44175fe0bcfa967e424a25bfe9f4dc118244d6"
+    "7fb74c9d8e2f1bea5ee82a03010000000100000000000000000000000000000000000"
+    "00000000000000000000000000000ffffffff07049d8e2f1b0114ffffffff0100f205"
+    "2a0100000043410437b36a7221bc977dce712728a954e3b5d88643ed5aef46660ddcf"
+    "eeec132724cd950c1fdd008ad4a2dfd354d6af0ff155fc17c1ee9ef802062feb07ef1"
+    "d065f0ac000000000100000001260fd102fab456d6b169f6af4595965c03c2296ecf2"
+    "5bfd8790e7aa29b404eff010000008c493046022100c56ad717e07229eb93ecef2a32"
+    "a42ad041832ffe66bd2e1485dc6758073e40af022100e4ba0559a4cebbc7ccb5d14d1"
+    "312634664bac46f36ddd35761edaae20cefb16f01410417e418ba79380f462a60d8dd"
+    "12dcef8ebfd7ab1741c5c907525a69a8743465f063c1d9182eea27746aeb9f1f52583"
+    "040b1bc341b31ca0388139f2f323fd59f8effffffff0200ffb2081d0000001976a914"
+    "fc7b44566256621affb1541cc9d59f08336d276b88ac80f0fa02000000001976a9146"
+    "17f0609c9fabb545105f7898f36b84ec583350d88ac00000000010000000122cd6da2"
+    "6eef232381b1a670aa08f4513e9f91a9fd129d912081a3dd138cb013010000008c493"
+    "0460221009339c11b83f234b6c03ebbc4729c2633cbc8cbd0d15774594bfedc45c4f9"
+    "9e2f022100ae0135094a7d651801539df110a028d65459d24bc752d7512bc8a9f78b4"
+    "ab368014104a2e06c38dc72c4414564f190478e3b0d01260f09b8520b196c2f6ec3d0"
+    "6239861e49507f09b7568189efe8d327c3384a4e488f8c534484835f8020b3669e5ae"
+    "bffffffff0200ac23fc060000001976a914b9a2c9700ff9519516b21af338d28d53dd"
+    "f5349388ac00743ba40b0000001976a914eb675c349c474bec8dea2d79d12cff6f330"
+    "ab48788ac00000000");
+
+// A block of the size and shape of recent mainnet blocks (about 2500
+// transactions of two inputs each, spending earlier and external outputs).
+static block large_block()
+{
+    transaction::list txs{ { 1, 0, { { { null_hash, point::null_index },
+        {}, 0 } }, {} } };
+
+    for (uint32_t tx = 1; tx < 2500; ++tx)
+    {
+        const auto external = bitcoin_hash(to_chunk(to_little_endian(tx)));
+        const auto& internal = txs[tx / 2];
+        txs.push_back({ 1, 0, { { { external, 0 }, {}, 0 },
+            { { internal.hash(), tx }, {}, 0 } }, {} });
+    }
+
+    block instance;
+    instance.set_transactions(txs);
+    return instance;
+}
+
+static void report(const std::string& name, const block& instance)
+{
+    // Cache transaction hashes, as they are by deserialization.
+    instance.to_hashes();
+
+    const auto sequential = [&](size_t)
+    {
+        return instance.is_forward_reference() ||
+            instance.is_internal_double_spend();
+    };
+
+    const auto fused = [&](size_t)
+    {
+        return instance.check_internal_spends() != error::success;
+    };
+
+    // The blocks are valid, so no check fails.
+    BOOST_REQUIRE(!sequential(0));
+    BOOST_REQUIRE(!fused(0));
+
+    BOOST_TEST_MESSAGE(name << " sequential: " <<
+        duration_per<std::micro>(checks, sequential) << " us");
+    BOOST_TEST_MESSAGE(name << " fused: " <<
+        duration_per<std::micro>(checks, fused) << " us");
+}
+
+BOOST_AUTO_TEST_CASE(performance__block__check_internal_spends__versus_sequential)
+{
+    block mainnet;
+    BOOST_REQUIRE(mainnet.from_data(to_chunk(block100000)));
+    report("block 100000", mainnet);
+    report("large block", large_block());
+}
+
+BOOST_AUTO_TEST_CASE(performance__block__check_internal_spends__mainnet_files)
+{
+    const auto& suite = boost::unit_test::framework::master_test_suite();
+
+    if (suite.argc < 2)
+        BOOST_TEST_MESSAGE("no mainnet block files given");
+
+    for (auto index = 1; index < suite.argc; ++index)
+    {
+        const std::string path(suite.argv[index]);
+        std::ifstream file(path, std::ios::binary);
+        BOOST_REQUIRE_MESSAGE(file.good(), "cannot open " << path);
+
+        block mainnet;
+        BOOST_REQUIRE(mainnet.from_data(file, true));
+        BOOST_TEST_MESSAGE(path << ": " << mainnet.transactions().size() <<
+            " transactions, " << mainnet.total_inputs() << " inputs");
+        report(path, mainnet);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <ratio>
+#include <bitcoin/system.hpp>
+#include "performance.hpp"
+
+using namespace bc::system;
+using namespace bc::system::chain;
+
+// Disabled by default, run with:
+// --run_test=cached_hash_performance_tests --log_level=message
+BOOST_AUTO_TEST_SUITE(cached_hash_performance_tests, * boost::unit_test::disabled())
+
+static const size_t lookups = 10000000;
+
+// The hash cache scheme replaced by cached_hash, retained for comparison.
+class locked_hash
+{
+public:
+    hash_digest get() const
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        mutex_.lock_upgrade();
+
+        if (!hash_)
+        {
+            //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+            mutex_.unlock_upgrade_and_lock();
+            hash_ = std::make_shared<hash_digest>(null_hash);
+            mutex_.unlock_and_lock_upgrade();
+            //-----------------------------------------------------------------
+        }
+
+        const auto hash = *hash_;
+        mutex_.unlock_upgrade();
+        ///////////////////////////////////////////////////////////////////////
+
+        return hash;
+    }
+
+private:
+    mutable std::shared_ptr<hash_digest> hash_;
+    mutable upgrade_mutex mutex_;
+};
+
+template <typename Lookup>
+static double nanoseconds_per(Lookup lookup)
+{
+    return duration_per<std::nano>(lookups, [&](size_t index)
+    {
+        return lookup()[index % hash_size] != 0;
+    });
+}
+
+BOOST_AUTO_TEST_CASE(performance__cached_hash__lookup__versus_locked)
+{
+    const locked_hash locked;
+    const cached_hash atomic;
+    atomic.set(null_hash);
+
+    const header block_header;
+    const transaction tx;
+    block_header.hash();
+    tx.hash();
+
+    const auto compute = []() { return null_hash; };
+
+    BOOST_TEST_MESSAGE("locked hash lookup: " <<
+        nanoseconds_per([&]() { return locked.get(); }) << " ns");
+    BOOST_TEST_MESSAGE("cached hash lookup: " <<
+        nanoseconds_per([&]() { return atomic.get(compute); }) << " ns");
+    BOOST_TEST_MESSAGE("header hash lookup: " <<
+        nanoseconds_per([&]() { return block_header.hash(); }) << " ns");
+    BOOST_TEST_MESSAGE("transaction hash lookup: " <<
+        nanoseconds_per([&]() { return tx.hash(); }) << " ns");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <ratio>
+#include <string>
+#include <bitcoin/system.hpp>
+#include "performance.hpp"
+
+using namespace bc::system;
+using namespace bc::system::chain;
+using namespace bc::system::machine;
+
+// Disabled by default, run with:
+// --run_test=interpreter_performance_tests --log_level=message
+BOOST_AUTO_TEST_SUITE(interpreter_performance_tests, * boost::unit_test::disabled())
+
+static const size_t runs = 100000;
+
+static std::string repeat(const std::string& mnemonic, size_t count)
+{
+    std::string out;
+
+    for (size_t index = 0; index < count; ++index)
+        out += " " + mnemonic;
+
+    return out;
+}
+
+static void report_interpreter(const std::string& name,
+    const std::string& mnemonic)
+{
+    script instance;
+    BOOST_REQUIRE(instance.from_string(mnemonic));
+    const compiled_script compiled(instance);
+
+    const auto classic = [&](size_t)
+    {
+        program state(instance);
+        return !interpreter::run(state);
+    };
+
+    const auto threaded = [&](size_t)
+    {
+        program state(instance);
+        return !interpreter::run(compiled, state);
+    };
+
+    const auto decoded = [&](size_t)
+    {
+        program state(instance);
+        const compiled_script once(instance);
+        return !interpreter::run(once, state);
+    };
+
+    BOOST_TEST_MESSAGE(name <<
+        " classic: " << duration_per<std::micro>(runs, classic) <<
+        " us, threaded: " << duration_per<std::micro>(runs, threaded) <<
+        " us, threaded with decode: " << duration_per<std::micro>(runs, decoded)
+        << " us");
+}
+
+BOOST_AUTO_TEST_CASE(performance__interpreter__run__versus_compiled)
+{
+    report_interpreter("key hash",
+        "[02ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff] "
+        "dup hash160 [13f8d2e1bba4e5d1b2b0e0e3d4ec2b44e8d2ec6e] equal drop 1");
+    report_interpreter("arithmetic",
+        "1 2 add 3 numequalverify 7 3 sub 4 numequalverify 5 1add 6 equal");
+    report_interpreter("nested branches",
+        "1 if 0 if 2 else 3 endif else 4 endif 3 equal");
+    report_interpreter("false branch of pushes",
+        "0 if" + repeat("[00000000000000000000000000000000]", 500) +
+        " endif 1");
+    report_interpreter("false branch of operations",
+        "0 if" + repeat("nop", 200) + " endif 1");
+    report_interpreter("stack churn",
+        "1" + repeat("dup drop", 100));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,46 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SYSTEM_TEST_PERFORMANCE_HPP
+#define LIBBITCOIN_SYSTEM_TEST_PERFORMANCE_HPP
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+
+// The mean duration of count calls of run(index), in units of Period (e.g.
+// std::micro). The true results are summed and the sum is consumed, so that
+// the calls are not optimized away.
+template <typename Period, typename Run>
+double duration_per(size_t count, Run run)
+{
+    size_t sum = 0;
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t index = 0; index < count; ++index)
+        sum += run(index) ? 1 : 0;
+
+    const auto stop = std::chrono::steady_clock::now();
+    const std::chrono::duration<double, Period> elapsed = stop - start;
+
+    BOOST_REQUIRE(sum <= count);
+    return elapsed.count() / count;
+}
+
+#endif
@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <ratio>
+#include <string>
+#include <utility>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include "performance.hpp"
+
+using namespace bc::system;
+
+// Disabled by default, run with:
+// --run_test=sha256_performance_tests --log_level=message
+BOOST_AUTO_TEST_SUITE(sha256_performance_tests, * boost::unit_test::disabled())
+
+static const size_t messages = 1024;
+static const size_t rounds = 1000;
+
+// The sse41 and avx2 transforms of a single message vectorize only its
+// message schedule, as its rounds (and its blocks) are sequential. Only
+// batches of independent messages are hashed in parallel lanes (4 sse41, 8
+// avx2, 16 avx512), so the single message results of these backends are
+// expected to be close to scalar, and the batch results several times faster.
+static const std::vector<std::pair<sha256_backend, std::string>> backends
+{
+    { sha256_backend::scalar, "scalar" },
+    { sha256_backend::sse41, "sse41" },
+    { sha256_backend::avx2, "avx2" },
+    { sha256_backend::avx512, "avx512" },
+    { sha256_backend::shani, "shani" }
+};
+
+BOOST_AUTO_TEST_CASE(performance__sha256__single_message__versus_batch)
+{
+    const auto initial = sha256_selected();
+    const data_chunk blocks(messages * 2 * hash_size, 0x42);
+
+    for (const auto& backend: backends)
+    {
+        if (!sha256_select(backend.first))
+        {
+            BOOST_TEST_MESSAGE(backend.second << ": not available");
+            continue;
+        }
+
+        // Double sha256 of each 64 byte message in turn.
+        const auto single = duration_per<std::nano>(rounds, [&](size_t)
+        {
+            auto sum = 0;
+
+            for (size_t message = 0; message < messages; ++message)
+            {
+                const auto begin = blocks.data() + message * 2 * hash_size;
+                sum += bitcoin_hash({ begin, begin + 2 * hash_size })[0];
+            }
+
+            return sum != 0;
+        }) / messages;
+
+        // Double sha256 of all 64 byte messages in lanes.
+        const auto batch = duration_per<std::nano>(rounds, [&](size_t)
+        {
+            return bitcoin_hash_batch(blocks).front()[0] != 0;
+        }) / messages;
+
+        BOOST_TEST_MESSAGE(backend.second << " single: " << single <<
+            " ns, batch: " << batch << " ns (per message)");
+    }
+
+    BOOST_REQUIRE(sha256_select(initial));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <ratio>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include "performance.hpp"
+
+using namespace bc::system;
+using namespace bc::system::chain;
+
+// Disabled by default, run with:
+// --run_test=uint256_performance_tests --log_level=message
+BOOST_AUTO_TEST_SUITE(uint256_performance_tests, * boost::unit_test::disabled())
+
+static const size_t iterations = 1000000;
+
+// Mainnet bits at the genesis block and at later difficulties.
+static const std::vector<uint32_t> work_bits
+{
+    0x1d00ffff, 0x1b0404cb, 0x1a05db8b, 0x170e1632
+};
+
+template <typename Number, typename Operation>
+static double nanoseconds_per(const std::vector<Number>& values,
+    Operation operation)
+{
+    return duration_per<std::nano>(iterations, [&](size_t index)
+    {
+        return operation(values[index % values.size()]);
+    });
+}
+
+BOOST_AUTO_TEST_CASE(performance__uint256__work_math__versus_boost)
+{
+    std::vector<uint256> fixed;
+    std::vector<uint256_t> boosted;
+
+    for (const auto bits: work_bits)
+    {
+        fixed.push_back(compact(bits));
+        boosted.push_back(to_uint256(fixed.back().to_hash()));
+    }
+
+    const auto hash = hash_literal(
+        "000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+    const uint256 fixed_hash(hash);
+    const auto boosted_hash = to_uint256(hash);
+
+    BOOST_TEST_MESSAGE("boost construct: " << nanoseconds_per(boosted,
+        [&](const uint256_t&) { return to_uint256(hash) != 0; }) << " ns");
+    BOOST_TEST_MESSAGE("fixed construct: " << nanoseconds_per(fixed,
+        [&](const uint256&) { return uint256(hash) != 0; }) << " ns");
+
+    BOOST_TEST_MESSAGE("boost compare: " << nanoseconds_per(boosted,
+        [&](const uint256_t& target) { return boosted_hash <= target; }) <<
+        " ns");
+    BOOST_TEST_MESSAGE("fixed compare: " << nanoseconds_per(fixed,
+        [&](const uint256& target) { return fixed_hash <= target; }) <<
+        " ns");
+
+    BOOST_TEST_MESSAGE("boost proof: " << nanoseconds_per(boosted,
+        [](const uint256_t& target)
+        {
+            return (uint256_t(~target) / (target + 1)) + 1 != 0;
+        }) << " ns");
+    BOOST_TEST_MESSAGE("fixed proof: " << nanoseconds_per(fixed,
+        [](const uint256& target)
+        {
+            return (~target / (target + 1)) + 1 != 0;
+        }) << " ns");
+
+    BOOST_TEST_MESSAGE("boost retarget: " << nanoseconds_per(boosted,
+        [](const uint256_t& target)
+        {
+            return uint256_t(target * 1209599u / 1209600u) != 0;
+        }) << " ns");
+    BOOST_TEST_MESSAGE("fixed retarget: " << nanoseconds_per(fixed,
+        [](const uint256& target)
+        {
+            return target * 1209599u / 1209600u != 0;
+        }) << " ns");
+
+    BOOST_TEST_MESSAGE("compact normal: " << nanoseconds_per(fixed,
+        [](const uint256& target) { return compact(target).normal() != 0; })
+        << " ns");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include <bitcoin/system.hpp>
+
+using namespace bc::system;
+
+BOOST_AUTO_TEST_SUITE(cached_hash_tests)
+
+static const hash_digest hash1{ { 0x01 } };
+static const hash_digest hash2{ { 0x02 } };
+
+BOOST_AUTO_TEST_CASE(cached_hash__get__default__false)
+{
+    hash_digest out;
+    const cached_hash instance;
+    BOOST_REQUIRE(!instance.get(out));
+}
+
+BOOST_AUTO_TEST_CASE(cached_hash__get__set__expected)
+{
+    hash_digest out;
+    const cached_hash instance;
+    instance.set(hash1);
+    BOOST_REQUIRE(instance.get(out));
+    BOOST_REQUIRE(out == hash1);
+}
+
+BOOST_AUTO_TEST_CASE(cached_hash__set__published__unchanged)
+{
+    hash_digest out;
+    const cached_hash instance;
+    instance.set(hash1);
+    instance.set(hash2);
+    BOOST_REQUIRE(instance.get(out));
+    BOOST_REQUIRE(out == hash1);
+}
+
+BOOST_AUTO_TEST_CASE(cached_hash__reset__published__cleared)
+{
+    hash_digest out;
+    cached_hash instance;
+    instance.set(hash1);
+    instance.reset();
+    BOOST_REQUIRE(!instance.get(out));
+    instance.set(hash2);
+    BOOST_REQUIRE(instance.get(out));
+    BOOST_REQUIRE(out == hash2);
+}
+
+BOOST_AUTO_TEST_CASE(cached_hash__get_compute__twice__computed_once)
+{
+    size_t calls = 0;
+    const cached_hash instance;
+    const auto compute = [&]()
+    {
+        ++calls;
+        return hash1;
+    };
+
+    BOOST_REQUIRE(instance.get(compute) == hash1);
+    BOOST_REQUIRE(instance.get(compute) == hash1);
+    BOOST_REQUIRE_EQUAL(calls, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(cached_hash__copy__published__copied)
+{
+    hash_digest out;
+    cached_hash instance;
+    instance.set(hash1);
+    const cached_hash copy(instance);
+    BOOST_REQUIRE(copy.get(out));
+    BOOST_REQUIRE(out == hash1);
+
+    cached_hash assigned;
+    assigned.set(hash2);
+    assigned = cached_hash();
+    BOOST_REQUIRE(!assigned.get(out));
+}
+
+BOOST_AUTO_TEST_CASE(cached_hash__get_compute__concurrent__consistent)
+{
+    static const size_t threads = 4;
+    const cached_hash instance;
+    std::atomic<size_t> mismatches(0);
+    std::vector<std::thread> workers;
+
+    for (size_t thread = 0; thread < threads; ++thread)
+    {
+        workers.emplace_back([&]()
+        {
+            for (size_t iteration = 0; iteration < 1000; ++iteration)
+                if (instance.get([]() { return hash1; }) != hash1)
+                    ++mismatches;
+        });
+    }
+
+    for (auto& worker: workers)
+        worker.join();
+
+    BOOST_REQUIRE_EQUAL(mismatches.load(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
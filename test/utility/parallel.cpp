@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include <bitcoin/system.hpp>
+
+using namespace bc::system;
+
+BOOST_AUTO_TEST_SUITE(parallel_tests)
+
+BOOST_AUTO_TEST_CASE(parallel_first_error__zero_count__success)
+{
+    threadpool pool(2);
+    std::atomic<size_t> calls(0);
+    const auto job = [&](size_t)
+    {
+        ++calls;
+        return code(error::operation_failed);
+    };
+
+    BOOST_REQUIRE_EQUAL(parallel_first_error(pool, 0, job).value(), error::success);
+    BOOST_REQUIRE_EQUAL(calls.load(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_first_error__empty_pool__all_invoked_on_caller)
+{
+    threadpool pool;
+    std::atomic<size_t> calls(0);
+    const auto job = [&](size_t)
+    {
+        ++calls;
+        return code(error::success);
+    };
+
+    BOOST_REQUIRE_EQUAL(parallel_first_error(pool, 42, job).value(), error::success);
+    BOOST_REQUIRE_EQUAL(calls.load(), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_first_error__all_succeed__success_code)
+{
+    threadpool pool(2);
+    const auto job = [](size_t)
+    {
+        return code(error::success);
+    };
+
+    BOOST_REQUIRE_EQUAL(parallel_first_error(pool, 42, job), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_first_error__no_failure__all_invoked_once)
+{
+    threadpool pool(4);
+    std::vector<std::atomic<size_t>> calls(1000);
+
+    for (auto& count: calls)
+        count = 0;
+
+    const auto job = [&](size_t index)
+    {
+        ++calls[index];
+        return code(error::success);
+    };
+
+    BOOST_REQUIRE_EQUAL(parallel_first_error(pool, calls.size(), job).value(), error::success);
+
+    for (const auto& count: calls)
+        BOOST_REQUIRE_EQUAL(count.load(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_first_error__multiple_failures__lowest_index_error)
+{
+    threadpool pool(4);
+    const auto job = [](size_t index)
+    {
+        if (index == 700)
+            return code(error::stack_false);
+
+        if (index == 300)
+            return code(error::invalid_script);
+
+        if (index == 301)
+            return code(error::operation_failed);
+
+        return code(error::success);
+    };
+
+    // Repeat to vary the thread interleaving.
+    for (size_t iteration = 0; iteration < 20; ++iteration)
+        BOOST_REQUIRE_EQUAL(parallel_first_error(pool, 1000, job).value(), error::invalid_script);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -534,4 +534,23 @@ BOOST_AUTO_TEST_CASE(read_bytes_to_eof)
     BOOST_REQUIRE_EQUAL(false, !source);
 }
 
+BOOST_AUTO_TEST_CASE(byte_reader__read_bytes__sufficient__expected)
+{
+    static const data_chunk data{ 0x01, 0x02, 0x03, 0x04 };
+    auto source = make_byte_reader(data);
+    BOOST_REQUIRE_EQUAL(source.read_byte(), 0x01u);
+    BOOST_REQUIRE(source.read_bytes(2) == data_chunk({ 0x02, 0x03 }));
+    BOOST_REQUIRE(source.read_bytes() == data_chunk({ 0x04 }));
+    BOOST_REQUIRE(source.is_exhausted());
+    BOOST_REQUIRE(source);
+}
+
+BOOST_AUTO_TEST_CASE(byte_reader__read_bytes__insufficient__zero_filled_invalid)
+{
+    static const data_chunk data{ 0x01, 0x02 };
+    auto source = make_byte_reader(data);
+    BOOST_REQUIRE(source.read_bytes(3) == data_chunk(3, 0x00));
+    BOOST_REQUIRE(!source);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
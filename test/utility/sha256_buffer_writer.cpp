@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <bitcoin/system.hpp>
+
+using namespace bc::system;
+
+BOOST_AUTO_TEST_SUITE(sha256_buffer_writer_tests)
+
+BOOST_AUTO_TEST_CASE(sha256_buffer_writer__write__integers__serialized_and_hashed)
+{
+    data_chunk buffer(13);
+    sha256_context context;
+    sha256_buffer_writer sink(buffer.data(), buffer.size(), context);
+    sink.write_4_bytes_little_endian(0x04030201);
+    sink.write_8_bytes_big_endian(0x05060708090a0b0c);
+    sink.write_byte(0x0d);
+    sink.flush();
+    BOOST_REQUIRE(sink);
+    BOOST_REQUIRE_EQUAL(sink.size(), 13u);
+    BOOST_REQUIRE_EQUAL(encode_base16(buffer), "0102030405060708090a0b0c0d");
+    BOOST_REQUIRE(context.single_hash() == sha256_hash(buffer));
+}
+
+BOOST_AUTO_TEST_CASE(sha256_buffer_writer__write_bytes__above_hash_stride__hashed)
+{
+    const data_chunk data(10000, 0x2a);
+    data_chunk buffer(2 * data.size());
+    sha256_context context;
+    sha256_buffer_writer sink(buffer.data(), buffer.size(), context);
+
+    for (auto byte: data)
+        sink.write_byte(byte);
+
+    sink.write_bytes(data);
+    sink.flush();
+    BOOST_REQUIRE(sink);
+    BOOST_REQUIRE_EQUAL(context.size(), buffer.size());
+    BOOST_REQUIRE(context.single_hash() == sha256_hash(buffer));
+}
+
+BOOST_AUTO_TEST_CASE(sha256_buffer_writer__skip__always__zeroed)
+{
+    data_chunk buffer(3, 0xff);
+    sha256_context context;
+    sha256_buffer_writer sink(buffer.data(), buffer.size(), context);
+    sink.write_byte(0x01);
+    sink.skip(2);
+    BOOST_REQUIRE(sink);
+    BOOST_REQUIRE_EQUAL(encode_base16(buffer), "010000");
+}
+
+BOOST_AUTO_TEST_CASE(sha256_buffer_writer__write__overflow__invalid)
+{
+    data_chunk buffer(3, 0xff);
+    sha256_context context;
+    sha256_buffer_writer sink(buffer.data(), buffer.size(), context);
+    sink.write_4_bytes_little_endian(0);
+    BOOST_REQUIRE(!sink);
+    sink.write_byte(0x00);
+    BOOST_REQUIRE(!sink);
+    BOOST_REQUIRE_EQUAL(sink.size(), 0u);
+    BOOST_REQUIRE_EQUAL(encode_base16(buffer), "ffffff");
+}
+
+BOOST_AUTO_TEST_SUITE_END()